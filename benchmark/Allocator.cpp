@@ -0,0 +1,70 @@
+#include "Benchmark.hpp"
+#include "Strawberry/Core/Util/Allocator.hpp"
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+
+
+static constexpr size_t       OPERATION_COUNT = 1'000'000;
+static constexpr size_t       LIVE_COUNT      = 4'096;
+static constexpr size_t       MAXIMUM_SIZE    = 1'024;
+static constexpr unsigned int REPETITIONS     = 3;
+
+
+/// Keeps LIVE_COUNT random sized allocations alive, replacing a random one at each step, so that the free space
+/// becomes fragmented as it would in a long running heap.
+template <typename AllocateF, typename FreeF>
+void Benchmark_Churn(AllocateF&& allocate, FreeF&& free)
+{
+	std::minstd_rand random(1);
+
+	using Allocation = decltype(allocate(size_t(1)));
+	std::vector<Allocation> live;
+	live.reserve(LIVE_COUNT);
+	for (size_t i = 0; i < LIVE_COUNT; i++)
+	{
+		live.emplace_back(allocate(1 + random() % MAXIMUM_SIZE));
+	}
+
+	for (size_t i = 0; i < OPERATION_COUNT; i++)
+	{
+		auto& slot = live[random() % LIVE_COUNT];
+		free(std::move(slot));
+		slot = allocate(1 + random() % MAXIMUM_SIZE);
+	}
+
+	for (auto& allocation : live) free(std::move(allocation));
+}
+
+
+int main()
+{
+	// Twice as much space as the live set needs on average, which leaves the buddy allocator room for its rounding.
+	const size_t capacity = 2 * LIVE_COUNT * MAXIMUM_SIZE;
+
+	Benchmark::Report("malloc/free", OPERATION_COUNT, Benchmark::BestOf(REPETITIONS, [&]
+	{
+		Benchmark_Churn(
+			[] (size_t size) { return std::malloc(size); },
+			[] (void* pointer) { std::free(pointer); });
+	}));
+
+	FreelistAllocator<RangeAllocatorConfig> freelist(size_t{capacity});
+	Benchmark::Report("FreelistAllocator", OPERATION_COUNT, Benchmark::BestOf(REPETITIONS, [&]
+	{
+		Benchmark_Churn(
+			[&] (size_t size) { return freelist.Allocate(AllocationRequest{size}); },
+			[&] (Optional<AllocatorSegment>&& segment) { if (segment) freelist.Free(std::move(*segment)); });
+	}));
+
+	BuddyAllocator<RangeAllocatorConfig> buddy(size_t{capacity}, 16);
+	Benchmark::Report("BuddyAllocator", OPERATION_COUNT, Benchmark::BestOf(REPETITIONS, [&]
+	{
+		Benchmark_Churn(
+			[&] (size_t size) { return buddy.Allocate(AllocationRequest{size}); },
+			[&] (Optional<AllocatorSegment>&& segment) { if (segment) buddy.Free(std::move(*segment)); });
+	}));
+}
@@ -0,0 +1,43 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/IO/Logging.hpp"
+// Standard Library
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <string>
+
+
+namespace Strawberry::Core::Benchmark
+{
+	/// Returns the number of seconds taken to invoke function once.
+	template <typename F>
+	double Time(F&& function)
+	{
+		auto start = std::chrono::steady_clock::now();
+		std::invoke(std::forward<F>(function));
+		auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double>(end - start).count();
+	}
+
+
+	/// Runs function repetitions times, and returns the fastest time, which is the least affected by noise.
+	template <typename F>
+	double BestOf(unsigned int repetitions, F&& function)
+	{
+		double best = std::numeric_limits<double>::infinity();
+		for (unsigned int i = 0; i < repetitions; i++)
+		{
+			best = std::min(best, Time(function));
+		}
+		return best;
+	}
+
+
+	/// Logs the rate at which operations were completed.
+	inline void Report(const std::string& name, double operations, double seconds)
+	{
+		Logging::Info("{:<40} {:>10.3f} ms {:>12.2f} M/s", name, seconds * 1000.0, operations / seconds / 1'000'000.0);
+	}
+}
@@ -0,0 +1,125 @@
+#include "Benchmark.hpp"
+#include "Strawberry/Core/Sync/ConcurrentHashMap.hpp"
+#include "Strawberry/Core/Sync/Mutex.hpp"
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+
+
+static constexpr size_t       OPERATION_COUNT = 4'000'000;
+static constexpr uint64_t     KEY_COUNT       = 100'000;
+static constexpr unsigned int REPETITIONS     = 3;
+
+
+/// Baseline which guards a std::unordered_map with a Mutex.
+class LockedMap
+{
+public:
+	Optional<uint64_t> Find(uint64_t key) const
+	{
+		auto map = mMap.Lock();
+		auto entry = map->find(key);
+		if (entry == map->end()) return NullOpt;
+		return entry->second;
+	}
+
+
+	void InsertOrAssign(uint64_t key, uint64_t value)
+	{
+		mMap.Lock()->insert_or_assign(key, value);
+	}
+
+
+private:
+	Mutex<std::unordered_map<uint64_t, uint64_t>, MutexPolicy::Plain> mMap;
+};
+
+
+/// Performs OPERATION_COUNT random lookups split between threadCount threads, with writePercent percent of them
+/// replaced by writes.
+template <typename Map>
+void Benchmark_Mixed(Map& map, unsigned int threadCount, unsigned int writePercent)
+{
+	std::vector<std::thread> threads;
+	for (unsigned int t = 0; t < threadCount; t++)
+	{
+		threads.emplace_back([&, t]
+		{
+			std::minstd_rand random(t);
+			for (size_t i = 0; i < OPERATION_COUNT / threadCount; i++)
+			{
+				const uint64_t key = random() % KEY_COUNT;
+				if (random() % 100 < writePercent)
+				{
+					map.InsertOrAssign(key, i);
+				}
+				else
+				{
+					[[maybe_unused]] volatile bool found = map.Find(key).HasValue();
+				}
+			}
+		});
+	}
+
+	for (auto& thread : threads) thread.join();
+}
+
+
+/// Memoises a cheap function of random keys, as a tile cache would.
+void Benchmark_GetOrCompute(unsigned int threadCount)
+{
+	ConcurrentHashMap<uint64_t, uint64_t> map;
+
+	std::vector<std::thread> threads;
+	for (unsigned int t = 0; t < threadCount; t++)
+	{
+		threads.emplace_back([&, t]
+		{
+			std::minstd_rand random(t);
+			for (size_t i = 0; i < OPERATION_COUNT / threadCount; i++)
+			{
+				[[maybe_unused]] volatile uint64_t value = map.GetOrCompute(random() % KEY_COUNT, [] (uint64_t key) { return key * key; });
+			}
+		});
+	}
+
+	for (auto& thread : threads) thread.join();
+}
+
+
+int main()
+{
+	const unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	// Both maps are filled beforehand, so that the benchmarks measure steady state lookups.
+	LockedMap                             lockedMap;
+	ConcurrentHashMap<uint64_t, uint64_t> concurrentMap;
+	for (uint64_t key = 0; key < KEY_COUNT; key += 2)
+	{
+		lockedMap.InsertOrAssign(key, key);
+		concurrentMap.InsertOrAssign(key, key);
+	}
+
+	for (unsigned int writePercent : {0u, 10u, 50u})
+	{
+		for (unsigned int threads = 1; threads <= maxThreads; threads *= 2)
+		{
+			const std::string suffix = fmt::format(" {}% writes {}T", writePercent, threads);
+
+			Benchmark::Report("Mutex<std::unordered_map>" + suffix, OPERATION_COUNT,
+				Benchmark::BestOf(REPETITIONS, [&] { Benchmark_Mixed(lockedMap, threads, writePercent); }));
+			Benchmark::Report("ConcurrentHashMap" + suffix, OPERATION_COUNT,
+				Benchmark::BestOf(REPETITIONS, [&] { Benchmark_Mixed(concurrentMap, threads, writePercent); }));
+		}
+	}
+
+	for (unsigned int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		Benchmark::Report(fmt::format("ConcurrentHashMap::GetOrCompute {}T", threads), OPERATION_COUNT,
+			Benchmark::BestOf(REPETITIONS, [&] { Benchmark_GetOrCompute(threads); }));
+	}
+}
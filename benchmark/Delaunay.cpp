@@ -0,0 +1,64 @@
+#include "Benchmark.hpp"
+#include "Strawberry/Core/Math/Graph/Delauney.hpp"
+#include "Strawberry/Core/Util/Arena.hpp"
+#include <random>
+#include <thread>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+using namespace Math;
+
+
+static constexpr unsigned int POINT_COUNT = 1'000'000;
+static constexpr unsigned int REPETITIONS = 3;
+static const AABB<double, 2>  BOUNDS(Vector{0.0, 0.0}, Vector{1000.0, 1000.0});
+
+
+std::vector<Vector<double, 2>> GeneratePoints()
+{
+	std::minstd_rand                       random(1);
+	std::uniform_real_distribution<double> distribution(0.0, 1000.0);
+
+	std::vector<Vector<double, 2>> points;
+	for (unsigned int i = 0; i < POINT_COUNT; i++)
+	{
+		points.emplace_back(distribution(random), distribution(random));
+	}
+	return points;
+}
+
+
+int main()
+{
+	const auto points = GeneratePoints();
+
+	Benchmark::Report("Delaunay", POINT_COUNT, Benchmark::BestOf(REPETITIONS, [&]
+	{
+		[[maybe_unused]] auto delaunay = Delaunay<Vector<double, 2>>::Builder(BOUNDS)
+			.WithNodes(points)
+			.Build();
+	}));
+
+	// The arena outlives the builds, as it would in a program which triangulates every frame.
+	Arena arena;
+	Benchmark::Report("Delaunay with scratch Arena", POINT_COUNT, Benchmark::BestOf(REPETITIONS, [&]
+	{
+		[[maybe_unused]] auto delaunay = Delaunay<Vector<double, 2>>::Builder(BOUNDS)
+			.WithScratchArena(arena)
+			.WithNodes(points)
+			.Build();
+	}));
+
+	for (unsigned int threads = 1; threads <= std::thread::hardware_concurrency(); threads *= 2)
+	{
+		// The calling thread works alongside the pool.
+		ThreadPool pool(static_cast<int>(threads - 1));
+		Benchmark::Report(fmt::format("Delaunay BuildParallel {}T", threads), POINT_COUNT, Benchmark::BestOf(REPETITIONS, [&]
+		{
+			[[maybe_unused]] auto delaunay = Delaunay<Vector<double, 2>>::Builder(BOUNDS)
+				.WithNodes(points)
+				.BuildParallel(pool);
+		}));
+	}
+}
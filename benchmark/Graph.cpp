@@ -0,0 +1,94 @@
+#include "Benchmark.hpp"
+#include "Strawberry/Core/Math/Graph/CSRGraph.hpp"
+#include <random>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+using namespace Math;
+
+
+static constexpr unsigned int NODE_COUNT  = 100'000;
+static constexpr unsigned int EDGE_COUNT  = 400'000;
+static constexpr unsigned int REPETITIONS = 5;
+
+
+UndirectedGraph<unsigned int> GenerateGraph()
+{
+	std::minstd_rand random(1);
+
+	UndirectedGraph<unsigned int> graph;
+	for (unsigned int i = 0; i < NODE_COUNT; i++)
+	{
+		graph.AddNode(i);
+	}
+	for (unsigned int i = 0; i < EDGE_COUNT; i++)
+	{
+		unsigned int a = random() % NODE_COUNT;
+		unsigned int b = random() % NODE_COUNT;
+		if (a != b) graph.AddEdge({a, b});
+	}
+	return graph;
+}
+
+
+/// Breadth first search from node 0, returning the sum of the values reached, so that nothing is optimised away.
+template <typename GetNeighbours, typename GetValue>
+unsigned long long BreadthFirstSum(GetNeighbours&& getNeighbours, GetValue&& getValue)
+{
+	std::vector<bool>         visited(NODE_COUNT, false);
+	std::vector<unsigned int> frontier{0};
+	visited[0] = true;
+
+	unsigned long long sum = 0;
+	for (size_t i = 0; i < frontier.size(); i++)
+	{
+		sum += getValue(frontier[i]);
+		for (auto neighbour : getNeighbours(frontier[i]))
+		{
+			if (!visited[neighbour])
+			{
+				visited[neighbour] = true;
+				frontier.emplace_back(neighbour);
+			}
+		}
+	}
+	return sum;
+}
+
+
+int main()
+{
+	const auto graph = GenerateGraph();
+	const auto edges = 2.0 * graph.EdgeCount();
+
+	unsigned long long expected = 0;
+	Benchmark::Report("Graph BFS (GetNeighbours)", edges, Benchmark::BestOf(REPETITIONS, [&]
+	{
+		expected = BreadthFirstSum(
+			[&] (unsigned int node) { return graph.GetNeighbours(node); },
+			[&] (unsigned int node) { return graph.GetValue(node); });
+	}));
+
+	Benchmark::Report("Graph BFS (Neighbours)", edges, Benchmark::BestOf(REPETITIONS, [&]
+	{
+		auto sum = BreadthFirstSum(
+			[&] (unsigned int node) -> const auto& { return graph.Neighbours(node); },
+			[&] (unsigned int node) { return graph.GetValue(node); });
+		AssertEQ(sum, expected);
+	}));
+
+	CSRGraph<unsigned int, GraphTypeUndirected> frozen;
+	Benchmark::Report("CSRGraph freeze", edges, Benchmark::BestOf(REPETITIONS, [&]
+	{
+		frozen = CSRGraph(graph);
+	}));
+
+	Benchmark::Report("CSRGraph BFS", edges, Benchmark::BestOf(REPETITIONS, [&]
+	{
+		auto sum = BreadthFirstSum(
+			[&] (unsigned int node) { return frozen.GetNeighbours(node); },
+			[&] (unsigned int node) { return frozen.GetValue(node); });
+		AssertEQ(sum, expected);
+	}));
+}
@@ -0,0 +1,107 @@
+#include "Benchmark.hpp"
+#include "Strawberry/Core/Util/IDPool.hpp"
+#include <algorithm>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+
+
+static constexpr size_t       OPERATION_COUNT = 4'000'000;
+static constexpr size_t       LIVE_COUNT      = 100'000;
+static constexpr unsigned int REPETITIONS     = 3;
+
+
+/// Baseline which keeps free IDs in a std::set, and searches it for the lowest, as IDPool used to.
+class SetIDPool
+{
+public:
+	uint32_t Allocate()
+	{
+		if (mFreeIDs.empty()) return mGreatestID++;
+		auto minimum = *std::min_element(mFreeIDs.begin(), mFreeIDs.end());
+		mFreeIDs.erase(minimum);
+		return minimum;
+	}
+
+
+	void Free(uint32_t id)
+	{
+		mFreeIDs.emplace(id);
+	}
+
+
+private:
+	uint32_t           mGreatestID = 0;
+	std::set<uint32_t> mFreeIDs;
+};
+
+
+/// Keeps liveCount IDs allocated, freeing a batch of random ones and allocating replacements at each step, as
+/// entities are destroyed and spawned each frame.
+template <typename Pool>
+void Benchmark_Churn(Pool& pool, size_t operationCount, size_t liveCount, unsigned int seed = 1)
+{
+	static constexpr size_t BATCH_SIZE = 64;
+
+	std::minstd_rand      random(seed);
+	std::vector<uint32_t> live;
+	live.reserve(liveCount);
+	for (size_t i = 0; i < liveCount; i++) live.emplace_back(pool.Allocate());
+
+	for (size_t i = 0; i < operationCount; i += BATCH_SIZE)
+	{
+		// The batch is taken from the end, after swapping random IDs there.
+		for (size_t j = 0; j < BATCH_SIZE; j++)
+		{
+			std::swap(live[random() % (liveCount - j)], live[liveCount - 1 - j]);
+			pool.Free(live[liveCount - 1 - j]);
+		}
+		for (size_t j = 0; j < BATCH_SIZE; j++)
+		{
+			live[liveCount - 1 - j] = pool.Allocate();
+		}
+	}
+
+	for (uint32_t id : live) pool.Free(id);
+}
+
+
+int main()
+{
+	Benchmark::Report("std::set", OPERATION_COUNT, Benchmark::BestOf(REPETITIONS, []
+	{
+		SetIDPool pool;
+		Benchmark_Churn(pool, OPERATION_COUNT, LIVE_COUNT);
+	}));
+
+	Benchmark::Report("IDPool<Lowest>", OPERATION_COUNT, Benchmark::BestOf(REPETITIONS, []
+	{
+		IDPool<uint32_t, IDPoolPolicy::Lowest> pool;
+		Benchmark_Churn(pool, OPERATION_COUNT, LIVE_COUNT);
+	}));
+
+	Benchmark::Report("IDPool<Stack>", OPERATION_COUNT, Benchmark::BestOf(REPETITIONS, []
+	{
+		IDPool<uint32_t, IDPoolPolicy::Stack> pool;
+		Benchmark_Churn(pool, OPERATION_COUNT, LIVE_COUNT);
+	}));
+
+	const unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	for (unsigned int threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+	{
+		Benchmark::Report(fmt::format("ConcurrentIDPool {}T", threadCount), OPERATION_COUNT, Benchmark::BestOf(REPETITIONS, [&]
+		{
+			ConcurrentIDPool<uint32_t> pool;
+			std::vector<std::thread> threads;
+			for (unsigned int t = 0; t < threadCount; t++)
+			{
+				threads.emplace_back([&, t] { Benchmark_Churn(pool, OPERATION_COUNT / threadCount, LIVE_COUNT / threadCount, t); });
+			}
+			for (auto& thread : threads) thread.join();
+		}));
+	}
+}
@@ -0,0 +1,48 @@
+#include "Benchmark.hpp"
+#include "Strawberry/Core/Math/Graph/LloydRelaxation.hpp"
+#include "Strawberry/Core/Thread/ThreadPool.hpp"
+#include <random>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+using namespace Math;
+
+
+static constexpr unsigned int POINT_COUNT = 100'000;
+static constexpr unsigned int ITERATION_COUNT = 30;
+static constexpr unsigned int REPETITIONS = 3;
+static const AABB<double, 2>  BOUNDS(Vector{0.0, 0.0}, Vector{1000.0, 1000.0});
+
+
+std::vector<Vector<double, 2>> GeneratePoints()
+{
+	std::minstd_rand                       random(1);
+	std::uniform_real_distribution<double> distribution(0.0, 1000.0);
+
+	std::vector<Vector<double, 2>> points;
+	for (unsigned int i = 0; i < POINT_COUNT; i++)
+	{
+		points.emplace_back(distribution(random), distribution(random));
+	}
+	return points;
+}
+
+
+int main()
+{
+	const auto points = GeneratePoints();
+
+	Benchmark::Report("LloydRelaxation", POINT_COUNT * ITERATION_COUNT, Benchmark::BestOf(REPETITIONS, [&]
+	{
+		LloydRelaxation<Vector<double, 2>> relaxation(BOUNDS, points);
+		relaxation.Relax(ITERATION_COUNT);
+	}));
+
+	ThreadPool pool;
+	Benchmark::Report("LloydRelaxation (ThreadPool)", POINT_COUNT * ITERATION_COUNT, Benchmark::BestOf(REPETITIONS, [&]
+	{
+		LloydRelaxation<Vector<double, 2>> relaxation(BOUNDS, points);
+		relaxation.Relax(pool, ITERATION_COUNT);
+	}));
+}
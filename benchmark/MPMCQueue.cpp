@@ -0,0 +1,132 @@
+#include "Benchmark.hpp"
+#include "Strawberry/Core/Sync/ProducerConsumerQueue.hpp"
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+
+
+static constexpr size_t       MESSAGE_COUNT = 4'000'000;
+static constexpr size_t       CAPACITY      = 1024;
+static constexpr unsigned int REPETITIONS   = 3;
+
+
+/// Baseline which guards a std::deque with a std::mutex.
+class LockedQueue
+{
+public:
+	bool Push(uint64_t value)
+	{
+		std::unique_lock lock(mMutex);
+		if (mValues.size() == CAPACITY) return false;
+		mValues.emplace_back(value);
+		return true;
+	}
+
+
+	Optional<uint64_t> Pop()
+	{
+		std::unique_lock lock(mMutex);
+		if (mValues.empty()) return NullOpt;
+		uint64_t value = mValues.front();
+		mValues.pop_front();
+		return value;
+	}
+
+
+private:
+	std::mutex           mMutex;
+	std::deque<uint64_t> mValues;
+};
+
+
+/// Moves MESSAGE_COUNT values from producerCount producers to consumerCount consumers, spinning when full or empty.
+template <typename Queue>
+void Benchmark_Spinning(unsigned int producerCount, unsigned int consumerCount)
+{
+	Queue queue;
+	std::atomic<size_t> received = 0;
+
+	std::vector<std::thread> threads;
+	for (unsigned int p = 0; p < producerCount; p++)
+	{
+		threads.emplace_back([&, p]
+		{
+			for (size_t i = p; i < MESSAGE_COUNT; i += producerCount)
+			{
+				while (!queue.Push(uint64_t(i))) {}
+			}
+		});
+	}
+
+	for (unsigned int c = 0; c < consumerCount; c++)
+	{
+		threads.emplace_back([&]
+		{
+			while (received.load(std::memory_order_relaxed) < MESSAGE_COUNT)
+			{
+				if (queue.Pop())
+				{
+					received.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+		});
+	}
+
+	for (auto& thread : threads) thread.join();
+}
+
+
+/// As Benchmark_Spinning, but producers and consumers sleep when they cannot make progress.
+void Benchmark_Blocking(unsigned int producerCount, unsigned int consumerCount)
+{
+	LockFree::BlockingMPMCQueue<uint64_t, CAPACITY> queue;
+
+	std::vector<std::thread> threads;
+	for (unsigned int p = 0; p < producerCount; p++)
+	{
+		threads.emplace_back([&, p]
+		{
+			for (size_t i = p; i < MESSAGE_COUNT; i += producerCount)
+			{
+				queue.PushWait(uint64_t(i));
+			}
+		});
+	}
+
+	for (unsigned int c = 0; c < consumerCount; c++)
+	{
+		// Split the messages between consumers up front, so that none of them waits forever.
+		const size_t share = MESSAGE_COUNT / consumerCount + (c < MESSAGE_COUNT % consumerCount ? 1 : 0);
+		threads.emplace_back([&, share]
+		{
+			for (size_t i = 0; i < share; i++)
+			{
+				queue.PopWait();
+			}
+		});
+	}
+
+	for (auto& thread : threads) thread.join();
+}
+
+
+int main()
+{
+	const unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency() / 2);
+
+	for (unsigned int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		const std::string suffix = fmt::format(" {}P/{}C", threads, threads);
+
+		Benchmark::Report("std::mutex + std::deque" + suffix, MESSAGE_COUNT,
+			Benchmark::BestOf(REPETITIONS, [=] { Benchmark_Spinning<LockedQueue>(threads, threads); }));
+		Benchmark::Report("MPMCQueue" + suffix, MESSAGE_COUNT,
+			Benchmark::BestOf(REPETITIONS, [=] { Benchmark_Spinning<LockFree::MPMCQueue<uint64_t, CAPACITY>>(threads, threads); }));
+		Benchmark::Report("BlockingMPMCQueue" + suffix, MESSAGE_COUNT,
+			Benchmark::BestOf(REPETITIONS, [=] { Benchmark_Blocking(threads, threads); }));
+	}
+}
@@ -0,0 +1,85 @@
+#include "Benchmark.hpp"
+#include "Strawberry/Core/Math/Geometry/PointSet.hpp"
+#include "Strawberry/Core/Math/Graph/Algorithms.hpp"
+#include "Strawberry/Core/Math/Graph/Delauney.hpp"
+#include "Strawberry/Core/Math/Graph/ParallelAlgorithms.hpp"
+#include <thread>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+using namespace Math;
+
+
+/// The graph is a GRID_SIZE by GRID_SIZE grid of copies of one triangulation, each joined to the next in both
+/// directions, which gives a planar mesh with around a million nodes without triangulating them all.
+static constexpr unsigned int TILE_POINT_COUNT = 1'000;
+static constexpr unsigned int GRID_SIZE        = 32;
+static constexpr unsigned int STITCH_COUNT     = 8;
+static constexpr unsigned int REPETITIONS      = 5;
+static const AABB<double, 2>  BOUNDS(Vector{0.0, 0.0}, Vector{1000.0, 1000.0});
+
+
+using Mesh = CSRGraph<Vector<double, 2>, GraphTypeUndirected>;
+
+
+Mesh GenerateMesh()
+{
+	auto points   = PointSet<double, 2>::UniformDistribution(TILE_POINT_COUNT, BOUNDS);
+	auto delaunay = Delaunay<Vector<double, 2>>::Builder(BOUNDS).WithNodes(points).Build();
+	auto tile     = CSRGraph(delaunay.GetGraph());
+
+	const unsigned int             tileNodes = tile.NodeCount();
+	std::vector<Vector<double, 2>> values;
+	std::vector<Mesh::Edge>        edges;
+	for (unsigned int y = 0; y < GRID_SIZE; y++)
+	{
+		for (unsigned int x = 0; x < GRID_SIZE; x++)
+		{
+			const unsigned int      first = (y * GRID_SIZE + x) * tileNodes;
+			const Vector<double, 2> offset(1000.0 * x, 1000.0 * y);
+			for (auto value : tile.Values()) values.emplace_back(value + offset);
+			for (auto edge : tile.Edges()) edges.emplace_back(first + edge.A(), first + edge.B());
+
+			// Join a few nodes of this tile to the same nodes of the tiles to the right and below.
+			for (unsigned int i = 0; i < STITCH_COUNT; i++)
+			{
+				const unsigned int node = i * tileNodes / STITCH_COUNT;
+				if (x + 1 < GRID_SIZE) edges.emplace_back(first + node, first + tileNodes + node);
+				if (y + 1 < GRID_SIZE) edges.emplace_back(first + node, first + GRID_SIZE * tileNodes + node);
+			}
+		}
+	}
+
+	return Mesh(std::move(values), edges);
+}
+
+
+int main()
+{
+	const Mesh   mesh  = GenerateMesh();
+	const double edges = static_cast<double>(mesh.EdgeCount());
+
+	GraphWorkspace<unsigned int> workspace;
+	std::vector<unsigned int>    labels;
+	Benchmark::Report("BreadthFirst", edges, Benchmark::BestOf(REPETITIONS, [&] { BreadthFirst(mesh, 0u, workspace); }));
+	Benchmark::Report("ConnectedComponents", edges, Benchmark::BestOf(REPETITIONS, [&] { ConnectedComponents(mesh, workspace, labels); }));
+
+	ParallelBreadthFirstSearch<unsigned int> search;
+	ConcurrentDisjointSets<unsigned int>     sets;
+	for (unsigned int threads = 1; threads <= std::thread::hardware_concurrency(); threads *= 2)
+	{
+		// The calling thread works alongside the pool.
+		ThreadPool pool(static_cast<int>(threads - 1));
+
+		Benchmark::Report(fmt::format("ParallelBreadthFirstSearch {}T", threads), edges, Benchmark::BestOf(REPETITIONS, [&]
+		{
+			search.Run(pool, mesh, 0u);
+		}));
+
+		Benchmark::Report(fmt::format("ParallelConnectedComponents {}T", threads), edges, Benchmark::BestOf(REPETITIONS, [&]
+		{
+			ParallelConnectedComponents(pool, mesh, labels, sets);
+		}));
+	}
+}
@@ -0,0 +1,120 @@
+#include "Benchmark.hpp"
+#include "Strawberry/Core/Sync/Stack.hpp"
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+
+
+static constexpr size_t       OPERATION_COUNT = 2'000'000;
+static constexpr unsigned int REPETITIONS     = 3;
+
+
+/// Baseline which guards a std::vector with a std::mutex.
+class LockedStack
+{
+public:
+	void Push(uint64_t value)
+	{
+		std::unique_lock lock(mMutex);
+		mValues.emplace_back(value);
+	}
+
+
+	Optional<uint64_t> Pop()
+	{
+		std::unique_lock lock(mMutex);
+		if (mValues.empty()) return NullOpt;
+		uint64_t value = mValues.back();
+		mValues.pop_back();
+		return value;
+	}
+
+
+private:
+	std::mutex            mMutex;
+	std::vector<uint64_t> mValues;
+};
+
+
+/// Runs function(i) for OPERATION_COUNT values of i, split between threadCount threads.
+template <typename F>
+void RunSplit(unsigned int threadCount, F function)
+{
+	std::vector<std::thread> threads;
+	for (unsigned int t = 0; t < threadCount; t++)
+	{
+		threads.emplace_back([=]
+		{
+			for (size_t i = t; i < OPERATION_COUNT; i += threadCount)
+			{
+				function(i);
+			}
+		});
+	}
+
+	for (auto& thread : threads) thread.join();
+}
+
+
+/// Every thread pushes a value and pops one, OPERATION_COUNT times in total.
+template <typename Stack>
+void Benchmark_Stack(unsigned int threadCount)
+{
+	Stack stack;
+	RunSplit(threadCount, [&] (size_t i)
+	{
+		stack.Push(uint64_t(i));
+		while (!stack.Pop()) {}
+	});
+}
+
+
+/// The cost of retiring an object and eventually reclaiming it, compared with deleting it straight away.
+template <typename R>
+void Benchmark_Retire(unsigned int threadCount)
+{
+	RunSplit(threadCount, [] (size_t i)
+	{
+		typename R::Guard guard;
+		R::Retire(new uint64_t(i));
+	});
+	R::Flush();
+}
+
+
+void Benchmark_Delete(unsigned int threadCount)
+{
+	RunSplit(threadCount, [] (size_t i)
+	{
+		uint64_t* volatile object = new uint64_t(i);
+		delete object;
+	});
+}
+
+
+int main()
+{
+	const unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	for (unsigned int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		const std::string suffix = fmt::format(" {}T", threads);
+
+		Benchmark::Report("new + delete" + suffix, OPERATION_COUNT,
+			Benchmark::BestOf(REPETITIONS, [=] { Benchmark_Delete(threads); }));
+		Benchmark::Report("Epoch Guard + Retire" + suffix, OPERATION_COUNT,
+			Benchmark::BestOf(REPETITIONS, [=] { Benchmark_Retire<LockFree::EpochReclaimer>(threads); }));
+		Benchmark::Report("Hazard Pointer Guard + Retire" + suffix, OPERATION_COUNT,
+			Benchmark::BestOf(REPETITIONS, [=] { Benchmark_Retire<LockFree::HazardPointerReclaimer>(threads); }));
+
+		Benchmark::Report("std::mutex + std::vector" + suffix, OPERATION_COUNT,
+			Benchmark::BestOf(REPETITIONS, [=] { Benchmark_Stack<LockedStack>(threads); }));
+		Benchmark::Report("Stack<EpochReclaimer>" + suffix, OPERATION_COUNT,
+			Benchmark::BestOf(REPETITIONS, [=] { Benchmark_Stack<LockFree::Stack<uint64_t, LockFree::EpochReclaimer>>(threads); }));
+		Benchmark::Report("Stack<HazardPointerReclaimer>" + suffix, OPERATION_COUNT,
+			Benchmark::BestOf(REPETITIONS, [=] { Benchmark_Stack<LockFree::Stack<uint64_t, LockFree::HazardPointerReclaimer>>(threads); }));
+	}
+}
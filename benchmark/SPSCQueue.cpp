@@ -0,0 +1,86 @@
+#include "Benchmark.hpp"
+#include "Strawberry/Core/Sync/ProducerConsumerQueue.hpp"
+#include <thread>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+
+
+static constexpr size_t       MESSAGE_COUNT = 50'000'000;
+static constexpr size_t       CAPACITY      = 1024;
+static constexpr unsigned int REPETITIONS   = 3;
+
+
+/// Moves every message through the queue one at a time.
+void Benchmark_Single()
+{
+	LockFree::SPSCQueue<uint64_t, CAPACITY> queue;
+
+	std::thread producer([&]
+	{
+		for (uint64_t i = 0; i < MESSAGE_COUNT; i++)
+		{
+			while (!queue.Push(i)) {}
+		}
+	});
+
+	uint64_t sum = 0;
+	for (size_t received = 0; received < MESSAGE_COUNT;)
+	{
+		if (auto value = queue.Pop())
+		{
+			sum += value.Unwrap();
+			received++;
+		}
+	}
+
+	producer.join();
+	Assert(sum == MESSAGE_COUNT * (MESSAGE_COUNT - 1) / 2);
+}
+
+
+/// Moves every message through the queue in batches of the given size.
+void Benchmark_Batched(size_t batchSize)
+{
+	LockFree::SPSCQueue<uint64_t, CAPACITY> queue;
+
+	std::thread producer([&]
+	{
+		std::vector<uint64_t> batch(batchSize);
+		for (uint64_t i = 0; i < MESSAGE_COUNT; i += batchSize)
+		{
+			const size_t count = std::min<size_t>(batchSize, MESSAGE_COUNT - i);
+			for (size_t j = 0; j < count; j++) batch[j] = i + j;
+
+			std::span<const uint64_t> remaining(batch.data(), count);
+			while (!remaining.empty())
+			{
+				remaining = remaining.subspan(queue.PushN(remaining));
+			}
+		}
+	});
+
+	std::vector<uint64_t> output(batchSize);
+	uint64_t sum = 0;
+	for (size_t received = 0; received < MESSAGE_COUNT;)
+	{
+		const size_t count = queue.PopN(output);
+		for (size_t j = 0; j < count; j++) sum += output[j];
+		received += count;
+	}
+
+	producer.join();
+	Assert(sum == MESSAGE_COUNT * (MESSAGE_COUNT - 1) / 2);
+}
+
+
+int main()
+{
+	Benchmark::Report("SPSCQueue Push/Pop", MESSAGE_COUNT, Benchmark::BestOf(REPETITIONS, [] { Benchmark_Single(); }));
+	for (size_t batchSize : {8, 64, 256})
+	{
+		Benchmark::Report(fmt::format("SPSCQueue PushN/PopN ({})", batchSize), MESSAGE_COUNT,
+			Benchmark::BestOf(REPETITIONS, [=] { Benchmark_Batched(batchSize); }));
+	}
+}
@@ -0,0 +1,81 @@
+#include "Benchmark.hpp"
+#include "Strawberry/Core/Thread/ThreadPool.hpp"
+#include <future>
+#include <latch>
+
+
+using namespace Strawberry::Core;
+
+
+static constexpr unsigned int JOB_COUNT   = 1'000'000;
+static constexpr unsigned int REPETITIONS = 5;
+
+
+/// Queues every job with the std::function + std::promise + std::packaged_task packaging which Worker used to use.
+void Benchmark_StdFuture(ThreadPool& pool)
+{
+	std::vector<std::future<int>> futures;
+	futures.reserve(JOB_COUNT);
+
+	for (unsigned int i = 0; i < JOB_COUNT; i++)
+	{
+		std::function<int()> job = [i] { return static_cast<int>(i); };
+		std::promise<int> promise;
+		futures.emplace_back(promise.get_future());
+		pool.Post([task = std::packaged_task<void()>([promise = std::move(promise), job = std::move(job)] mutable
+		{
+			promise.set_value(job());
+		})] mutable { task(); });
+	}
+
+	for (auto& future : futures)
+	{
+		future.get();
+	}
+}
+
+
+/// Queues every job with QueueTask, and waits on the returned PendingTasks.
+void Benchmark_PendingTask(ThreadPool& pool)
+{
+	PendingTaskList<int> pending;
+	pending.reserve(JOB_COUNT);
+
+	for (unsigned int i = 0; i < JOB_COUNT; i++)
+	{
+		pending.emplace_back(pool.QueueTask([i] { return static_cast<int>(i); }).Unwrap());
+	}
+
+	for (auto& task : pending)
+	{
+		task.Get();
+	}
+}
+
+
+/// Posts every job as fire-and-forget, and waits on a single latch.
+void Benchmark_Post(ThreadPool& pool)
+{
+	std::latch remaining(JOB_COUNT);
+
+	for (unsigned int i = 0; i < JOB_COUNT; i++)
+	{
+		pool.Post([&remaining] { remaining.count_down(); });
+	}
+
+	remaining.wait();
+}
+
+
+int main()
+{
+	for (auto scheduling : {ThreadPool::Scheduling::RoundRobin, ThreadPool::Scheduling::WorkStealing})
+	{
+		ThreadPool pool(static_cast<int>(std::thread::hardware_concurrency()), scheduling);
+		const std::string mode = scheduling == ThreadPool::Scheduling::RoundRobin ? "RoundRobin" : "WorkStealing";
+
+		Benchmark::Report(mode + " std::future",  JOB_COUNT, Benchmark::BestOf(REPETITIONS, [&] { Benchmark_StdFuture(pool); }));
+		Benchmark::Report(mode + " PendingTask",  JOB_COUNT, Benchmark::BestOf(REPETITIONS, [&] { Benchmark_PendingTask(pool); }));
+		Benchmark::Report(mode + " Post",         JOB_COUNT, Benchmark::BestOf(REPETITIONS, [&] { Benchmark_Post(pool); }));
+	}
+}
@@ -0,0 +1,40 @@
+#include "Benchmark.hpp"
+#include "Strawberry/Core/Math/Graph/Voronoi.hpp"
+#include <random>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+using namespace Math;
+
+
+static constexpr unsigned int POINT_COUNT = 1'000'000;
+static constexpr unsigned int REPETITIONS = 3;
+static const AABB<double, 2>  BOUNDS(Vector{0.0, 0.0}, Vector{1000.0, 1000.0});
+
+
+std::vector<Vector<double, 2>> GeneratePoints()
+{
+	std::minstd_rand                       random(1);
+	std::uniform_real_distribution<double> distribution(0.0, 1000.0);
+
+	std::vector<Vector<double, 2>> points;
+	for (unsigned int i = 0; i < POINT_COUNT; i++)
+	{
+		points.emplace_back(distribution(random), distribution(random));
+	}
+	return points;
+}
+
+
+int main()
+{
+	const auto delaunay = Delaunay<Vector<double, 2>>::Builder(BOUNDS)
+		.WithNodes(GeneratePoints())
+		.Build();
+
+	Benchmark::Report("Voronoi", POINT_COUNT, Benchmark::BestOf(REPETITIONS, [&]
+	{
+		[[maybe_unused]] auto voronoi = Voronoi<Vector<double, 2>>::Builder(delaunay).Build();
+	}));
+}
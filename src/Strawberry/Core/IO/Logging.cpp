@@ -1,5 +1,6 @@
 // Strawberry Core
 #include "Strawberry/Core/IO/Logging.hpp"
+#include "Strawberry/Core/Sync/Snapshot.hpp"
 #include "Strawberry/Core/Types/Optional.hpp"
 // Standard Library
 #include <fstream>
@@ -10,8 +11,9 @@
 
 namespace Strawberry::Core
 {
-	static Optional<Logging::Level> sLogLevel   = {};
-	static Optional<std::ofstream>  sOutputFile = {};
+	/// Starts at Level::Trace, whose value is zero.
+	static constinit Snapshot<Logging::Level> sLogLevel;
+	static Optional<std::ofstream>            sOutputFile = {};
 
 
 	std::string Logging::LevelToString(Level logLevel)
@@ -36,13 +38,13 @@ namespace Strawberry::Core
 
 	Logging::Level Logging::GetLevel()
 	{
-		return sLogLevel.UnwrapOr(Level::Trace);
+		return sLogLevel.Load();
 	}
 
 
 	void Logging::SetLevel(Level logLevel)
 	{
-		sLogLevel = logLevel;
+		sLogLevel.Store(logLevel);
 	}
 
 
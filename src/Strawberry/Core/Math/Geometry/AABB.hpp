@@ -5,6 +5,8 @@
 #include "Strawberry/Core/Math/Geometry/Intersection.hpp"
 #include "Strawberry/Core/Types/Optional.hpp"
 #include <algorithm>
+#include <functional>
+#include <vector>
 
 
 namespace Strawberry::Core::Math
@@ -130,6 +132,70 @@ namespace Strawberry::Core::Math
 		}
 
 
+		/// Returns how far inside the given side of the box a point is. Sides 0 and 1 are the minimum and maximum of the
+		/// first axis, 2 and 3 are those of the second, and so on.
+		T SideDistance(const Vector<T, D>& point, unsigned int side) const noexcept
+		{
+			return side % 2 == 0 ? point[side / 2] - SideValue(side) : SideValue(side) - point[side / 2];
+		}
+
+
+		/// Returns the coordinate of the given side along its axis.
+		T SideValue(unsigned int side) const noexcept
+		{
+			return side % 2 == 0 ? mMin[side / 2] : mMax[side / 2];
+		}
+
+
+		/// Sutherland-Hodgman clipping of the convex polygon input against one side of the box, writing the result to
+		/// output. Vertices exactly on the side are kept, and edges are only cut where they cross it strictly, so no
+		/// corner appears twice.
+		///
+		/// The vertices may be of any type, whose points are given by position. Where an edge crosses the side, the new
+		/// vertex is made by cut(vertex, next, t), for the fraction t of the way from vertex to next. Where the polygon
+		/// leaves the box, leaving is called on the vertex of output whose edge to the next runs along the side.
+		template <typename Vertex, typename Position, typename Cut, typename Leaving>
+		void ClipToSide(const std::vector<Vertex>& input, std::vector<Vertex>& output, unsigned int side,
+						Position&& position, Cut&& cut, Leaving&& leaving) const
+		{
+			output.clear();
+			for (size_t i = 0; i < input.size(); i++)
+			{
+				const Vertex& vertex = input[i];
+				const Vertex& next   = input[(i + 1) % input.size()];
+				const T distance     = SideDistance(std::invoke(position, vertex), side);
+				const T nextDistance = SideDistance(std::invoke(position, next), side);
+
+				if (distance >= 0)
+				{
+					Vertex& kept = output.emplace_back(vertex);
+					if (distance == 0 && nextDistance < 0) leaving(kept);
+				}
+
+				if ((distance > 0 && nextDistance < 0) || (distance < 0 && nextDistance > 0))
+				{
+					Vertex& crossing = output.emplace_back(cut(vertex, next, distance / (distance - nextDistance)));
+					if (distance > 0) leaving(crossing);
+				}
+			}
+		}
+
+
+		/// Clips the convex polygon input against one side of the box as above, for a polygon of plain points. Crossings
+		/// are placed exactly on the side.
+		void ClipToSide(const std::vector<Vector<T, D>>& input, std::vector<Vector<T, D>>& output, unsigned int side) const
+		{
+			auto cut = [&] (const Vector<T, D>& a, const Vector<T, D>& b, T t)
+			{
+				Vector<T, D> crossing = a + t * (b - a);
+				crossing[side / 2] = SideValue(side);
+				return crossing;
+			};
+
+			ClipToSide(input, output, side, std::identity{}, cut, [] (Vector<T, D>&) {});
+		}
+
+
 		/// Returns the edges of the AABB as line segments in CCW order,
 		/// starting from the bottom left.
 		ConvexPolygon<T> AsPolygon() const noexcept
@@ -5,6 +5,7 @@
 #include <vector>
 #include "Ray.hpp"
 #include "Intersection.hpp"
+#include "Predicates.hpp"
 #include "Simplex.hpp"
 #include "AABB.hpp"
 
@@ -120,7 +121,7 @@ namespace Strawberry::Core::Math
 			for (int i = 0; i < LineCount(); i++)
 			{
 				auto line = GetLine(i);
-				if ((line.B() - line.A()).DotPerp(v - line.A()) < 0.0)
+				if (Orient2D(line.A(), line.B(), v) < 0.0)
 				{
 					return false;
 				}
@@ -141,7 +142,7 @@ namespace Strawberry::Core::Math
 				const auto& b = mPoints[(i + 1) % mPoints.size()];
 				const auto& c = mPoints[(i + 2) % mPoints.size()];
 
-				if ((b - a).DotPerp(c - a) < 0.0)
+				if (Orient2D(a, b, c) < 0.0)
 				{
 					return false;
 				}
@@ -2,6 +2,7 @@
 
 
 #include "Strawberry/Core/Math/Geometry/Line.hpp"
+#include "Strawberry/Core/Math/Geometry/Predicates.hpp"
 
 
 namespace Strawberry::Core::Math
@@ -52,33 +53,20 @@ namespace Strawberry::Core::Math
 
 		Result operator()(const LineSegment<T, 2>& a, const Line<T, 2>& b) const noexcept
 		{
-			// Solve using Cramer's rule
-			auto& p1 = a.A();
-			auto& p2 = b.A();
-			auto   c = p2 - p1;
-			auto  v1 = a.Direction();
-			auto  v2 = b.Direction();
-
-			double determinant = v1[0] * v2[1] - v2[0] * v1[1];
-			if (std::abs(determinant) <= std::numeric_limits<T>::epsilon())
-			{
-				return NullOpt;
-			}
-
-			auto t1Num = c[0] * v2[1] - v2[0] * c[1];
-			auto t1 = t1Num / determinant;
-			auto t2Num = -(v1[0] * c[1] - c[0] * v1[1]);
-			auto t2 = t2Num / determinant;
-
-			if (t1 < 0 || t1 > 1.0)
+			// Which sides of the line the ends of the segment are on decides exactly whether they cross. The signed
+			// distance from the line is linear along the segment, so it also gives where.
+			const double fromA = Orient2D(b.A(), b.B(), a.A());
+			const double fromB = Orient2D(b.A(), b.B(), a.B());
+			if ((fromA > 0 && fromB > 0) || (fromA < 0 && fromB < 0) || (fromA == 0 && fromB == 0))
 			{
 				return NullOpt;
 			}
 
+			const double t = fromA / (fromA - fromB);
 			return Data
 			{
-				.position = p1 + t1 * v1,
-				.segmentDistance = t1,
+				.position = a.A() + static_cast<T>(t) * a.Direction(),
+				.segmentDistance = t,
 				.lineSegment = a,
 				.line = b
 			};
@@ -101,32 +89,30 @@ namespace Strawberry::Core::Math
 
 		Result operator()(const LineSegment<T, 2>& a, const LineSegment<T, 2>& b) const noexcept
 		{
-			// Solve using Cramer's rule
-			auto& p1 = a.A();
-			auto& p2 = b.A();
-			auto   c = p2 - p1;
-			auto  v1 = a.Direction();
-			auto  v2 = b.Direction();
-
-			double determinant = v1[0] * v2[1] - v2[0] * v1[1];
-			if (std::abs(determinant) <= std::numeric_limits<T>::epsilon())
+			// Which sides of each segment's line the ends of the other are on decides exactly whether they cross. The
+			// signed distance from a line is linear along a segment, so it also gives where.
+			const double aFromA = Orient2D(b.A(), b.B(), a.A());
+			const double aFromB = Orient2D(b.A(), b.B(), a.B());
+			const double bFromA = Orient2D(a.A(), a.B(), b.A());
+			const double bFromB = Orient2D(a.A(), a.B(), b.B());
+
+			// Collinear segments do not cross at a single point.
+			if (bFromA == 0 && bFromB == 0)
 			{
 				return NullOpt;
 			}
 
-			auto t1Num = c[0] * v2[1] - v2[0] * c[1];
-			auto t1 = t1Num / determinant;
-			auto t2Num = -(v1[0] * c[1] - c[0] * v1[1]);
-			auto t2 = t2Num / determinant;
-
-			if (t1 < 0 || t1 > 1.0 || t2 < 0.0 || t2 >= 1.0)
+			// Segment a is crossed anywhere from its start to its end, and segment b from its start up to its end.
+			if ((aFromA > 0 && aFromB > 0) || (aFromA < 0 && aFromB < 0) || (bFromA > 0 && bFromB >= 0) || (bFromA < 0 && bFromB <= 0))
 			{
 				return NullOpt;
 			}
 
+			const double t1 = aFromA / (aFromA - aFromB);
+			const double t2 = bFromA / (bFromA - bFromB);
 			return Data
 			{
-				.position = p1 + t1 * v1,
+				.position = a.A() + static_cast<T>(t1) * a.Direction(),
 				.segmentDistance { t1, t2 },
 				.lines{ a, b }
 			};
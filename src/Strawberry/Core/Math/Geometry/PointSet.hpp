@@ -1,8 +1,8 @@
 #pragma once
 // Strawberry Core
 #include "Strawberry/Core/Math/Vector.hpp"
-#include "Strawberry/Core/Math/Graph/Voronoi.hpp"
-#include "Strawberry/Core/Math/Graph/Delauney.hpp"
+#include "Strawberry/Core/Math/Geometry/AABB.hpp"
+#include "Strawberry/Core/Math/Graph/LloydRelaxation.hpp"
 // Standard Library
 #include <algorithm>
 #include <random>
@@ -141,39 +141,31 @@ namespace Strawberry::Core::Math
 		/// containing cell's center of mass (relative to the strength parameter).
 		/// Increasing the iteration count will result in more uniform distributions
 		/// of points. The extreme result of this is a set of evenly spaces points.
-		PointSet Relaxed(const AABB<T, 2>& bounds, unsigned int iterationCount = 1, double strength = 1.0) requires (D == 2)
+		/// Stops early once no point moves further than tolerance in an iteration.
+		PointSet Relaxed(const AABB<T, 2>& bounds, unsigned int iterationCount = 1, double strength = 1.0, T tolerance = 0) requires (D == 2)
 		{
-			PointSet result = *this;
-			for (int i = 0; i < iterationCount; i++)
-			{
-				auto delaunay = typename Delaunay<Vector<T, 2>>::Builder(bounds)
-					.WithNodes(result)
-					.Build();
-				auto voronoi = typename Voronoi<Vector<T, 2>>::Builder(delaunay).Build();
-
-				PointSet next;
-				for (auto node : delaunay.GetGraph().NodeIndices())
-				{
-					auto cell = voronoi.GetCell(node).Unwrap();
+			LloydRelaxation<Vector<T, 2>> relaxation(bounds, mPoints);
+			relaxation.Relax(iterationCount, strength, tolerance);
 
-					auto p0 = delaunay.GetGraph().GetValue(node);
-					auto p1 = voronoi.GetCellAsPolygon(cell).CenterOfMass();
+			PointSet result;
+			for (const auto& point : relaxation.Points())
+			{
+				result.Add(point);
+			}
+			return result;
+		}
 
-					auto point = strength * p1
-						+ (1.0 - strength) * p0;
 
-					// If we've gone out of bounds, use the intersection of the
-					// ray defined by p0-p1 and the bounding box.
-					if (!bounds.Contains(point)) [[unlikely]]
-					{
-						Ray<T, 2> ray(p0, p1 - p0);
-						auto intersections = ray.Intersection(bounds.AsPolygon());
-						point = intersections[0].position;
-					}
+		/// Applies Lloyd Relaxation as above, using the threads of pool.
+		PointSet Relaxed(ThreadPool& pool, const AABB<T, 2>& bounds, unsigned int iterationCount = 1, double strength = 1.0, T tolerance = 0) requires (D == 2)
+		{
+			LloydRelaxation<Vector<T, 2>> relaxation(bounds, mPoints);
+			relaxation.Relax(pool, iterationCount, strength, tolerance);
 
-					next.Add(point);
-				}
-				result = next;
+			PointSet result;
+			for (const auto& point : relaxation.Points())
+			{
+				result.Add(point);
 			}
 			return result;
 		}
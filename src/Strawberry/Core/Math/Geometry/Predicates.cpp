@@ -0,0 +1,211 @@
+#include "Strawberry/Core/Math/Geometry/Predicates.hpp"
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <span>
+#include <utility>
+
+
+namespace Strawberry::Core::Math
+{
+	namespace
+	{
+		/// Returns a + b, and the rounding error of that sum.
+		std::pair<double, double> TwoSum(double a, double b) noexcept
+		{
+			const double sum      = a + b;
+			const double bVirtual = sum - a;
+			const double aVirtual = sum - bVirtual;
+			return {sum, (a - aVirtual) + (b - bVirtual)};
+		}
+
+
+		/// TwoSum for when |a| >= |b|.
+		std::pair<double, double> FastTwoSum(double a, double b) noexcept
+		{
+			const double sum = a + b;
+			return {sum, b - (sum - a)};
+		}
+
+
+		/// Returns a * b, and the rounding error of that product.
+		std::pair<double, double> TwoProduct(double a, double b) noexcept
+		{
+			const double product = a * b;
+			return {product, std::fma(a, b, -product)};
+		}
+
+
+		/// Appends the largest component of an expansion to the length components already in result, keeping it if it
+		/// is the only one. Returns the new length.
+		size_t Finish(double* result, size_t length, double largest) noexcept
+		{
+			if (largest != 0.0 || length == 0) result[length++] = largest;
+			return length;
+		}
+
+
+		/// Writes the expansion a + b to result, which must have room for the components of both, and returns its
+		/// length. At least one of a and b must not be empty.
+		size_t Sum(std::span<const double> a, std::span<const double> b, double* result) noexcept
+		{
+			// Merges the two expansions in order of magnitude, carrying the running sum up from the smallest.
+			size_t i = 0, j = 0, length = 0;
+			auto next = [&] ()
+			{
+				return j == b.size() || (i < a.size() && std::abs(a[i]) <= std::abs(b[j])) ? a[i++] : b[j++];
+			};
+
+			double carry = next();
+			while (i < a.size() || j < b.size())
+			{
+				auto [sum, error] = TwoSum(carry, next());
+				if (error != 0.0) result[length++] = error;
+				carry = sum;
+			}
+			return Finish(result, length, carry);
+		}
+
+
+		/// Writes the expansion a * b to result, which must have room for twice the components of a, and returns its
+		/// length.
+		size_t Scale(std::span<const double> a, double b, double* result) noexcept
+		{
+			size_t length = 0;
+			auto [carry, error] = TwoProduct(a[0], b);
+			if (error != 0.0) result[length++] = error;
+			for (size_t i = 1; i < a.size(); i++)
+			{
+				auto [product, productError] = TwoProduct(a[i], b);
+				auto [sum, sumError]         = TwoSum(carry, productError);
+				if (sumError != 0.0) result[length++] = sumError;
+				auto [next, nextError] = FastTwoSum(product, sum);
+				if (nextError != 0.0) result[length++] = nextError;
+				carry = next;
+			}
+			return Finish(result, length, carry);
+		}
+
+
+		/// A number stored exactly as a sum of up to N non overlapping doubles, in increasing order of magnitude. Zero
+		/// components are dropped, except that zero itself is a single zero component. The components are kept on the
+		/// stack, and each operation's result is sized for the most components it can have, so nothing is allocated.
+		template <size_t N>
+		class Expansion
+		{
+			template <size_t> friend class Expansion;
+
+		public:
+			Expansion(double value = 0.0)
+				: mLength(1)
+			{
+				mComponents[0] = value;
+			}
+
+
+			template <size_t M>
+			Expansion<N + M> operator+(const Expansion<M>& b) const
+			{
+				Expansion<N + M> result;
+				result.mLength = Sum(Components(), b.Components(), result.mComponents.data());
+				return result;
+			}
+
+
+			template <size_t M>
+			Expansion<N + M> operator-(const Expansion<M>& b) const
+			{
+				return *this + -b;
+			}
+
+
+			Expansion operator-() const
+			{
+				Expansion result = *this;
+				for (size_t i = 0; i < mLength; i++) result.mComponents[i] = -mComponents[i];
+				return result;
+			}
+
+
+			Expansion<2 * N> operator*(double b) const
+			{
+				Expansion<2 * N> result;
+				result.mLength = Scale(Components(), b, result.mComponents.data());
+				return result;
+			}
+
+
+			template <size_t M>
+			Expansion<2 * N * M> operator*(const Expansion<M>& b) const
+			{
+				// The partial sums alternate between two expansions, as a sum cannot be written over its input.
+				Expansion<2 * N * M> sums[2];
+				unsigned int current = 0;
+				sums[current].mLength = 0;
+				for (double component : b.Components())
+				{
+					const Expansion<2 * N> scaled = *this * component;
+					sums[1 - current].mLength = Sum(sums[current].Components(), scaled.Components(), sums[1 - current].mComponents.data());
+					current = 1 - current;
+				}
+				return sums[current];
+			}
+
+
+			/// Returns an approximation of the value, which has the same sign.
+			double Estimate() const noexcept
+			{
+				const auto components = Components();
+				return std::accumulate(components.begin(), components.end(), 0.0);
+			}
+
+
+		private:
+			std::span<const double> Components() const noexcept { return {mComponents.data(), mLength}; }
+
+
+			std::array<double, N> mComponents;
+			size_t                mLength;
+		};
+
+
+		/// Returns a - b exactly.
+		Expansion<2> Difference(double a, double b)
+		{
+			return Expansion<1>(a) + Expansion<1>(-b);
+		}
+	}
+
+
+	double Orient2DExact(double ax, double ay, double bx, double by, double cx, double cy)
+	{
+		const auto acx = Difference(ax, cx), acy = Difference(ay, cy);
+		const auto bcx = Difference(bx, cx), bcy = Difference(by, cy);
+		return (acx * bcy - acy * bcx).Estimate();
+	}
+
+
+	double InCircleExact(double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy)
+	{
+		const auto adx = Difference(ax, dx), ady = Difference(ay, dy);
+		const auto bdx = Difference(bx, dx), bdy = Difference(by, dy);
+		const auto cdx = Difference(cx, dx), cdy = Difference(cy, dy);
+
+		const auto aLift = adx * adx + ady * ady;
+		const auto bLift = bdx * bdx + bdy * bdy;
+		const auto cLift = cdx * cdx + cdy * cdy;
+
+		return (aLift * (bdx * cdy - cdx * bdy) + bLift * (cdx * ady - adx * cdy) + cLift * (adx * bdy - bdx * ady)).Estimate();
+	}
+
+
+	double Orient3DExact(double ax, double ay, double az, double bx, double by, double bz,
+						 double cx, double cy, double cz, double dx, double dy, double dz)
+	{
+		const auto adx = Difference(ax, dx), ady = Difference(ay, dy), adz = Difference(az, dz);
+		const auto bdx = Difference(bx, dx), bdy = Difference(by, dy), bdz = Difference(bz, dz);
+		const auto cdx = Difference(cx, dx), cdy = Difference(cy, dy), cdz = Difference(cz, dz);
+
+		return (adz * (bdx * cdy - cdx * bdy) + bdz * (cdx * ady - adx * cdy) + cdz * (adx * bdy - bdx * ady)).Estimate();
+	}
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+
+#include "Strawberry/Core/Math/Vector.hpp"
+#include <cmath>
+#include <limits>
+
+
+//======================================================================================================================
+//  Robust geometric predicates
+//----------------------------------------------------------------------------------------------------------------------
+//  The sign of each predicate is always exact, after Shewchuk's "Adaptive Precision Floating-Point Arithmetic and
+//  Fast Robust Geometric Predicates". The determinant is first evaluated in plain floating point alongside a bound
+//  on its rounding error, and only if it is too close to zero for its sign to be trusted is it evaluated again
+//  exactly, with expansion arithmetic. Points are promoted to double, so float and integer points up to 2^53 are
+//  handled exactly too.
+//======================================================================================================================
+namespace Strawberry::Core::Math
+{
+	/// Exact evaluations of the predicates below, used when their filters fail.
+	double Orient2DExact(double ax, double ay, double bx, double by, double cx, double cy);
+	double InCircleExact(double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy);
+	double Orient3DExact(double ax, double ay, double az, double bx, double by, double bz,
+						 double cx, double cy, double cz, double dx, double dy, double dz);
+
+
+	namespace PredicateErrorBounds
+	{
+		inline constexpr double EPSILON   = std::numeric_limits<double>::epsilon() / 2;
+		inline constexpr double ORIENT_2D = (3.0 + 16.0 * EPSILON) * EPSILON;
+		inline constexpr double ORIENT_3D = (7.0 + 56.0 * EPSILON) * EPSILON;
+		inline constexpr double IN_CIRCLE = (10.0 + 96.0 * EPSILON) * EPSILON;
+	}
+
+
+	/// Returns a positive value if a, b and c are in counter clockwise order, a negative value if they are in
+	/// clockwise order, and zero if they are collinear. The value approximates twice the signed area of the triangle.
+	template <typename T>
+	double Orient2D(const Vector<T, 2>& a, const Vector<T, 2>& b, const Vector<T, 2>& c)
+	{
+		const double ax = a[0], ay = a[1], bx = b[0], by = b[1], cx = c[0], cy = c[1];
+
+		const double left        = (ax - cx) * (by - cy);
+		const double right       = (ay - cy) * (bx - cx);
+		const double determinant = left - right;
+
+		// When the products have different signs, the subtraction cannot cancel, so the result's sign is right.
+		double sum;
+		if (left > 0.0)
+		{
+			if (right <= 0.0) return determinant;
+			sum = left + right;
+		}
+		else if (left < 0.0)
+		{
+			if (right >= 0.0) return determinant;
+			sum = -left - right;
+		}
+		else
+		{
+			return determinant;
+		}
+
+		const double bound = PredicateErrorBounds::ORIENT_2D * sum;
+		if (determinant >= bound || -determinant >= bound)
+		{
+			return determinant;
+		}
+
+		return Orient2DExact(ax, ay, bx, by, cx, cy);
+	}
+
+
+	/// Returns a positive value if d lies inside the circle through a, b and c, a negative value if it lies outside,
+	/// and zero if the four points are cocircular. a, b and c must be in counter clockwise order, or the sign is
+	/// reversed.
+	template <typename T>
+	double InCircle(const Vector<T, 2>& a, const Vector<T, 2>& b, const Vector<T, 2>& c, const Vector<T, 2>& d)
+	{
+		const double adx = double(a[0]) - double(d[0]), ady = double(a[1]) - double(d[1]);
+		const double bdx = double(b[0]) - double(d[0]), bdy = double(b[1]) - double(d[1]);
+		const double cdx = double(c[0]) - double(d[0]), cdy = double(c[1]) - double(d[1]);
+
+		const double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+		const double cdxady = cdx * ady, adxcdy = adx * cdy;
+		const double adxbdy = adx * bdy, bdxady = bdx * ady;
+
+		const double aLift = adx * adx + ady * ady;
+		const double bLift = bdx * bdx + bdy * bdy;
+		const double cLift = cdx * cdx + cdy * cdy;
+
+		const double determinant = aLift * (bdxcdy - cdxbdy) + bLift * (cdxady - adxcdy) + cLift * (adxbdy - bdxady);
+		const double permanent   = (std::abs(bdxcdy) + std::abs(cdxbdy)) * aLift
+								 + (std::abs(cdxady) + std::abs(adxcdy)) * bLift
+								 + (std::abs(adxbdy) + std::abs(bdxady)) * cLift;
+
+		const double bound = PredicateErrorBounds::IN_CIRCLE * permanent;
+		if (determinant > bound || -determinant > bound)
+		{
+			return determinant;
+		}
+
+		return InCircleExact(a[0], a[1], b[0], b[1], c[0], c[1], d[0], d[1]);
+	}
+
+
+	/// Returns a positive value if d lies below the plane through a, b and c, where below is the side from which a, b
+	/// and c appear in clockwise order, a negative value if it lies above, and zero if the four points are coplanar.
+	/// The value approximates six times the signed volume of the tetrahedron.
+	template <typename T>
+	double Orient3D(const Vector<T, 3>& a, const Vector<T, 3>& b, const Vector<T, 3>& c, const Vector<T, 3>& d)
+	{
+		const double adx = double(a[0]) - double(d[0]), ady = double(a[1]) - double(d[1]), adz = double(a[2]) - double(d[2]);
+		const double bdx = double(b[0]) - double(d[0]), bdy = double(b[1]) - double(d[1]), bdz = double(b[2]) - double(d[2]);
+		const double cdx = double(c[0]) - double(d[0]), cdy = double(c[1]) - double(d[1]), cdz = double(c[2]) - double(d[2]);
+
+		const double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+		const double cdxady = cdx * ady, adxcdy = adx * cdy;
+		const double adxbdy = adx * bdy, bdxady = bdx * ady;
+
+		const double determinant = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+		const double permanent   = (std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(adz)
+								 + (std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bdz)
+								 + (std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cdz);
+
+		const double bound = PredicateErrorBounds::ORIENT_3D * permanent;
+		if (determinant > bound || -determinant > bound)
+		{
+			return determinant;
+		}
+
+		return Orient3DExact(a[0], a[1], a[2], b[0], b[1], b[2], c[0], c[1], c[2], d[0], d[1], d[2]);
+	}
+}
@@ -0,0 +1,468 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+#include "Strawberry/Core/Math/Graph/CSRGraph.hpp"
+#include "Strawberry/Core/Math/Graph/Graph.hpp"
+#include "Strawberry/Core/Types/Optional.hpp"
+#include "Strawberry/Core/Util/DAryHeap.hpp"
+#include "Strawberry/Core/Util/DisjointSets.hpp"
+// Standard Library
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <vector>
+
+
+//======================================================================================================================
+//  Graph Access
+//----------------------------------------------------------------------------------------------------------------------
+// The algorithms below work on both Graph and CSRGraph through these overloads. A CSRGraph is much faster to search,
+// since its neighbours and weights are contiguous, so a graph which is searched many times should be frozen first.
+namespace Strawberry::Core::Math
+{
+	/// Returns a bound on the node IDs of graph, so that every ID is less than it.
+	template <typename Value, GraphConfig Config, typename Allocator>
+	size_t NodeIDBound(const Graph<Value, Config, Allocator>& graph)
+	{
+		size_t bound = 0;
+		for (auto node : graph.NodeIndices())
+		{
+			bound = std::max<size_t>(bound, node + 1);
+		}
+		return bound;
+	}
+
+
+	template <typename Value, GraphConfig Config>
+	size_t NodeIDBound(const CSRGraph<Value, Config>& graph)
+	{
+		return graph.NodeCount();
+	}
+
+
+	/// Calls function with each neighbour of node, and the weight of the edge to it, which is 1 for unweighted graphs.
+	/// For directed graphs, only the outgoing neighbours are visited.
+	template <typename Value, GraphConfig Config, typename Allocator, typename F>
+	void ForEachNeighbour(const Graph<Value, Config, Allocator>& graph, typename Config::NodeID node, F&& function)
+	{
+		for (auto neighbour : graph.Neighbours(node))
+		{
+			if constexpr (Config::Weighted)
+			{
+				function(neighbour, graph.GetEdge(node, neighbour).Weight());
+			}
+			else
+			{
+				function(neighbour, 1u);
+			}
+		}
+	}
+
+
+	template <typename Value, GraphConfig Config, typename F>
+	void ForEachNeighbour(const CSRGraph<Value, Config>& graph, typename Config::NodeID node, F&& function)
+	{
+		auto neighbours = graph.GetNeighbours(node);
+		for (size_t i = 0; i < neighbours.size(); i++)
+		{
+			if constexpr (Config::Weighted)
+			{
+				function(neighbours[i], graph.GetWeights(node)[i]);
+			}
+			else
+			{
+				function(neighbours[i], 1u);
+			}
+		}
+	}
+
+
+	/// Returns a range of the IDs of the nodes of graph.
+	template <typename Graph>
+	auto NodesOf(const Graph& graph)
+	{
+		return graph.NodeIndices();
+	}
+
+
+	/// Returns the edge from a to b, with its weight, which must exist.
+	template <typename Value, GraphConfig Config, typename Allocator>
+	auto EdgeBetween(const Graph<Value, Config, Allocator>& graph, typename Config::NodeID a, typename Config::NodeID b)
+	{
+		return graph.GetEdge(a, b);
+	}
+
+
+	template <typename Value, GraphConfig Config>
+	auto EdgeBetween(const CSRGraph<Value, Config>& graph, typename Config::NodeID a, typename Config::NodeID b)
+	{
+		return graph.GetEdge(a, b).Unwrap();
+	}
+}
+
+
+//======================================================================================================================
+//  Costs and Heuristics
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Core::Math
+{
+	/// Edge cost which is the weight of the edge, or 1 for unweighted graphs.
+	struct EdgeWeightCost
+	{
+		template <typename NodeID, typename Weight>
+		constexpr auto operator()(NodeID, NodeID, Weight weight) const noexcept
+		{
+			return weight;
+		}
+	};
+
+
+	/// Edge cost which is the distance between the positions of the nodes, for graphs whose values are Vectors, such as
+	/// VectorGraph or the graph of a Voronoi diagram.
+	template <typename Graph>
+	struct EuclideanCost
+	{
+		template <typename NodeID, typename Weight>
+		double operator()(NodeID a, NodeID b, Weight) const
+		{
+			return (graph.GetValue(b) - graph.GetValue(a)).Magnitude();
+		}
+
+
+		const Graph& graph;
+	};
+
+	template <typename Graph>
+	EuclideanCost(const Graph&) -> EuclideanCost<Graph>;
+
+
+	/// A* heuristic which is the straight line distance to the target. Admissible with EuclideanCost.
+	template <typename Graph>
+	struct EuclideanHeuristic
+	{
+		template <typename NodeID>
+		double operator()(NodeID node) const
+		{
+			return (graph.GetValue(target) - graph.GetValue(node)).Magnitude();
+		}
+
+
+		const Graph&           graph;
+		typename Graph::NodeID target;
+	};
+
+	template <typename Graph, typename NodeID>
+	EuclideanHeuristic(const Graph&, NodeID) -> EuclideanHeuristic<Graph>;
+}
+
+
+//======================================================================================================================
+//  Workspace
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Core::Math
+{
+	/// Scratch memory for graph searches, and their results.
+	///
+	/// The arrays are indexed by node ID, and are grown but never shrunk, so a workspace which is reused for many
+	/// searches stops allocating. Nodes are marked as reached by stamping them with a counter which is bumped for each
+	/// search, so starting a search does not clear anything. The results of a search are valid until the next search
+	/// which uses the same workspace.
+	template <typename Distance = double, std::integral NodeID = unsigned int>
+	class GraphWorkspace
+	{
+	public:
+		/// Returns whether the last search reached node.
+		[[nodiscard]] bool IsReached(NodeID node) const noexcept
+		{
+			return node < mReached.size() && mReached[node] == mStamp;
+		}
+
+
+		/// Returns whether the last search settled node, so that its distance is final.
+		[[nodiscard]] bool IsSettled(NodeID node) const noexcept
+		{
+			return node < mSettled.size() && mSettled[node] == mStamp;
+		}
+
+
+		/// Returns the distance of node from the source of the last search. For breadth first searches, this is the
+		/// number of edges on the path.
+		[[nodiscard]] Distance GetDistance(NodeID node) const noexcept
+		{
+			Assert(IsReached(node), "Asked for the distance of a node which was not reached!");
+			return mDistances[node];
+		}
+
+
+		/// Returns the node before node on the shortest path to it, or nothing for the source.
+		[[nodiscard]] Optional<NodeID> GetParent(NodeID node) const noexcept
+		{
+			Assert(IsReached(node), "Asked for the parent of a node which was not reached!");
+			if (mParents[node] == NONE) return NullOpt;
+			return mParents[node];
+		}
+
+
+		/// Returns the path from the source of the last search to target, or an empty path if it was not reached.
+		[[nodiscard]] std::vector<NodeID> GetPath(NodeID target) const
+		{
+			std::vector<NodeID> path;
+			if (!IsReached(target)) return path;
+
+			for (NodeID node = target; node != NONE; node = mParents[node])
+			{
+				path.emplace_back(node);
+			}
+			std::ranges::reverse(path);
+			return path;
+		}
+
+
+		/// Returns the nodes settled by the last search, in the order they were settled.
+		[[nodiscard]] std::span<const NodeID> Order() const noexcept
+		{
+			return mOrder;
+		}
+
+
+		/// Starts a new search over nodes with IDs less than bound.
+		void Begin(size_t bound)
+		{
+			if (mReached.size() < bound)
+			{
+				mReached.resize(bound, 0);
+				mSettled.resize(bound, 0);
+				mDistances.resize(bound);
+				mParents.resize(bound);
+			}
+
+			if (++mStamp == 0) [[unlikely]]
+			{
+				std::ranges::fill(mReached, 0);
+				std::ranges::fill(mSettled, 0);
+				mStamp = 1;
+			}
+
+			mOrder.clear();
+			mOpenSet.Clear();
+		}
+
+
+		/// Records that node can be reached from parent at distance. Returns false if it was already reached by a path
+		/// which is no longer, or if it is settled, since the distances of settled nodes are final.
+		bool Reach(NodeID node, NodeID parent, Distance distance) noexcept
+		{
+			if (mSettled[node] == mStamp) return false;
+			if (IsReached(node) && !(distance < mDistances[node])) return false;
+			mReached[node]   = mStamp;
+			mDistances[node] = distance;
+			mParents[node]   = parent;
+			return true;
+		}
+
+
+		/// Marks node as settled, so that its distance is final. Returns false if it already was.
+		bool Settle(NodeID node) noexcept
+		{
+			if (mSettled[node] == mStamp) return false;
+			mSettled[node] = mStamp;
+			mOrder.emplace_back(node);
+			return true;
+		}
+
+
+		/// Entry in the open set of a best first search. Entries are never updated, but pushed again when a shorter path
+		/// is found, and the stale ones are skipped when they are popped.
+		struct OpenEntry
+		{
+			Distance priority;
+			NodeID   node;
+
+
+			bool operator<(const OpenEntry& other) const noexcept { return priority < other.priority; }
+		};
+
+
+		using EdgeEntry = std::tuple<Distance, NodeID, NodeID>;
+
+
+		/// Scratch for the algorithms, which is cleared by Begin or by the algorithm using it.
+		DAryHeap<OpenEntry>&                         OpenSet() noexcept { return mOpenSet; }
+		DisjointSets<std::make_unsigned_t<NodeID>>& Sets() noexcept { return mSets; }
+		std::vector<EdgeEntry>&                      Edges() noexcept { return mEdges; }
+
+
+		static constexpr NodeID NONE = std::numeric_limits<NodeID>::max();
+
+
+	private:
+		uint32_t                                   mStamp = 0;
+		std::vector<uint32_t>                      mReached;
+		std::vector<uint32_t>                      mSettled;
+		std::vector<Distance>                      mDistances;
+		std::vector<NodeID>                        mParents;
+		std::vector<NodeID>                        mOrder;
+		DAryHeap<OpenEntry>                        mOpenSet;
+		DisjointSets<std::make_unsigned_t<NodeID>> mSets;
+		std::vector<EdgeEntry>                     mEdges;
+	};
+}
+
+
+//======================================================================================================================
+//  Algorithms
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Core::Math
+{
+	/// Visits every node reachable from source in breadth first order. Afterwards workspace holds the order the nodes
+	/// were visited in, and for each one the number of edges on the shortest path to it, and its parent on that path.
+	template <typename Graph, typename Distance, typename NodeID>
+	std::span<const NodeID> BreadthFirst(const Graph& graph, NodeID source, GraphWorkspace<Distance, NodeID>& workspace)
+	{
+		workspace.Begin(NodeIDBound(graph));
+		Assert(graph.ContainsNode(source), "Searched from a node which is not in the graph!");
+		workspace.Reach(source, workspace.NONE, Distance(0));
+		workspace.Settle(source);
+
+		// The order doubles as the queue, since nodes are settled in the order they are reached.
+		for (size_t i = 0; i < workspace.Order().size(); i++)
+		{
+			const NodeID   node     = workspace.Order()[i];
+			const Distance distance = workspace.GetDistance(node) + Distance(1);
+			ForEachNeighbour(graph, node, [&] (NodeID neighbour, auto)
+			{
+				if (!workspace.IsReached(neighbour))
+				{
+					workspace.Reach(neighbour, node, distance);
+					workspace.Settle(neighbour);
+				}
+			});
+		}
+
+		return workspace.Order();
+	}
+
+
+	/// Shared implementation of Dijkstra and A*. Stops early once target is settled, if there is one.
+	///
+	/// Settled nodes are never opened again, which is only exact when the heuristic is consistent. Debug builds assert
+	/// that no shorter path to a settled node is found.
+	template <typename Graph, typename Heuristic, typename Cost, typename Distance, typename NodeID>
+	bool BestFirst(const Graph& graph, NodeID source, Optional<NodeID> target, Heuristic&& heuristic, GraphWorkspace<Distance, NodeID>& workspace, Cost&& cost)
+	{
+		workspace.Begin(NodeIDBound(graph));
+		Assert(graph.ContainsNode(source), "Searched from a node which is not in the graph!");
+		workspace.Reach(source, workspace.NONE, Distance(0));
+		workspace.OpenSet().Emplace(Distance(heuristic(source)), source);
+
+		while (!workspace.OpenSet().IsEmpty())
+		{
+			const NodeID node = workspace.OpenSet().Pop().node;
+			if (!workspace.Settle(node)) continue;
+			if (target.HasValue() && *target == node) return true;
+
+			const Distance distance = workspace.GetDistance(node);
+			ForEachNeighbour(graph, node, [&] (NodeID neighbour, auto weight)
+			{
+				const Distance edgeCost = Distance(cost(node, neighbour, weight));
+				Assert(!(edgeCost < Distance(0)), "Graph searches require edge costs which are not negative!");
+				Assert(!workspace.IsSettled(neighbour) || !(distance + edgeCost < workspace.GetDistance(neighbour)),
+					"A* requires a heuristic which is consistent!");
+				if (workspace.Reach(neighbour, node, distance + edgeCost))
+				{
+					workspace.OpenSet().Emplace(distance + edgeCost + Distance(heuristic(neighbour)), neighbour);
+				}
+			});
+		}
+
+		return !target.HasValue();
+	}
+
+
+	/// Finds the shortest paths from source to every node reachable from it, using a 4-ary heap.
+	///
+	/// Costs default to the weights of the edges, or 1 for unweighted graphs, and must not be negative.
+	template <typename Graph, typename Distance, typename NodeID, typename Cost = EdgeWeightCost>
+	void Dijkstra(const Graph& graph, NodeID source, GraphWorkspace<Distance, NodeID>& workspace, Cost&& cost = {})
+	{
+		BestFirst(graph, source, Optional<NodeID>(), [] (NodeID) { return Distance(0); }, workspace, std::forward<Cost>(cost));
+	}
+
+
+	/// Finds the shortest path from source to target, expanding nodes in order of their distance from source plus the
+	/// heuristic's estimate of their distance to target.
+	///
+	/// The heuristic must be consistent: for every edge from a to b, heuristic(a) is at most the edge's cost plus
+	/// heuristic(b). Nodes are not expanded again once settled, so with a heuristic which is only admissible the path
+	/// may not be the shortest. Straight line distances, such as EuclideanHeuristic with EuclideanCost, are consistent.
+	///
+	/// @returns Whether target was reached. If so, workspace.GetPath(target) is the path.
+	template <typename Graph, typename Heuristic, typename Distance, typename NodeID, typename Cost = EdgeWeightCost>
+	bool AStar(const Graph& graph, NodeID source, NodeID target, Heuristic&& heuristic, GraphWorkspace<Distance, NodeID>& workspace, Cost&& cost = {})
+	{
+		return BestFirst(graph, source, Optional<NodeID>(target), std::forward<Heuristic>(heuristic), workspace, std::forward<Cost>(cost));
+	}
+
+
+	/// Labels each node with the index of its connected component, from 0. For directed graphs, these are the weakly
+	/// connected components. Labels of IDs which are not in the graph are GraphWorkspace::NONE.
+	///
+	/// @returns The number of components.
+	template <typename Graph, typename Distance, typename NodeID>
+	size_t ConnectedComponents(const Graph& graph, GraphWorkspace<Distance, NodeID>& workspace, std::vector<NodeID>& labels)
+	{
+		const size_t bound = NodeIDBound(graph);
+		auto&        sets  = workspace.Sets();
+		sets.Reset(bound);
+		for (auto node : NodesOf(graph))
+		{
+			ForEachNeighbour(graph, node, [&] (NodeID neighbour, auto) { sets.Union(node, neighbour); });
+		}
+
+		// Label each root the first time its component is seen, so that components are numbered in order of their
+		// lowest node. A root's label is only ever set to the label of its own component, so labelling the root
+		// itself later leaves it unchanged.
+		labels.assign(bound, workspace.NONE);
+		size_t count = 0;
+		for (auto node : NodesOf(graph))
+		{
+			NodeID& label = labels[sets.Find(node)];
+			if (label == workspace.NONE) label = static_cast<NodeID>(count++);
+			labels[node] = label;
+		}
+		return count;
+	}
+
+
+	/// Returns the edges of a minimum spanning forest of an undirected graph, found with Kruskal's algorithm.
+	///
+	/// Costs default to the weights of the edges, or 1 for unweighted graphs.
+	template <typename Graph, typename Distance, typename NodeID, typename Cost = EdgeWeightCost>
+	std::vector<typename Graph::Edge> MinimumSpanningTree(const Graph& graph, GraphWorkspace<Distance, NodeID>& workspace, Cost&& cost = {})
+		requires (!Graph::Config::Directed)
+	{
+		auto& edges = workspace.Edges();
+		edges.clear();
+		for (auto node : NodesOf(graph))
+		{
+			ForEachNeighbour(graph, node, [&] (NodeID neighbour, auto weight)
+			{
+				// Each undirected edge is visited from both ends.
+				if (node < neighbour) edges.emplace_back(Distance(cost(node, neighbour, weight)), node, neighbour);
+			});
+		}
+		std::ranges::sort(edges);
+
+		auto& sets = workspace.Sets();
+		sets.Reset(NodeIDBound(graph));
+		std::vector<typename Graph::Edge> tree;
+		for (const auto& [edgeCost, a, b] : edges)
+		{
+			if (sets.Union(a, b)) tree.emplace_back(EdgeBetween(graph, a, b));
+		}
+		return tree;
+	}
+}
@@ -0,0 +1,335 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+#include "Strawberry/Core/Math/Graph/Graph.hpp"
+#include "Strawberry/Core/Types/Optional.hpp"
+// Standard Library
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <variant>
+#include <vector>
+
+
+namespace Strawberry::Core::Math
+{
+	/// The type of an edge's weight, or std::monostate for unweighted graphs.
+	template <GraphConfig Config>
+	struct GraphWeight
+	{
+		using Type = std::monostate;
+	};
+
+
+	template <GraphConfig Config> requires (Config::Weighted)
+	struct GraphWeight<Config>
+	{
+		using Type = Config::WeightType;
+	};
+
+
+	/// Immutable graph in compressed sparse row form, frozen from a Graph or built from a list of edges.
+	///
+	/// The neighbours of every node are stored back to back in one array, sorted, and each node's neighbours are found
+	/// through an array of offsets into it, so neighbour queries return spans without allocating, degrees and the edge
+	/// count are O(1), and traversals walk contiguous memory. Weights are kept in an array parallel to the neighbours.
+	/// Directed graphs also store the transpose, for incoming neighbours.
+	///
+	/// Nodes are renumbered densely from 0 in order of their ID in the source graph, so the IDs only match if no nodes
+	/// had been removed from it. OriginalID and FindNode translate between the two.
+	template <typename _value, GraphConfig _config>
+	class CSRGraph
+	{
+	public:
+		using Value  = _value;
+		using Config = _config;
+		using NodeID = Config::NodeID;
+		using Edge   = Edge<Config>;
+		using Weight = GraphWeight<Config>::Type;
+
+
+		CSRGraph() = default;
+
+
+		template <typename Allocator>
+		explicit CSRGraph(const Graph<Value, Config, Allocator>& graph)
+		{
+			for (auto id : graph.NodeIndices())
+			{
+				mOriginalIDs.emplace_back(static_cast<NodeID>(id));
+			}
+			std::ranges::sort(mOriginalIDs);
+
+			NodeID greatestID = mOriginalIDs.empty() ? 0 : mOriginalIDs.back();
+			mIndexOfID.assign(static_cast<size_t>(greatestID) + 1, NONE);
+			mValues.reserve(mOriginalIDs.size());
+			for (NodeID node = 0; node < mOriginalIDs.size(); node++)
+			{
+				mIndexOfID[mOriginalIDs[node]] = node;
+				mValues.emplace_back(graph.GetValue(mOriginalIDs[node]));
+			}
+
+			// Neighbour sets are ordered by ID, and renumbering preserves that order, so each row comes out sorted.
+			mOffsets.reserve(mOriginalIDs.size() + 1);
+			mOffsets.emplace_back(0);
+			for (NodeID node = 0; node < mOriginalIDs.size(); node++)
+			{
+				for (auto neighbour : graph.Neighbours(mOriginalIDs[node]))
+				{
+					mNeighbours.emplace_back(mIndexOfID[neighbour]);
+					if constexpr (Config::Weighted)
+					{
+						mWeights.emplace_back(graph.GetEdge(mOriginalIDs[node], neighbour).Weight());
+					}
+				}
+				mOffsets.emplace_back(mNeighbours.size());
+			}
+
+			if constexpr (Config::Directed)
+			{
+				BuildTranspose();
+			}
+		}
+
+
+		/// Builds a graph directly from a list of edges, where node i has the value values[i]. This avoids building a
+		/// Graph first, which is slow for large graphs. Repeated edges are only kept once, with the first weight given.
+		CSRGraph(std::vector<Value> values, std::span<const Edge> edges)
+			: mValues(std::move(values))
+		{
+			mOriginalIDs.resize(mValues.size());
+			std::iota(mOriginalIDs.begin(), mOriginalIDs.end(), NodeID(0));
+			mIndexOfID = mOriginalIDs;
+
+			// Bucket the edges by their source with a counting sort, then sort and deduplicate each row.
+			std::vector<size_t> counts(mValues.size() + 1, 0);
+			for (const auto& edge : edges)
+			{
+				Assert(edge.A() < NodeCount() && edge.B() < NodeCount(), "Edge refers to a node which does not exist!");
+				counts[edge.A() + 1]++;
+				if constexpr (!Config::Directed) counts[edge.B() + 1]++;
+			}
+			std::partial_sum(counts.begin(), counts.end(), counts.begin());
+
+			std::vector<std::pair<NodeID, Weight>> entries(counts.back());
+			std::vector<size_t>                    cursor(counts.begin(), std::prev(counts.end()));
+			for (const auto& edge : edges)
+			{
+				Weight weight{};
+				if constexpr (Config::Weighted) weight = edge.Weight();
+				entries[cursor[edge.A()]++] = {edge.B(), weight};
+				if constexpr (!Config::Directed) entries[cursor[edge.B()]++] = {edge.A(), weight};
+			}
+
+			mOffsets.reserve(mValues.size() + 1);
+			mOffsets.emplace_back(0);
+			mNeighbours.reserve(entries.size());
+			for (NodeID node = 0; node < NodeCount(); node++)
+			{
+				auto row = std::span(entries).subspan(counts[node], counts[node + 1] - counts[node]);
+				std::ranges::stable_sort(row, std::less{}, &std::pair<NodeID, Weight>::first);
+				for (size_t i = 0; i < row.size(); i++)
+				{
+					if (i > 0 && row[i].first == row[i - 1].first) continue;
+					mNeighbours.emplace_back(row[i].first);
+					if constexpr (Config::Weighted) mWeights.emplace_back(row[i].second);
+				}
+				mOffsets.emplace_back(mNeighbours.size());
+			}
+
+			if constexpr (Config::Directed)
+			{
+				BuildTranspose();
+			}
+		}
+
+
+		[[nodiscard]] NodeID NodeCount() const noexcept
+		{
+			return static_cast<NodeID>(mValues.size());
+		}
+
+
+		[[nodiscard]] bool ContainsNode(NodeID node) const noexcept
+		{
+			return node < NodeCount();
+		}
+
+
+		[[nodiscard]] size_t EdgeCount() const noexcept
+		{
+			// Undirected edges are stored in both directions.
+			return Config::Directed ? mNeighbours.size() : mNeighbours.size() / 2;
+		}
+
+
+		[[nodiscard]] const Value& GetValue(NodeID node) const
+		{
+			return mValues[node];
+		}
+
+
+		[[nodiscard]] std::span<const Value> Values() const noexcept
+		{
+			return mValues;
+		}
+
+
+		[[nodiscard]] auto NodeIndices() const noexcept
+		{
+			return std::views::iota(NodeID(0), NodeCount());
+		}
+
+
+		/// Returns the ID that node had in the graph this was frozen from.
+		[[nodiscard]] NodeID OriginalID(NodeID node) const
+		{
+			return mOriginalIDs[node];
+		}
+
+
+		/// Returns the node with the given ID in the graph this was frozen from.
+		[[nodiscard]] Optional<NodeID> FindNode(NodeID originalID) const noexcept
+		{
+			if (originalID < mIndexOfID.size() && mIndexOfID[originalID] != NONE) return mIndexOfID[originalID];
+			return NullOpt;
+		}
+
+
+		/// Returns the number of neighbours of node. For directed graphs, this is the out degree.
+		[[nodiscard]] size_t Degree(NodeID node) const
+		{
+			return mOffsets[node + 1] - mOffsets[node];
+		}
+
+
+		[[nodiscard]] size_t OutDegree(NodeID node) const requires (Config::Directed)
+		{
+			return Degree(node);
+		}
+
+
+		[[nodiscard]] size_t InDegree(NodeID node) const requires (Config::Directed)
+		{
+			return mIncomingOffsets[node + 1] - mIncomingOffsets[node];
+		}
+
+
+		/// Returns the neighbours of node in ascending order. For directed graphs, these are the outgoing neighbours.
+		[[nodiscard]] std::span<const NodeID> GetNeighbours(NodeID node) const
+		{
+			return std::span(mNeighbours).subspan(mOffsets[node], Degree(node));
+		}
+
+
+		[[nodiscard]] std::span<const NodeID> GetOutgoingNeighbours(NodeID node) const requires (Config::Directed)
+		{
+			return GetNeighbours(node);
+		}
+
+
+		[[nodiscard]] std::span<const NodeID> GetIncomingNeighbours(NodeID node) const requires (Config::Directed)
+		{
+			return std::span(mIncoming).subspan(mIncomingOffsets[node], InDegree(node));
+		}
+
+
+		/// Returns the weights of the edges to the neighbours of node, in the same order as GetNeighbours.
+		[[nodiscard]] std::span<const Weight> GetWeights(NodeID node) const requires (Config::Weighted)
+		{
+			return std::span(mWeights).subspan(mOffsets[node], Degree(node));
+		}
+
+
+		[[nodiscard]] bool IsConnected(NodeID a, NodeID b) const
+		{
+			return std::ranges::binary_search(GetNeighbours(a), b);
+		}
+
+
+		[[nodiscard]] Optional<Edge> GetEdge(NodeID a, NodeID b) const
+		{
+			auto neighbours = GetNeighbours(a);
+			auto neighbour  = std::ranges::lower_bound(neighbours, b);
+			if (neighbour == neighbours.end() || *neighbour != b) return NullOpt;
+			return MakeEdge(a, mOffsets[a] + std::distance(neighbours.begin(), neighbour));
+		}
+
+
+		/// Returns a view of every edge, without materialising them. Undirected edges are visited once.
+		[[nodiscard]] auto Edges() const noexcept
+		{
+			return NodeIndices()
+				| std::views::transform([this] (NodeID a)
+				{
+					return std::views::iota(mOffsets[a], mOffsets[a + 1])
+						| std::views::filter([this, a] (size_t e) { return Config::Directed || a < mNeighbours[e]; })
+						| std::views::transform([this, a] (size_t e) { return MakeEdge(a, e); });
+				})
+				| std::views::join;
+		}
+
+
+	private:
+		static constexpr NodeID NONE = std::numeric_limits<NodeID>::max();
+
+
+		Edge MakeEdge(NodeID a, size_t e) const
+		{
+			if constexpr (Config::Weighted)
+			{
+				return Edge(a, mNeighbours[e], mWeights[e]);
+			}
+			else
+			{
+				return Edge(a, mNeighbours[e]);
+			}
+		}
+
+
+		/// Builds the incoming neighbours with a counting sort of the outgoing ones. Sources are visited in ascending
+		/// order, so each row of the transpose comes out sorted too.
+		void BuildTranspose()
+		{
+			mIncomingOffsets.assign(NodeCount() + 1, 0);
+			for (NodeID target : mNeighbours)
+			{
+				mIncomingOffsets[target + 1]++;
+			}
+			for (NodeID node = 0; node < NodeCount(); node++)
+			{
+				mIncomingOffsets[node + 1] += mIncomingOffsets[node];
+			}
+
+			std::vector<size_t> cursor(mIncomingOffsets.begin(), std::prev(mIncomingOffsets.end()));
+			mIncoming.resize(mNeighbours.size());
+			for (NodeID source = 0; source < NodeCount(); source++)
+			{
+				for (NodeID target : GetNeighbours(source))
+				{
+					mIncoming[cursor[target]++] = source;
+				}
+			}
+		}
+
+
+		std::vector<Value>  mValues;
+		std::vector<NodeID> mOriginalIDs;
+		/// The dense index of each original ID, or NONE for IDs which were not in the graph.
+		std::vector<NodeID> mIndexOfID;
+		/// The neighbours of node i are mNeighbours[mOffsets[i]] up to mNeighbours[mOffsets[i + 1]].
+		std::vector<size_t> mOffsets;
+		std::vector<NodeID> mNeighbours;
+		/// The weight of each entry in mNeighbours. Empty for unweighted graphs.
+		std::vector<Weight> mWeights;
+		/// The transpose of mOffsets and mNeighbours, for directed graphs.
+		std::vector<size_t> mIncomingOffsets;
+		std::vector<NodeID> mIncoming;
+	};
+
+
+	template <typename Value, GraphConfig Config, typename Allocator>
+	CSRGraph(const Graph<Value, Config, Allocator>&) -> CSRGraph<Value, Config>;
+}
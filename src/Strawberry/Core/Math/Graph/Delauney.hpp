@@ -1,15 +1,28 @@
 #pragma once
 // Strawberry Core
 #include "Strawberry/Core/Math/Geometry/ConvexPolygon.hpp"
+#include "Strawberry/Core/Math/Geometry/Predicates.hpp"
 #include "Strawberry/Core/Math/Geometry/Simplex.hpp"
 #include "Strawberry/Core/Math/Geometry/Sphere.hpp"
 #include "Strawberry/Core/Math/Graph/Graph.hpp"
-#include "Strawberry/Core/Math/Graph/GraphWalker.hpp"
+#include "Strawberry/Core/Math/Graph/HalfEdgeMesh.hpp"
 #include "Strawberry/Core/Math/Vector.hpp"
+#include "Strawberry/Core/Thread/ThreadPool.hpp"
+#include "Strawberry/Core/Util/Arena.hpp"
 // Standard library
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <memory_resource>
+#include <numeric>
+#include <random>
 #include <ranges>
+#include <span>
 
 
 namespace Strawberry::Core::Math
@@ -17,6 +30,9 @@ namespace Strawberry::Core::Math
 	template <typename T, unsigned int D>
 	class PointSet;
 
+	template <typename T>
+	class LloydRelaxation;
+
 
 	/// Base Template.
 	template <typename T>
@@ -32,6 +48,8 @@ namespace Strawberry::Core::Math
 		using Value = Graph::Value;
 		using Edge = Graph::Edge;
 		using NodeID = Graph::NodeID;
+		/// Half edge mesh of the triangulation, whose vertices are indexed by NodeID.
+		using Mesh = HalfEdgeMesh<Vector<T, 2>, NodeID>;
 
 
 		/// Struct for the triangular faces represented in this graph.
@@ -41,6 +59,8 @@ namespace Strawberry::Core::Math
 		/// Builder type and friend declaration.
 		class Builder;
 		friend class Builder;
+		/// Lloyd relaxation keeps a triangulation of its own between iterations, using the builder's internals.
+		template <typename> friend class LloydRelaxation;
 
 		const auto& GetBoundingBox() const noexcept { return mBoundingBox; }
 
@@ -72,88 +92,73 @@ namespace Strawberry::Core::Math
 			return GetFaceAsTriangle(face).GetCircumsphere().Unwrap().Center();
 		}
 
+		/// The triangulation as a half edge mesh, with a counter clockwise face for each of Faces(), in the same order.
+		/// The three supporting vertices which the triangulation was built around are kept as vertices without edges.
+		const Mesh& GetMesh() const noexcept { return mMesh; }
+
+		/// Returns the index in GetMesh() of the given face, if it is in the triangulation.
+		Optional<NodeID> FindMeshFace(const Face& face) const
+		{
+			auto halfEdge = mMesh.FindHalfEdge(face.Node(0), face.Node(1));
+			if (!halfEdge) return NullOpt;
+
+			for (NodeID side : {*halfEdge, mMesh.Twin(*halfEdge)})
+			{
+				if (!mMesh.IsBoundary(side) && mMesh.Origin(mMesh.Prev(side)) == face.Node(2)) return mMesh.Face(side);
+			}
+			return NullOpt;
+		}
+
+		/// Returns the face with the given index in GetMesh().
+		Face GetMeshFace(NodeID meshFace) const
+		{
+			NodeID halfEdge = mMesh.FaceHalfEdge(meshFace);
+			return Face(mMesh.Origin(halfEdge), mMesh.Origin(mMesh.Next(halfEdge)), mMesh.Origin(mMesh.Prev(halfEdge)));
+		}
+
+		/// Returns the centre of the circle through the vertices of the given face of GetMesh().
+		Vector<T, 2> GetMeshFaceCircumcenter(NodeID meshFace) const
+		{
+			NodeID halfEdge = mMesh.FaceHalfEdge(meshFace);
+			return MakeCircumcircle(
+				mMesh.GetValue(mMesh.Origin(halfEdge)),
+				mMesh.GetValue(mMesh.Origin(mMesh.Next(halfEdge))),
+				mMesh.GetValue(mMesh.Origin(mMesh.Prev(halfEdge)))).center;
+		}
+
 		/// Returns the faces that are adjacent to the given face.
 		std::set<Face> GetAdjacentFaces(const Face& face) const noexcept
 		{
-			return mFaces
-				| std::views::filter([face] (const Face& otherFace) {
-					return face != otherFace && face.SharesEdgeWith(otherFace); })
-				| std::ranges::to<std::set>();
+			std::set<Face> adjacentFaces;
+			if (auto meshFace = FindMeshFace(face))
+			{
+				mMesh.ForEachAdjacentFace(*meshFace, [&] (NodeID other) { adjacentFaces.emplace(GetMeshFace(other)); });
+			}
+			return adjacentFaces;
 		}
 
 		/// Looks for the faces on either side of this edge.
 		std::vector<Face> FindFacesWithEdge(Edge edge) const
 		{
-			// Type for vector path walkers.
-			using WalkerType = VectorGraphWalker<PathGraphWalker<BasicGraphWalker<Graph>>>;
-			// Create two walkers on each side of the edge.
-			WalkerType walkers[2] {
-				WalkerType(mGraph, edge.A()),
-				WalkerType(mGraph, edge.B())
-			};
-
-			// Have the walkers swap places so that they
-			// end up going in opposite directions.
-			walkers[0].WalkTo(edge.B());
-			walkers[1].WalkTo(edge.A());
-
 			std::vector<Face> faces;
-			// Do for each walker
-			for (auto& walker : walkers)
+			if (auto halfEdge = mMesh.FindHalfEdge(edge.A(), edge.B()))
 			{
-				// Keep trying to walk counter-clockwise until we can't.
-				while (walker.TryWalkCCW())
+				for (NodeID side : {*halfEdge, mMesh.Twin(*halfEdge)})
 				{
-					// We never let the path exceed 4 nodes.
-					Assert(walker.PathLength() <= 4);
-					// If the path is at the length to encapsulate a triangle.
-					if (walker.PathLength() == 4)
-					{
-						// If our first and current node are the same, we've walked a triangle.
-						if (walker.CurrentNode() == walker.GetPreviousNode(walker.PathLength() - 1))
-						{
-							/// Create the new face.
-							Face face(
-								walker.GetPreviousNode(0),
-								walker.GetPreviousNode(1),
-								walker.GetPreviousNode(2));
-							/// Put the face in our set.
-							faces.emplace_back(face);
-						}
-						// No need to keep going now.
-						break;
-					}
+					if (!mMesh.IsBoundary(side)) faces.emplace_back(GetMeshFace(mMesh.Face(side)));
 				}
 			}
-
-			// A valid triangulation edge cannot be shared by more than 2 faces.
-			Assert(faces.size() <= 2);
-
-			// It's possible to have the same face twice so we check here.
-			if (faces.size() == 2 && faces[0] == faces[1])
-			{
-				faces.pop_back();
-			}
-
 			return faces;
 		}
 
-		/// Get the edges on the outside of the triangulation;
+		/// Get the edges on the outside of the triangulation, which are those with a face on at most one side.
 		std::set<Edge> GetOuterEdges() const noexcept
 		{
 			std::set<Edge> outerEdges;
 			for (const auto& edge : mGraph.Edges())
 			{
-				unsigned int containingFaces = 0;
-				for (const auto& face : mFaces)
-				{
-					if (face.ContainsEdge(edge))
-					{
-						containingFaces++;
-					}
-				}
-
-				if (containingFaces <= 1)
+				auto halfEdge = mMesh.FindHalfEdge(edge.A(), edge.B());
+				if (!halfEdge || mMesh.IsBoundaryEdge(*halfEdge))
 				{
 					outerEdges.emplace(edge);
 				}
@@ -167,12 +172,38 @@ namespace Strawberry::Core::Math
 		Delaunay() = default;
 
 
+		struct Circumcircle
+		{
+			Vector<T, 2> center;
+			T            radiusSquared;
+		};
+
+
+		/// Returns the circumcircle of the triangle abc. Degenerate triangles get an infinite circle.
+		static Circumcircle MakeCircumcircle(const Vector<T, 2>& a, const Vector<T, 2>& b, const Vector<T, 2>& c) noexcept
+		{
+			const Vector<T, 2> ab = b - a, ac = c - a;
+			const T denominator = 2 * ab.DotPerp(ac);
+			if (denominator == 0)
+			{
+				return Circumcircle{a, std::numeric_limits<T>::infinity()};
+			}
+
+			const T abSquared = ab.SquareMagnitude(), acSquared = ac.SquareMagnitude();
+			const Vector<T, 2> offset((ac[1] * abSquared - ab[1] * acSquared) / denominator,
+									  (ab[0] * acSquared - ac[0] * abSquared) / denominator);
+			return Circumcircle{a + offset, offset.SquareMagnitude()};
+		}
+
+
 		/// The bounding box of this graph.
 		AABB<T, 2> mBoundingBox;
 		/// The graph of the Delaunay triangulation.
 		UndirectedVectorGraph<Vector<T, 2>> mGraph;
 		/// The set of triangular faces contained in this graph.
 		std::set<Face> mFaces;
+		/// The faces and edges as a half edge mesh. Only built once the triangulation is complete.
+		Mesh mMesh;
 	};
 
 
@@ -257,255 +288,839 @@ namespace Strawberry::Core::Math
 
 
 	/// Class for creating Delaunay Triangulations.
+	///
+	/// The nodes are triangulated when the builder is built, with the Bowyer-Watson algorithm. The triangle containing
+	/// each new point is found by walking from the last triangle made, the triangles whose circumcircles contain the
+	/// point are found by searching outwards from it through their neighbours, and are replaced by a fan of triangles
+	/// around the point. Both tests use the exact predicates Orient2D and InCircle, so nearly cocircular or collinear
+	/// points cannot leave the triangulation inconsistent.
+	///
+	/// Points are inserted in a biased randomised insertion order: they are shuffled into rounds which double in size,
+	/// and each round is sorted along a Hilbert curve, so each walk is short while the triangulation stays well shaped.
+	/// This makes triangulating n points O(n log n) in expectation.
+	///
+	/// BuildParallel splits the points into vertical strips which are triangulated at the same time. A triangle whose
+	/// circumcircle lies inside its strip can have no point of another strip inside it, so it is part of the whole
+	/// triangulation. The points of the remaining triangles, along the seams between the strips, are then triangulated
+	/// together to fill the gaps.
 	template <typename T>
 	class Delaunay<Vector<T, 2>>::Builder
 	{
+		template <typename> friend class LloydRelaxation;
+
 	public:
 		/// Create a builder with the given AABB extent.
 		Builder(const AABB<T, 2> boundingBox)
 			: mBoundingBox(boundingBox)
 			, mClampingBox(CreateNodeClampingBox())
 		{
-			auto span = boundingBox.Span();;
-
-			// Store min and max;
-			mResult.mBoundingBox = mBoundingBox;
-			// Create the supporting nodes.
-			mResult.mGraph.AddNode(boundingBox.Min());
-			mResult.mGraph.AddNode(Vector{boundingBox.Min()[0] + 2 * span[0], boundingBox.Min()[1]});
-			mResult.mGraph.AddNode(Vector{boundingBox.Min()[0], boundingBox.Min()[1] + 2 * span[1]});
-			// Create the edges between supporting nodes.
-			mResult.mGraph.AddEdge({0, 1});
-			mResult.mGraph.AddEdge({1, 2});
-			mResult.mGraph.AddEdge({2, 0});
-			// Create the faces between supporting nodes.
-			mResult.mFaces.emplace(Face{0, 1, 2});
-			Validate();
+			// Create the supporting nodes, which make a triangle around the bounding box.
+			mPoints.resize(3);
+			PlaceSupportingNodes(mPoints, SUPPORT_DISTANCE);
+		}
+
+
+		/// Allocates the temporary containers of Build from arena, and rewinds it afterwards, instead of allocating
+		/// them from the heap.
+		Builder&& WithScratchArena(Arena& arena)
+		{
+			mScratchArena = &arena;
+			return std::move(*this);
 		}
 
 
 		/// Adds a node to this triangulation.
 		Builder&& AddNode(Vector<T, 2> value)
+		{
+			mPoints.emplace_back(mClampingBox.Clamp(value));
+			return std::move(*this);
+		}
+
+
+		/// Adds each of the nodes in range to this triangulation.
+		template <std::ranges::range Range>
+		Builder&& WithNodes(Range&& range)
+		{
+			for (const auto& x : std::forward<Range>(range))
+			{
+				AddNode(x);
+			}
+			return std::move(*this);
+		}
+
+
+		/// Triangulates the nodes, which are given IDs in the order they were added, and returns the graph with the
+		/// supporting nodes removed.
+		Delaunay Build() const noexcept
 		{
 			ZoneScoped;
 
-			Assert(!mResult.mGraph.ContainsValue(value),
-				   "Attempted to add duplicate node to Delaunay graph.");
+			Optional<Arena::Scope> scratchScope;
+			std::pmr::memory_resource* scratch = std::pmr::new_delete_resource();
+			if (mScratchArena)
+			{
+				scratchScope.Emplace(*mScratchArena);
+				scratch = mScratchArena;
+			}
 
-			value = mClampingBox.Clamp(value);
+			std::vector<Vector<T, 2>> movedPoints;
+			const Triangulation triangulation = Triangulate(std::views::iota(NodeID(3), static_cast<NodeID>(mPoints.size())), movedPoints, scratch);
+			return Assemble(triangulation.Triangles() | std::views::transform(&Triangle::nodes));
+		}
 
-			/// Get the set of faces that conflic with the value being added.
-			std::set conflictingFaces = GetConflictingFaces(value);
-			/// Get the set of edges that are shared by 2 of these conflicting faces.
-			std::set innerEdges       = GetInnerEdges(conflictingFaces);
-			/// The set of edges nodes defining the face of the created by
-			/// the deletion of the inner edges.
-			/// I.e. the hole torn in the graph.
-			std::set outerNodes       = GetOuterNodes(conflictingFaces);
 
-			/// Add the new node to the graph.
-			unsigned int newNodeHandle = mResult.mGraph.AddNode(value);
+		/// Triangulates the nodes like Build, splitting them into partitionCount strips which are triangulated on the
+		/// threads of pool. A partitionCount of 0 gives one strip to each thread of the pool and one to the calling
+		/// thread, which works alongside them.
+		///
+		/// The Delaunay triangulation of points in general position is unique, and ties between cocircular points are
+		/// broken by their IDs alone, so the result is the same as Build's.
+		Delaunay BuildParallel(ThreadPool& pool, unsigned int partitionCount = 0) const noexcept
+		{
+			ZoneScoped;
+
+			const size_t nodeCount = mPoints.size() - 3;
+			if (partitionCount == 0) partitionCount = pool.ThreadCount() + 1;
+			partitionCount = std::clamp<size_t>(partitionCount, 1, std::max<size_t>(1, nodeCount));
 
-			/// Erase the conflicting faces.
-			for (Face face : conflictingFaces)
+			// Each strip gets an equal share of the nodes, in order of x.
+			std::vector<NodeID> nodes(nodeCount);
+			std::iota(nodes.begin(), nodes.end(), NodeID(3));
+			std::ranges::sort(nodes, [&] (NodeID a, NodeID b) { return std::pair(mPoints[a][0], a) < std::pair(mPoints[b][0], b); });
+
+			std::vector<Partition> partitions(partitionCount);
+			pool.ParallelFor(std::views::iota(size_t(0), size_t(partitionCount)), [&] (size_t i)
+			{
+				const size_t first = i * nodeCount / partitionCount, last = (i + 1) * nodeCount / partitionCount;
+				const T left  = i == 0 ? -std::numeric_limits<T>::infinity() : mPoints[nodes[first]][0];
+				const T right = i + 1 == partitionCount ? std::numeric_limits<T>::infinity() : mPoints[nodes[last]][0];
+				partitions[i] = TriangulatePartition(std::span(nodes).subspan(first, last - first), left, right);
+			}, 1);
+
+			std::vector<std::array<NodeID, 3>> triangles;
+			std::vector<std::pair<NodeID, NodeID>> seamEdges;
+			std::vector<NodeID> seamNodes;
+			for (const Partition& partition : partitions)
 			{
-				mResult.mFaces.erase(face);
-				mTriangleCache.erase(face);
-				mCircumsphereCache.erase(face);
+				triangles.insert(triangles.end(), partition.keptTriangles.begin(), partition.keptTriangles.end());
+				seamEdges.insert(seamEdges.end(), partition.seamEdges.begin(), partition.seamEdges.end());
+				seamNodes.insert(seamNodes.end(), partition.seamNodes.begin(), partition.seamNodes.end());
 			}
+			std::ranges::sort(seamEdges);
+
+			std::vector<Vector<T, 2>> movedPoints;
+			const Triangulation seam = Triangulate(seamNodes, movedPoints, std::pmr::new_delete_resource());
 
-			/// Erase the innerEdges fo the conflicting faces.
-			for (Edge innerEdge : innerEdges)
+			// The gaps are filled by the triangles of the seam which can be reached from the far side of an edge of a
+			// kept triangle, without crossing another. Without kept triangles, the seam holds every node.
+			const auto& seamTriangles = seam.Triangles();
+			auto facesKeptTriangle = [&] (NodeID a, NodeID b) { return std::ranges::binary_search(seamEdges, std::pair(b, a)); };
+
+			std::vector<bool> filling(seamTriangles.size(), triangles.empty());
+			std::vector<NodeID> frontier;
+			for (NodeID triangle = 0; triangle < seamTriangles.size(); triangle++)
 			{
-				mResult.mGraph.RemoveEdge(innerEdge);
+				const auto& triangleNodes = seamTriangles[triangle].nodes;
+				for (unsigned int i = 0; i < 3 && !filling[triangle]; i++)
+				{
+					if (facesKeptTriangle(triangleNodes[(i + 1) % 3], triangleNodes[(i + 2) % 3]))
+					{
+						filling[triangle] = true;
+						frontier.emplace_back(triangle);
+					}
+				}
 			}
 
-			/// Join the new node into the hole by joining it to
-			/// the outer points.
-			for (unsigned int outerNode : outerNodes)
+			while (!frontier.empty())
 			{
-				/// Add edge to the graph.
-				Edge newEdge(outerNode, newNodeHandle);
-				mResult.mGraph.AddEdge(newEdge);
-				/// Look for new triangular faces.
-				auto faces = mResult.FindFacesWithEdge(newEdge);
-				mResult.mFaces.insert_range(faces);
+				const Triangle& triangle = seamTriangles[frontier.back()];
+				frontier.pop_back();
+				for (unsigned int i = 0; i < 3; i++)
+				{
+					const NodeID neighbour = triangle.neighbours[i];
+					if (neighbour == NONE || filling[neighbour] || facesKeptTriangle(triangle.nodes[(i + 1) % 3], triangle.nodes[(i + 2) % 3])) continue;
+					filling[neighbour] = true;
+					frontier.emplace_back(neighbour);
+				}
 			}
 
-			return std::move(*this);
+			for (NodeID triangle = 0; triangle < seamTriangles.size(); triangle++)
+			{
+				if (filling[triangle]) triangles.emplace_back(seamTriangles[triangle].nodes);
+			}
+
+			// A triangulation of n points whose hull is a triangle has 2n - 5 triangles. The strips and the seam break
+			// ties the same way, and the margin of the kept triangles covers their rounding, so the pieces always fit.
+			AssertEQ(triangles.size(), 2 * mPoints.size() - 5);
+			return Assemble(triangles);
 		}
 
 
-		template <std::ranges::range Range>
-		Builder&& WithNodes(Range&& range)
+	private:
+		static constexpr NodeID NONE = std::numeric_limits<NodeID>::max();
+		/// How far the supporting nodes are first placed from the center of the bounding box, in lengths of its diagonal.
+		static constexpr T SUPPORT_DISTANCE = 16777216;
+
+
+		/// A triangle of the triangulation while it is being built.
+		struct Triangle
 		{
-			for (const auto& x : std::forward<Range>(range))
-			{
-				AddNode(x);
-			}
-			return std::move(*this);
-		}
+			/// The nodes of the triangle, in counter clockwise order.
+			std::array<NodeID, 3> nodes;
+			/// The triangle across the edge opposite each node, or NONE.
+			std::array<NodeID, 3> neighbours;
+		};
 
 
-		/// Return the graph with the supporting nodes removed.
-		Delaunay Build() const noexcept
+		/// An edge on the outline of the triangles being replaced by an insertion.
+		struct CavityEdge
 		{
-			// Return the copy.
-			return Prune();
-		}
+			NodeID a;
+			NodeID b;
+			/// The triangle on the other side of the edge, which is kept, or NONE.
+			NodeID outside;
+			/// The triangle made from this edge and the new node.
+			NodeID triangle;
+		};
 
 
-	private:
-		Delaunay Prune() const noexcept
-		{
-			// If we're pruning supporting vertices, we remove all nodes
-			// from the supporting rectangle and all faces using those nodes.
-			auto copy = mResult;
-
-			copy.mGraph.RemoveNode(0);
-			copy.mGraph.RemoveNode(1);
-			copy.mGraph.RemoveNode(2);
-			copy.mFaces = mResult.mFaces
-				| std::views::filter([] (Face face) {
-					return !(face.ContainsNode(0) ||
-							 face.ContainsNode(1) ||
-							 face.ContainsNode(2));
-				})
-				| std::ranges::to<std::set>();
-			Validate(&copy);
-			return copy;
-		}
+		/// The part of the triangulation taken from one strip of BuildParallel.
+		struct Partition
+		{
+			/// The triangles whose circumcircles lie inside the strip.
+			std::vector<std::array<NodeID, 3>>     keptTriangles;
+			/// The edges between a kept triangle and one which is not, in the kept triangle's order.
+			std::vector<std::pair<NodeID, NodeID>> seamEdges;
+			/// The nodes of the strip which have a triangle which is not kept.
+			std::vector<NodeID>                    seamNodes;
+		};
 
 
-		/// Returns the set of faces that conflict with the point being added 'value'.
-		///
-		/// Edges are defined to be conflictingly if their circumspheres
-		std::set<Face> GetConflictingFaces(const Vector<T, 2>& value) const
+		/// Triangulation of some of the points of a builder, starting from the supporting triangle.
+		class Triangulation
 		{
-			std::set<Face> conflictingFaces;
-			for (const auto& face : mResult.mFaces)
+		public:
+			explicit Triangulation(const std::vector<Vector<T, 2>>& points)
+				: mPoints(points)
+			{
+				mTriangles.emplace_back(MakeTriangle(0, 1, 2));
+			}
+
+
+			const std::vector<Triangle>& Triangles() const noexcept { return mTriangles; }
+
+
+			/// Inserts the node with the given ID.
+			void Insert(NodeID node)
 			{
-				if (auto c = GetCircumcircle(face); !c || c->Contains(value))
+				const Vector<T, 2>& point = mPoints[node];
+
+				const NodeID containing = Locate(point);
+				Assert(!std::ranges::any_of(mTriangles[containing].nodes, [&] (NodeID n) { return mPoints[n] == point; }),
+					   "Attempted to add duplicate node to Delaunay graph.");
+
+				FindCavity(containing, node);
+				FillCavity(node);
+			}
+
+
+			/// Makes the triangulation Delaunay again after its points have moved, by flipping each edge whose opposite
+			/// node lies inside the circumcircle of the triangle across it, until there are none left. Flips cannot
+			/// untangle triangles which have turned over, so if any has, this returns false and changes nothing.
+			bool Repair()
+			{
+				for (const Triangle& triangle : mTriangles)
 				{
-					conflictingFaces.emplace(face);
+					const auto& [a, b, c] = triangle.nodes;
+					if (Orient2D(mPoints[a], mPoints[b], mPoints[c]) <= 0) return false;
 				}
+
+				mFlipStack.resize(mTriangles.size());
+				std::iota(mFlipStack.begin(), mFlipStack.end(), NodeID(0));
+				Legalize();
+				return true;
 			}
-			return conflictingFaces;
-		}
 
 
-		/// Returns the set of nodes that outline the set of conflicting faces.
-		std::set<unsigned int> GetOuterNodes(const std::set<Face>& faces) const
-		{
-			// Count how often each edge occurs in these faces.
-			std::map<Edge, unsigned int> edgeOccurrences;
-			for (const auto& face : faces)
+			/// Removes the node with the given ID, so that it can be inserted again somewhere else. The edges around it
+			/// are flipped away until it has three triangles left, which are merged into one. Returns false if none of
+			/// its edges could be flipped, which needs some of the nodes around it to be collinear with it.
+			bool Remove(NodeID node)
 			{
-				for (const auto& edge : face.Edges())
+				NodeID triangle = Locate(mPoints[node]);
+				Assert(std::ranges::contains(mTriangles[triangle].nodes, node));
+
+				while (true)
 				{
-					edgeOccurrences[edge] += 1;
+					// The triangles around node in counter clockwise order. Each is across the edge from node to the
+					// last node of the one before it.
+					mStar.clear();
+					NodeID current = triangle;
+					do
+					{
+						mStar.emplace_back(current);
+						current = mTriangles[current].neighbours[(NodeIndex(mTriangles[current], node) + 1) % 3];
+					}
+					while (current != triangle);
+
+					if (mStar.size() == 3) break;
+
+					// The edge between node and b is flipped to one between a and c, where abc is a triangle with
+					// node on its far side.
+					bool flipped = false;
+					for (size_t k = 0; k < mStar.size() && !flipped; k++)
+					{
+						const NodeID first = mStar[k], second = mStar[(k + 1) % mStar.size()];
+						const unsigned int i = NodeIndex(mTriangles[first], node);
+						const unsigned int j = OppositeIndex(mTriangles[second], first);
+						const NodeID a = mTriangles[first].nodes[(i + 1) % 3], b = mTriangles[first].nodes[(i + 2) % 3];
+						const NodeID c = mTriangles[second].nodes[j];
+						if (Orient2D(mPoints[a], mPoints[b], mPoints[c]) > 0 && Orient2D(mPoints[a], mPoints[c], mPoints[node]) > 0)
+						{
+							Flip(first, (i + 1) % 3, second, j);
+							mFlipStack.emplace_back(first);
+							triangle = second;
+							flipped = true;
+						}
+					}
+
+					if (!flipped)
+					{
+						Legalize();
+						return false;
+					}
 				}
+
+				// The triangles node, a, b and node, b, c and node, c, a become a, b, c, in the slot of the first.
+				const auto [first, second, third] = std::array{mStar[0], mStar[1], mStar[2]};
+				const NodeID outside[3] = {
+					mTriangles[first].neighbours[NodeIndex(mTriangles[first], node)],
+					mTriangles[second].neighbours[NodeIndex(mTriangles[second], node)],
+					mTriangles[third].neighbours[NodeIndex(mTriangles[third], node)]};
+				const unsigned int i = NodeIndex(mTriangles[first], node);
+				const NodeID a = mTriangles[first].nodes[(i + 1) % 3], b = mTriangles[first].nodes[(i + 2) % 3];
+				const NodeID c = mTriangles[second].nodes[(NodeIndex(mTriangles[second], node) + 2) % 3];
+				mTriangles[first] = Triangle{{a, b, c}, {outside[1], outside[2], outside[0]}};
+				for (NodeID neighbour : {outside[1], outside[2]})
+				{
+					if (neighbour == NONE) continue;
+					Triangle& other = mTriangles[neighbour];
+					other.neighbours[OppositeIndex(other, neighbour == outside[1] ? second : third)] = first;
+				}
+
+				mFlipStack.emplace_back(first);
+				Release(std::max(second, third));
+				Release(std::min(second, third));
+				Legalize();
+				return true;
 			}
 
-			// Filter for the edges that occur twice, meaning that they are inner edges.
-			std::set<Delaunay<Vector<T, 2>>::Edge> outerEdges;
-			for (const auto& [edge, count] : edgeOccurrences)
+
+			/// Returns whether the triangles without supporting nodes cover the convex hull of the nodes. They do not when a
+			/// supporting node lies inside the circumcircle of a triangle which belongs there. The triangles with one
+			/// supporting node go around the hull, so this is whether their edges opposite it only ever turn one way.
+			bool CoversHull() const
 			{
-				Core::Assert(count == 1 || count == 2);
-				if (count == 1)
+				for (const Triangle& triangle : mTriangles)
 				{
-					outerEdges.emplace(edge);
+					if (std::ranges::count_if(triangle.nodes, IsSupportingNode) != 1) continue;
+
+					const unsigned int k = static_cast<unsigned int>(std::ranges::find_if(triangle.nodes, IsSupportingNode) - triangle.nodes.begin());
+					const NodeID a = triangle.nodes[(k + 1) % 3], b = triangle.nodes[(k + 2) % 3];
+
+					// The next edge of the outline starts at b, in the next triangle around b with a node other than a
+					// supporting node after b.
+					const Triangle* next = &triangle;
+					NodeID c = triangle.nodes[k];
+					while (IsSupportingNode(c))
+					{
+						const unsigned int i = NodeIndex(*next, b);
+						next = &mTriangles[next->neighbours[(i + 2) % 3]];
+						c = next->nodes[(NodeIndex(*next, b) + 1) % 3];
+					}
+
+					if (Orient2D(mPoints[a], mPoints[b], mPoints[c]) > 0) return false;
+				}
+				return true;
+			}
+
+
+		private:
+			/// Finds the triangle containing point, by walking across whichever edge of the current triangle has point on
+			/// its far side, starting from the last triangle made. The edge to test first is varied, so that the walk
+			/// cannot loop forever, and the edge just crossed is not tested again.
+			NodeID Locate(const Vector<T, 2>& point)
+			{
+				NodeID triangle = mLastTriangle;
+				NodeID previous = NONE;
+				while (true)
+				{
+					const Triangle& current = mTriangles[triangle];
+					const unsigned int offset = mWalkCounter++ % 3;
+
+					NodeID next = NONE;
+					for (unsigned int k = 0; k < 3 && next == NONE; k++)
+					{
+						const unsigned int i = (offset + k) % 3;
+						const NodeID neighbour = current.neighbours[i];
+						if (neighbour == NONE || neighbour == previous) continue;
+
+						if (Orient2D(mPoints[current.nodes[(i + 1) % 3]], mPoints[current.nodes[(i + 2) % 3]], point) < 0)
+						{
+							next = neighbour;
+						}
+					}
+
+					if (next == NONE) return triangle;
+					previous = triangle;
+					triangle = next;
 				}
 			}
 
-			std::set<unsigned int> outerNodes;
-			for (const auto& edge : outerEdges)
+
+			/// Collects the triangles whose circumcircles contain node into mCavity, searching outwards from the
+			/// triangle containing it, and the edges around them into mCavityEdges. Triangles whose edge with the cavity
+			/// does not face node are taken into the cavity too, so that it can always be filled with a fan around node.
+			void FindCavity(NodeID containing, NodeID node)
 			{
-				outerNodes.emplace(edge.A());
-				outerNodes.emplace(edge.B());
+				const Vector<T, 2>& point = mPoints[node];
+
+				if (mCavityMarks.size() < mTriangles.size()) mCavityMarks.resize(mTriangles.size() + 2, 0);
+				mCavityStamp++;
+
+				mCavity.clear();
+				mCavityEdges.clear();
+				mCavity.emplace_back(containing);
+				mCavityMarks[containing] = mCavityStamp;
+				for (size_t k = 0; k < mCavity.size(); k++)
+				{
+					const Triangle& triangle = mTriangles[mCavity[k]];
+					for (unsigned int i = 0; i < 3; i++)
+					{
+						const NodeID neighbour = triangle.neighbours[i];
+						if (neighbour != NONE && mCavityMarks[neighbour] == mCavityStamp) continue;
+
+						const NodeID a = triangle.nodes[(i + 1) % 3], b = triangle.nodes[(i + 2) % 3];
+						if (neighbour != NONE && (InCircumcircle(mTriangles[neighbour], node) || Orient2D(mPoints[a], mPoints[b], point) <= 0))
+						{
+							mCavityMarks[neighbour] = mCavityStamp;
+							mCavity.emplace_back(neighbour);
+						}
+						else
+						{
+							mCavityEdges.emplace_back(CavityEdge{a, b, neighbour, NONE});
+						}
+					}
+				}
 			}
 
-			return outerNodes;
+
+			/// Replaces the triangles of the cavity with a triangle joining node to each edge around it. The new
+			/// triangles reuse the slots of the old ones, and as the cavity is a disk, there are always two more of them.
+			void FillCavity(NodeID node)
+			{
+				AssertEQ(mCavityEdges.size(), mCavity.size() + 2);
+
+				for (size_t k = 0; k < mCavityEdges.size(); k++)
+				{
+					CavityEdge& edge = mCavityEdges[k];
+					if (k < mCavity.size())
+					{
+						edge.triangle = mCavity[k];
+						mTriangles[edge.triangle] = MakeTriangle(node, edge.a, edge.b);
+					}
+					else
+					{
+						edge.triangle = static_cast<NodeID>(mTriangles.size());
+						mTriangles.emplace_back(MakeTriangle(node, edge.a, edge.b));
+					}
+
+					// The outside triangle is found by its nodes, as its old neighbour's slot may have been reused already.
+					Triangle& triangle = mTriangles[edge.triangle];
+					triangle.neighbours[0] = edge.outside;
+					if (edge.outside != NONE)
+					{
+						Triangle& outside = mTriangles[edge.outside];
+						for (unsigned int i = 0; i < 3; i++)
+						{
+							if (outside.nodes[i] != edge.a && outside.nodes[i] != edge.b) outside.neighbours[i] = edge.triangle;
+						}
+					}
+				}
+
+				// Each new triangle shares its edge from node to edge.a with the triangle before it around node.
+				std::ranges::sort(mCavityEdges, std::less{}, &CavityEdge::a);
+				for (CavityEdge& edge : mCavityEdges)
+				{
+					auto after = std::ranges::lower_bound(mCavityEdges, edge.b, std::less{}, &CavityEdge::a);
+					Assert(after != mCavityEdges.end() && after->a == edge.b, "The cavity is not a disk!");
+					mTriangles[edge.triangle].neighbours[1] = after->triangle;
+					mTriangles[after->triangle].neighbours[2] = edge.triangle;
+				}
+
+				mLastTriangle = mCavityEdges.back().triangle;
+			}
+
+
+			/// Flips the edges of the triangles on mFlipStack, and of the triangles made by those flips, until no edge has
+			/// the node opposite it inside the circumcircle of the triangle across it.
+			void Legalize()
+			{
+				while (!mFlipStack.empty())
+				{
+					const NodeID triangle = mFlipStack.back();
+					mFlipStack.pop_back();
+					if (triangle >= mTriangles.size()) continue;
+
+					for (unsigned int i = 0; i < 3; i++)
+					{
+						const NodeID neighbour = mTriangles[triangle].neighbours[i];
+						if (neighbour == NONE) continue;
+
+						const Triangle& other = mTriangles[neighbour];
+						const unsigned int j = OppositeIndex(other, triangle);
+						if (InCircumcircle(mTriangles[triangle], other.nodes[j]))
+						{
+							Flip(triangle, i, neighbour, j);
+							mFlipStack.emplace_back(triangle);
+							mFlipStack.emplace_back(neighbour);
+							break;
+						}
+					}
+				}
+			}
+
+
+			/// Frees the slot of a triangle which is no longer used, by moving the last triangle into it.
+			void Release(NodeID slot)
+			{
+				const NodeID last = static_cast<NodeID>(mTriangles.size() - 1);
+				if (slot != last)
+				{
+					mTriangles[slot] = mTriangles[last];
+					for (NodeID neighbour : mTriangles[slot].neighbours)
+					{
+						if (neighbour != NONE) mTriangles[neighbour].neighbours[OppositeIndex(mTriangles[neighbour], last)] = slot;
+					}
+					// Entries for the last triangle on the flip stack are dropped by Legalize, so it is checked here.
+					mFlipStack.emplace_back(slot);
+				}
+
+				mTriangles.pop_back();
+				if (mLastTriangle >= mTriangles.size()) mLastTriangle = 0;
+			}
+
+
+			/// Replaces the edge between triangle and neighbour, which are opposite the nodes at index i and j of them,
+			/// with the edge between those nodes. Both triangles keep their slots.
+			void Flip(NodeID triangle, unsigned int i, NodeID neighbour, unsigned int j)
+			{
+				const Triangle t = mTriangles[triangle], u = mTriangles[neighbour];
+				const NodeID a = t.nodes[i], b = t.nodes[(i + 1) % 3], c = t.nodes[(i + 2) % 3];
+				const NodeID d = u.nodes[j];
+
+				// The triangles abc and dcb become abd and adc. Each takes one of the outer edges of the other.
+				const NodeID acrossBD = u.neighbours[(j + 1) % 3];
+				const NodeID acrossCA = t.neighbours[(i + 1) % 3];
+				mTriangles[triangle] = Triangle{{a, b, d}, {acrossBD, neighbour, t.neighbours[(i + 2) % 3]}};
+				mTriangles[neighbour] = Triangle{{a, d, c}, {u.neighbours[(j + 2) % 3], acrossCA, triangle}};
+
+				if (acrossBD != NONE) mTriangles[acrossBD].neighbours[OppositeIndex(mTriangles[acrossBD], neighbour)] = triangle;
+				if (acrossCA != NONE) mTriangles[acrossCA].neighbours[OppositeIndex(mTriangles[acrossCA], triangle)] = neighbour;
+			}
+
+
+			/// Returns the index of node in triangle.
+			static unsigned int NodeIndex(const Triangle& triangle, NodeID node) noexcept
+			{
+				for (unsigned int i = 0; i < 3; i++)
+				{
+					if (triangle.nodes[i] == node) return i;
+				}
+				Unreachable();
+			}
+
+
+			/// Returns the index of the node of triangle which is opposite its edge with neighbour.
+			static unsigned int OppositeIndex(const Triangle& triangle, NodeID neighbour) noexcept
+			{
+				for (unsigned int i = 0; i < 3; i++)
+				{
+					if (triangle.neighbours[i] == neighbour) return i;
+				}
+				Unreachable();
+			}
+
+
+			static Triangle MakeTriangle(NodeID a, NodeID b, NodeID c) noexcept
+			{
+				return Triangle{{a, b, c}, {NONE, NONE, NONE}};
+			}
+
+
+			/// Returns whether node lies inside the circumcircle of triangle. Where it lies exactly on it, the tie is broken
+			/// as if the node with the smallest ID were lifted slightly off the circle, which depends only on the IDs, so
+			/// that cocircular nodes are triangulated the same way whatever order they are inserted in.
+			bool InCircumcircle(const Triangle& triangle, NodeID node) const
+			{
+				const auto& [a, b, c] = triangle.nodes;
+				const double inCircle = InCircle(mPoints[a], mPoints[b], mPoints[c], mPoints[node]);
+				if (inCircle != 0) return inCircle > 0;
+
+				// Lifting node itself moves it outside. Lifting a node of the triangle moves node inside when node is on
+				// the same side of the opposite edge as it.
+				const NodeID lowest = std::min({a, b, c, node});
+				if (lowest == node) return false;
+				const unsigned int i = NodeIndex(triangle, lowest);
+				return Orient2D(mPoints[triangle.nodes[(i + 1) % 3]], mPoints[triangle.nodes[(i + 2) % 3]], mPoints[node]) > 0;
+			}
+
+
+			/// The value of each node, including those not in this triangulation.
+			const std::vector<Vector<T, 2>>& mPoints;
+			/// The triangles, including those using the supporting nodes.
+			std::vector<Triangle>            mTriangles;
+			/// The triangle to start the next walk from.
+			NodeID                           mLastTriangle = 0;
+			/// Counts the triangles visited by walks, to vary the edge each step tests first.
+			unsigned int                     mWalkCounter = 0;
+			/// The triangles being replaced by the current insertion, and the edges around them. Kept between
+			/// insertions to reuse their memory.
+			std::vector<NodeID>              mCavity;
+			std::vector<CavityEdge>          mCavityEdges;
+			/// Marks triangles in the current cavity, with the stamp of the insertion which last added them.
+			std::vector<uint32_t>            mCavityMarks;
+			uint32_t                         mCavityStamp = 0;
+			/// The triangles whose edges Legalize has still to check.
+			std::vector<NodeID>              mFlipStack;
+			/// The triangles around the node being removed.
+			std::vector<NodeID>              mStar;
+		};
+
+
+		static bool IsSupportingNode(NodeID node) noexcept
+		{
+			return node < 3;
 		}
 
 
-		/// Returns the set of edges that are shared amongst the input faces.
-		std::set<Edge> GetInnerEdges(const std::set<Delaunay<Vector<T, 2>>::Face>& faces) const
+		/// Places the supporting nodes, which are the first three points, on a triangle around the bounding box whose
+		/// corners are the given number of lengths of its diagonal from its center.
+		void PlaceSupportingNodes(std::vector<Vector<T, 2>>& points, T distance) const
 		{
-			// Count how often each edge occurs in these faces.
-			std::map<Edge, unsigned int> edgeOccurrences;
-			for (const auto& face : faces)
+			const Vector<T, 2> center = mBoundingBox.Center();
+			const T radius = distance * static_cast<T>(mBoundingBox.Span().Magnitude());
+			points[0] = center + radius * Vector<T, 2>(0, 1);
+			points[1] = center + radius * Vector<T, 2>(static_cast<T>(-0.866025403784438647), static_cast<T>(-0.5));
+			points[2] = center + radius * Vector<T, 2>(static_cast<T>(0.866025403784438647), static_cast<T>(-0.5));
+		}
+
+
+		/// Triangulates the given nodes, starting from the supporting triangle. Triangles whose circumcircles reach past a
+		/// supporting node are left out, so while the triangles do not cover the hull of the nodes, the supporting nodes
+		/// are moved further away, in a copy of the points kept in movedPoints, and the nodes are triangulated again.
+		template <std::ranges::range Nodes>
+		Triangulation Triangulate(const Nodes& nodes, std::vector<Vector<T, 2>>& movedPoints, std::pmr::memory_resource* scratch) const
+		{
+			const std::vector<Vector<T, 2>>* points   = &mPoints;
+			T                                distance = SUPPORT_DISTANCE;
+			while (true)
 			{
-				for (const auto& edge : face.Edges())
+				Triangulation triangulation(*points);
+				for (NodeID node : InsertionOrder(nodes, scratch))
 				{
-					edgeOccurrences[edge] += 1;
+					triangulation.Insert(node);
 				}
+				if (triangulation.CoversHull()) return triangulation;
+
+				distance *= 16;
+				Assert(std::isfinite(distance * static_cast<T>(mBoundingBox.Span().Magnitude())), "The supporting nodes could not be placed far enough away!");
+				if (movedPoints.empty()) movedPoints = mPoints;
+				PlaceSupportingNodes(movedPoints, distance);
+				points = &movedPoints;
 			}
+		}
 
-			// Filter for the edges that occur twice, meaning that they are inner edges.
-			std::set<Delaunay<Vector<T, 2>>::Edge> innerEdges;
-			for (const auto& [edge, count] : edgeOccurrences)
+
+		/// Triangulates the given nodes of a strip, which covers x from left to right, and splits its triangles into
+		/// those which are part of the whole triangulation and those which are not.
+		Partition TriangulatePartition(std::span<const NodeID> nodes, T left, T right) const
+		{
+			ZoneScoped;
+
+			Triangulation triangulation(mPoints);
+			for (NodeID node : InsertionOrder(nodes, std::pmr::new_delete_resource()))
+			{
+				triangulation.Insert(node);
+			}
+
+			// The margin covers the rounding of the circumcircles. Triangles which are wrongly left out are only slower.
+			static constexpr T MARGIN = 1 + 1e-6;
+			auto kept = [&] (const Triangle& triangle)
+			{
+				const auto& [a, b, c] = triangle.nodes;
+				const auto [center, radiusSquared] = MakeCircumcircle(mPoints[a], mPoints[b], mPoints[c]);
+				const T toLeft = center[0] - left, toRight = right - center[0];
+				return toLeft > 0 && toRight > 0 && toLeft * toLeft > MARGIN * radiusSquared && toRight * toRight > MARGIN * radiusSquared;
+			};
+
+			const auto& triangles = triangulation.Triangles();
+			std::vector<bool> isKept;
+			isKept.reserve(triangles.size());
+			for (const Triangle& triangle : triangles)
+			{
+				isKept.emplace_back(kept(triangle));
+			}
+
+			Partition partition;
+			for (NodeID triangle = 0; triangle < triangles.size(); triangle++)
 			{
-				Core::Assert(count == 1 || count == 2);
-				if (count == 2)
+				const auto& [triangleNodes, neighbours] = triangles[triangle];
+				if (!isKept[triangle])
 				{
-					innerEdges.emplace(edge);
+					std::ranges::copy_if(triangleNodes, std::back_inserter(partition.seamNodes), std::not_fn(IsSupportingNode));
+					continue;
+				}
+
+				partition.keptTriangles.emplace_back(triangleNodes);
+				for (unsigned int i = 0; i < 3; i++)
+				{
+					if (neighbours[i] != NONE && !isKept[neighbours[i]])
+					{
+						partition.seamEdges.emplace_back(triangleNodes[(i + 1) % 3], triangleNodes[(i + 2) % 3]);
+					}
 				}
 			}
 
-			return innerEdges;
+			std::ranges::sort(partition.seamNodes);
+			auto duplicates = std::ranges::unique(partition.seamNodes);
+			partition.seamNodes.erase(duplicates.begin(), duplicates.end());
+			return partition;
 		}
 
 
-		/// Gets the given face in the form of a triangle.
-		Triangle<T, 2> GetFaceAsTriangle(Face face) const noexcept
+		/// Makes the triangulation from its triangles, given by their nodes in counter clockwise order.
+		template <std::ranges::range Triangles>
+		Delaunay Assemble(Triangles&& triangles) const
 		{
-			auto iter = mTriangleCache.find(face);
-			if (iter == mTriangleCache.end())
+			Delaunay result;
+			result.mBoundingBox = mBoundingBox;
+
+			for (const auto& point : mPoints)
 			{
-				Triangle<T, 2> triangle({
-						mResult.GetGraph().GetValue(face.Node(0)),
-						mResult.GetGraph().GetValue(face.Node(1)),
-						mResult.GetGraph().GetValue(face.Node(2))
-					});
+				result.mGraph.AddNode(point);
+			}
 
-				iter = mTriangleCache.emplace(face, triangle).first;
+			// Each face is paired with its nodes in counter clockwise order, for the mesh.
+			std::vector<std::pair<Face, std::array<NodeID, 3>>> faces;
+			faces.reserve(2 * mPoints.size());
+			std::vector<Edge> edges;
+			edges.reserve(6 * mPoints.size());
+			for (const std::array<NodeID, 3>& nodes : triangles)
+			{
+				if (std::ranges::any_of(nodes, IsSupportingNode)) continue;
+
+				faces.emplace_back(Face(nodes[0], nodes[1], nodes[2]), nodes);
+				for (unsigned int i = 0; i < 3; i++)
+				{
+					edges.emplace_back(nodes[i], nodes[(i + 1) % 3]);
+				}
 			}
+			result.mGraph.AddEdges(edges);
+
+			for (NodeID node = 0; node < 3; node++)
+			{
+				result.mGraph.RemoveNode(node);
+			}
+
+			std::ranges::sort(faces, std::less{}, &std::pair<Face, std::array<NodeID, 3>>::first);
+			result.mFaces = faces | std::views::keys | std::ranges::to<std::set>();
+			result.mMesh  = Mesh(mPoints, faces | std::views::values);
 
-			return iter->second;
+			Validate(result);
+			return result;
+		}
+
+
+		/// Returns the given nodes in the order in which to insert them.
+		template <std::ranges::range Nodes>
+		std::pmr::vector<NodeID> InsertionOrder(Nodes&& nodes, std::pmr::memory_resource* scratch) const
+		{
+			return InsertionOrder(mBoundingBox, mPoints, std::forward<Nodes>(nodes), scratch);
 		}
 
 
-		/// Gets the given face's circumcircle.
-		Optional<Sphere<T, 2>> GetCircumcircle(Face face) const noexcept
+		/// Returns the given nodes, whose values are in points, in the order in which to insert them.
+		template <std::ranges::range Nodes>
+		static std::pmr::vector<NodeID> InsertionOrder(const AABB<T, 2>& boundingBox, const std::vector<Vector<T, 2>>& points,
+													   Nodes&& nodes, std::pmr::memory_resource* scratch)
 		{
-			auto iter = mCircumsphereCache.find(face);
-			if (iter == mCircumsphereCache.end())
+			std::pmr::vector<std::pair<uint32_t, NodeID>> keyed(scratch);
+			for (NodeID node : nodes)
 			{
-				auto sphere = GetFaceAsTriangle(face).GetCircumsphere();
-				if (!sphere) return NullOpt;
-				iter = mCircumsphereCache.emplace(face, sphere.Unwrap()).first;
+				keyed.emplace_back(0, node);
 			}
 
-			return iter->second;
+			// Shuffle with a fixed seed, so that building the same points always gives the same triangulation.
+			std::minstd_rand random(1);
+			for (size_t i = keyed.size(); i > 1; i--)
+			{
+				std::swap(keyed[i - 1], keyed[random() % i]);
+			}
+
+			for (auto& [key, node] : keyed)
+			{
+				key = HilbertIndex(boundingBox, points[node]);
+			}
+
+			// Each round is as large as all of the rounds before it, down to a first round of a few points.
+			static constexpr size_t FIRST_ROUND_SIZE = 64;
+			size_t end = keyed.size();
+			while (end > 0)
+			{
+				const size_t begin = end > FIRST_ROUND_SIZE ? end / 2 : 0;
+				std::sort(keyed.begin() + begin, keyed.begin() + end);
+				end = begin;
+			}
+
+			std::pmr::vector<NodeID> order(scratch);
+			order.reserve(keyed.size());
+			std::ranges::copy(keyed | std::views::values, std::back_inserter(order));
+			return order;
 		}
 
 
-		/// Returns the area of the face.
-		double GetFaceArea(Face face) const noexcept
+		/// Returns the index of the point along a Hilbert curve filling the bounding box.
+		static uint32_t HilbertIndex(const AABB<T, 2>& boundingBox, const Vector<T, 2>& point) noexcept
 		{
-			auto a = mResult.GetGraph().GetValue(face.Node(0));
-			auto b = mResult.GetGraph().GetValue(face.Node(1));
-			auto c = mResult.GetGraph().GetValue(face.Node(2));
+			static constexpr uint32_t SIZE = 1 << 16;
 
-			auto v1 = b - a;
-			auto v2 = c - a;
+			auto cell = [&] (unsigned int axis)
+			{
+				T offset = (point[axis] - boundingBox.Min()[axis]) / (boundingBox.Max()[axis] - boundingBox.Min()[axis]);
+				return static_cast<uint32_t>(std::clamp<T>(offset * SIZE, 0, SIZE - 1));
+			};
 
-			return 0.5 * std::abs(v1[0] * v2[1] - v1[1] * v2[0]);
+			uint32_t x = cell(0), y = cell(1), index = 0;
+			for (uint32_t s = SIZE / 2; s > 0; s /= 2)
+			{
+				const uint32_t rx = (x & s) > 0;
+				const uint32_t ry = (y & s) > 0;
+				index += s * s * ((3 * rx) ^ ry);
+				if (ry == 0)
+				{
+					if (rx == 1)
+					{
+						x = SIZE - 1 - x;
+						y = SIZE - 1 - y;
+					}
+					std::swap(x, y);
+				}
+			}
+			return index;
 		}
 
 
-	private:
 		/// Creates a clamping box from the bounding box of this builder.
 		///
 		/// The returned clamping box is just barely smaller than the bounding box.
@@ -522,12 +1137,11 @@ namespace Strawberry::Core::Math
 			return AABB<T, 2>(min, max);
 		}
 
-		void Validate(const Delaunay* graph = nullptr) const
+		static void Validate([[maybe_unused]] const Delaunay& graph)
 		{
 #ifdef STRAWBERRY_DEBUG
-			if (graph == nullptr) graph = &mResult;
 			std::map<Edge, unsigned int> edgeOccurrences;
-			for (auto face : graph->Faces())
+			for (auto face : graph.Faces())
 			{
 				for (auto edge : face.Edges())
 				{
@@ -547,13 +1161,9 @@ namespace Strawberry::Core::Math
 		AABB<T, 2> mBoundingBox;
 		/// The box to which input points are clamped.
 		AABB<T, 2> mClampingBox;
-		/// The delaunay graph we are creating.
-		Delaunay<Vector<T, 2>>                 mResult;
-		/// A cache of the triangle representation of faces from our delaunay.
-		mutable std::map<Face, Triangle<T, 2>> mTriangleCache;
-		/// A cache of the circumspheres of the faces from our delaunay.
-		mutable std::map<Face, Sphere<T, 2>>   mCircumsphereCache;
-		/// Bool for whether the resulting graph should be pruned.
-		bool mShouldPrune = true;
+		/// The value of each node, starting with the three supporting nodes.
+		std::vector<Vector<T, 2>> mPoints;
+		/// Arena for the temporary containers of Build, if there is one.
+		Arena* mScratchArena = nullptr;
 	};
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Strawberry/Core/IO/Logging.hpp"
+#include "Strawberry/Core/Math/Graph/NodeStorage.hpp"
 #include "Strawberry/Core/Math/Vector.hpp"
 #include "Strawberry/Core/Types/Optional.hpp"
 #include "fmt/ranges.h"
@@ -9,6 +10,7 @@
 #include <concepts>
 #include <deque>
 #include <map>
+#include <memory>
 #include <type_traits>
 #include <vector>
 #include <set>
@@ -127,41 +129,93 @@ namespace Strawberry::Core::Math
 	};
 
 
-	template <GraphConfig Config>
+	/// The containers of a graph, with their allocator rebound to their element types.
+	template <GraphConfig Config, typename Allocator>
+	struct GraphContainers
+	{
+		template <typename T>
+		using Rebind = std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+		using NodeID       = Config::NodeID;
+		using NeighbourSet = std::set<NodeID, std::less<NodeID>, Rebind<NodeID>>;
+		using EdgeMap      = std::map<NodeID, NeighbourSet, std::less<NodeID>, Rebind<std::pair<const NodeID, NeighbourSet>>>;
+	};
+
+
+	template <GraphConfig Config, typename Allocator>
 	struct GraphEdgeStorage;
 
 
-	template <GraphConfig Config> requires (!Config::Weighted)
-	struct GraphEdgeStorage<Config>
+	template <GraphConfig Config, typename Allocator> requires (!Config::Weighted)
+	struct GraphEdgeStorage<Config, Allocator>
 	{
+		explicit GraphEdgeStorage(const Allocator& allocator = Allocator())
+			: mEdges(allocator)
+		{}
+
+
 		unsigned int Count() const { return static_cast<unsigned int>(mEdges.size()); }
 
 
-		mutable std::map<typename Config::NodeID, std::set<typename Config::NodeID>> mEdges;
+		mutable GraphContainers<Config, Allocator>::EdgeMap mEdges;
 	};
 
 
-	template <GraphConfig Config> requires (Config::Weighted)
-	struct GraphEdgeStorage<Config>
+	template <GraphConfig Config, typename Allocator> requires (Config::Weighted)
+	struct GraphEdgeStorage<Config, Allocator>
 	{
+		using WeightMap = std::map<
+			EdgeCommon<Config>,
+			typename Config::WeightType,
+			std::less<EdgeCommon<Config>>,
+			typename GraphContainers<Config, Allocator>::template Rebind<std::pair<const EdgeCommon<Config>, typename Config::WeightType>>>;
+
+
+		explicit GraphEdgeStorage(const Allocator& allocator = Allocator())
+			: mEdges(allocator)
+			, mWeights(allocator)
+		{}
+
+
 		unsigned int Count() const { return static_cast<unsigned int>(mEdges.size()); }
 
 
-		mutable std::map<typename Config::NodeID, std::set<typename Config::NodeID>> mEdges;
-		std::map<EdgeCommon<Config>, typename Config::WeightType> mWeights;
+		mutable GraphContainers<Config, Allocator>::EdgeMap mEdges;
+		WeightMap                                           mWeights;
 	};
 
 
-	template <typename _value, GraphConfig _config>
+	/// Graph of values connected by edges.
+	///
+	/// All of the graph's nodes and edges are allocated with Allocator, so a graph which is built and thrown away
+	/// often can be given a std::pmr::polymorphic_allocator over an Arena or a BlockPool. Nodes are kept in a map by
+	/// default, or in a SlotMap if the config has DenseNodes set, as DenseGraphConfig does.
+	template <typename _value, GraphConfig _config, typename _allocator = std::allocator<_value>>
 	class Graph
 	{
 	public:
 		using Value = _value;
 		using Config = _config;
+		using Allocator = _allocator;
 		using NodeID = unsigned int;
 		using Edge = Edge<Config>;
 
 
+		Graph() = default;
+
+
+		explicit Graph(const Allocator& allocator)
+			: mNodes(allocator)
+			, mEdgeStorage(allocator)
+		{}
+
+
+		Allocator GetAllocator() const noexcept
+		{
+			return Allocator(mEdgeStorage.mEdges.get_allocator());
+		}
+
+
 		Value& GetValue(NodeID nodeIndex)
 		{
 			return mNodes.at(nodeIndex);
@@ -180,9 +234,15 @@ namespace Strawberry::Core::Math
 		}
 
 
+		[[nodiscard]] bool ContainsNode(NodeID node) const
+		{
+			return mNodes.contains(node);
+		}
+
+
 		auto Nodes() const noexcept
 		{
-			return std::ranges::views::all(mNodes);
+			return mNodes.Entries();
 		}
 
 
@@ -228,29 +288,26 @@ namespace Strawberry::Core::Math
 
 		auto NodeIndices() const noexcept
 		{
-			return mNodes | std::views::keys;
+			return mNodes.IDs();
 		}
 
 
 		auto Values() const noexcept
 		{
-			return mNodes | std::views::values;
+			return mNodes.Values();
 		}
 
 
 		[[nodiscard]] bool ContainsValue(const Value& value) const noexcept
 		{
-			return std::ranges::find_if(
-				mNodes,
-				[value] (const auto& x) { return x.second == value; }) != mNodes.end();
+			return std::ranges::contains(mNodes.Values(), value);
 		}
 
 
 		template <typename T> requires (std::same_as<Value, std::decay_t<T>>)
 		NodeID AddNode(T&& node)
 		{
-			mNodes.insert({mNextID++, std::forward<T>(node)});
-			return mNextID - 1;
+			return mNodes.Insert(std::forward<T>(node));
 		}
 
 
@@ -264,14 +321,26 @@ namespace Strawberry::Core::Math
 		/// Removes the node with the given index, as well as all it's connected edges.
 		void RemoveNode(NodeID index)
 		{
-			auto affectedEdges =  Edges()
-				| std::views::filter([index] (const Edge& e) { return e.ContainsNode(index); })
-				| std::ranges::to<std::vector>();
+			if constexpr (Config::Directed)
+			{
+				auto affectedEdges =  Edges()
+					| std::views::filter([index] (const Edge& e) { return e.ContainsNode(index); })
+					| std::ranges::to<std::vector>();
 
 
-			for (auto edge : affectedEdges)
+				for (auto edge : affectedEdges)
+				{
+					RemoveEdge(edge);
+				}
+			}
+			else if (auto edges = mEdgeStorage.mEdges.find(index); edges != mEdgeStorage.mEdges.end())
 			{
-				RemoveEdge(edge);
+				// Undirected edges are stored in both directions, so the node's own neighbours name every edge to remove.
+				for (NodeID neighbour : edges->second)
+				{
+					mEdgeStorage.mEdges[neighbour].erase(index);
+				}
+				mEdgeStorage.mEdges.erase(edges);
 			}
 
 			mNodes.erase(index);
@@ -298,6 +367,51 @@ namespace Strawberry::Core::Math
 		}
 
 
+		/// Adds every edge in range. Equivalent to calling AddEdge on each, but the edges are sorted first and inserted
+		/// in order, which is much faster than searching for each one's nodes when there are many.
+		template <std::ranges::input_range Range> requires (std::convertible_to<std::ranges::range_reference_t<Range>, const Edge&>)
+		void AddEdges(Range&& edges)
+		{
+			std::vector<std::pair<NodeID, NodeID>> links;
+			if constexpr (std::ranges::sized_range<Range>)
+			{
+				links.reserve(Config::Directed ? std::ranges::size(edges) : 2 * std::ranges::size(edges));
+			}
+
+			for (const Edge& e : edges)
+			{
+				links.emplace_back(e.A(), e.B());
+				if constexpr (!Config::Directed)
+				{
+					links.emplace_back(e.B(), e.A());
+					if constexpr (Config::Weighted)
+					{
+						mEdgeStorage.mWeights[{e.B(), e.A()}] = e.Weight();
+					}
+				}
+				if constexpr (Config::Weighted)
+				{
+					mEdgeStorage.mWeights[e] = e.Weight();
+				}
+			}
+			std::ranges::sort(links);
+
+			// Each insertion is hinted to go after the last, which makes it constant time when the graph had no edges.
+			auto& edgeMap = mEdgeStorage.mEdges;
+			auto neighbours = edgeMap.end();
+			for (const auto& [a, b] : links)
+			{
+				if (neighbours == edgeMap.end() || neighbours->first != a)
+				{
+					Assert(mNodes.contains(a));
+					neighbours = edgeMap.try_emplace(neighbours == edgeMap.end() ? neighbours : std::next(neighbours), a);
+				}
+				if constexpr (Config::Directed) Assert(mNodes.contains(b));
+				neighbours->second.emplace_hint(neighbours->second.end(), b);
+			}
+		}
+
+
 		void RemoveEdge(const Edge& e)
 		{
 			mEdgeStorage.mEdges[e.A()].erase(e.B());
@@ -310,12 +424,13 @@ namespace Strawberry::Core::Math
 
 		[[nodiscard]] unsigned int EdgeCount() const
 		{
-			std::set<Edge> edgeSet;
-			for (auto edge : Edges())
+			size_t count = 0;
+			for (const auto& [node, neighbours] : mEdgeStorage.mEdges)
 			{
-				edgeSet.emplace(edge);
+				count += neighbours.size();
 			}
-			return edgeSet.size();
+			// Undirected edges are stored in both directions.
+			return static_cast<unsigned int>(Config::Directed ? count : count / 2);
 		}
 
 
@@ -358,10 +473,20 @@ namespace Strawberry::Core::Math
 		}
 
 
+		/// Returns the neighbours of node, in order of ID, without copying them. For directed graphs these are the
+		/// outgoing neighbours.
+		[[nodiscard]] const auto& Neighbours(NodeID node) const
+		{
+			static const typename GraphContainers<Config, Allocator>::NeighbourSet NONE;
+			auto neighbours = mEdgeStorage.mEdges.find(node);
+			return neighbours != mEdgeStorage.mEdges.end() ? neighbours->second : NONE;
+		}
+
+
 		[[nodiscard]] std::set<NodeID> GetNeighbours(NodeID node) const
 		{
-			std::set<NodeID> neighbours = mEdgeStorage.mEdges[node];
-			return neighbours;
+			const auto& neighbours = mEdgeStorage.mEdges[node];
+			return std::set<NodeID>(neighbours.begin(), neighbours.end());
 		}
 
 
@@ -380,17 +505,16 @@ namespace Strawberry::Core::Math
 
 		[[nodiscard]] std::set<NodeID> GetOutgoingNeighbours(NodeID node) const requires (Config::Directed)
 		{
-			return mEdgeStorage.mEdges[node];
+			const auto& neighbours = mEdgeStorage.mEdges[node];
+			return std::set<NodeID>(neighbours.begin(), neighbours.end());
 		}
 
 
 	private:
-		/// Incrementing counter for generating node IDs
-		NodeID mNextID = 0;
 		/// The map of nodes, associates node ids to values.
-		std::map<NodeID, Value> mNodes;
+		NodeStorage<Config, Value, Allocator> mNodes;
 		/// The set of edges in this graph.
-		GraphEdgeStorage<Config> mEdgeStorage;
+		GraphEdgeStorage<Config, Allocator> mEdgeStorage;
 	};
 
 
@@ -407,22 +531,36 @@ namespace Strawberry::Core::Math
 		static constexpr bool Weighted = true;
 		using WeightType = unsigned int;
 		static constexpr bool Directed = Config::Directed;
+		static constexpr bool DenseNodes = HasDenseNodes<Config>;
+	};
+
+
+	template <typename _graph>
+	using WeightedGraph = Graph<typename _graph::Value, WeightedGraphConfig<typename _graph::Config>, typename _graph::Allocator>;
+
+
+	/// Stores the nodes of a graph densely in a SlotMap. Node IDs of removed nodes are reused.
+	template <GraphConfig Config>
+	struct DenseGraphConfig
+		: Config
+	{
+		static constexpr bool DenseNodes = true;
 	};
 
 
 	template <typename _graph>
-	using WeightedGraph = Graph<typename _graph::Value, WeightedGraphConfig<typename _graph::Config>>;
+	using DenseGraph = Graph<typename _graph::Value, DenseGraphConfig<typename _graph::Config>, typename _graph::Allocator>;
 
 
-	template <typename T, GraphConfig Config>
+	template <typename T, GraphConfig Config, typename Allocator = std::allocator<T>>
 	class VectorGraph;
 
-	template <typename T, unsigned int D, GraphConfig Config>
-	class VectorGraph<Vector<T, D>, Config>
-		: public Graph<Vector<T, D>, Config>
+	template <typename T, size_t D, GraphConfig Config, typename Allocator>
+	class VectorGraph<Vector<T, D>, Config, Allocator>
+		: public Graph<Vector<T, D>, Config, Allocator>
 	{
 	public:
-		using Graph<Vector<T, D>, Config>::Graph;
+		using Graph<Vector<T, D>, Config, Allocator>::Graph;
 
 
 
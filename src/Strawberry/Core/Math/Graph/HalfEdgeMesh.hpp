@@ -0,0 +1,284 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+#include "Strawberry/Core/Types/Optional.hpp"
+// Standard Library
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <vector>
+
+
+namespace Strawberry::Core::Math
+{
+	/// Polygonal mesh stored as half edges (a doubly connected edge list).
+	///
+	/// Every edge is split into two half edges running in opposite directions, and each half edge knows its twin, the
+	/// next and previous half edges around its face, and the vertex it starts at. Each face and vertex knows one of its
+	/// half edges. This makes every adjacency query O(1), and walking around a face or a vertex O(its degree).
+	///
+	/// Faces are counter clockwise loops of half edges. The outside of the mesh, and any holes in it, are made of
+	/// boundary half edges, whose face is NONE, and which are linked into loops of their own, so every half edge has a
+	/// twin and a next half edge.
+	///
+	/// The mesh is immutable once built.
+	template <typename _value, std::unsigned_integral _index = unsigned int>
+	class HalfEdgeMesh
+	{
+	public:
+		using Value = _value;
+		using Index = _index;
+
+
+		static constexpr Index NONE = std::numeric_limits<Index>::max();
+
+
+		HalfEdgeMesh() = default;
+
+
+		/// Builds a mesh from its vertices and faces. Each face is a range of at least 3 indices into vertices, in
+		/// counter clockwise order, and faces which share an edge must traverse it in opposite directions.
+		template <std::ranges::input_range Faces>
+			requires (std::ranges::input_range<std::ranges::range_reference_t<Faces>>)
+		HalfEdgeMesh(std::vector<Value> vertices, Faces&& faces)
+			: mValues(std::move(vertices))
+			, mVertexHalfEdges(mValues.size(), NONE)
+		{
+			for (auto&& face : faces)
+			{
+				const Index first = HalfEdgeCount();
+				const Index index = FaceCount();
+				for (auto vertex : face)
+				{
+					Assert(vertex < VertexCount(), "Face refers to a vertex which is not in the mesh!");
+					mHalfEdges.emplace_back(HalfEdge{.origin = static_cast<Index>(vertex), .face = index});
+				}
+
+				const Index count = HalfEdgeCount() - first;
+				Assert(count >= 3, "Attempt to create a face with fewer than 3 vertices!");
+				for (Index i = 0; i < count; i++)
+				{
+					mHalfEdges[first + i].next = first + (i + 1) % count;
+					mHalfEdges[first + i].prev = first + (i + count - 1) % count;
+				}
+				mFaceHalfEdges.emplace_back(first);
+			}
+
+			LinkTwins();
+			LinkBoundaries();
+
+			// Boundary half edges are preferred, so that walking around a vertex from its half edge visits every edge.
+			for (Index halfEdge = 0; halfEdge < HalfEdgeCount(); halfEdge++)
+			{
+				Index& vertexHalfEdge = mVertexHalfEdges[Origin(halfEdge)];
+				if (vertexHalfEdge == NONE || IsBoundary(halfEdge)) vertexHalfEdge = halfEdge;
+			}
+		}
+
+
+		[[nodiscard]] Index VertexCount() const noexcept { return static_cast<Index>(mValues.size()); }
+		[[nodiscard]] Index FaceCount() const noexcept { return static_cast<Index>(mFaceHalfEdges.size()); }
+		[[nodiscard]] Index HalfEdgeCount() const noexcept { return static_cast<Index>(mHalfEdges.size()); }
+		[[nodiscard]] Index EdgeCount() const noexcept { return HalfEdgeCount() / 2; }
+
+
+		[[nodiscard]] const Value& GetValue(Index vertex) const { return mValues[vertex]; }
+		[[nodiscard]] std::span<const Value> Values() const noexcept { return mValues; }
+
+
+		/// The vertex a half edge starts from, and the one it points to.
+		[[nodiscard]] Index Origin(Index halfEdge) const { return mHalfEdges[halfEdge].origin; }
+		[[nodiscard]] Index Target(Index halfEdge) const { return Origin(Twin(halfEdge)); }
+		/// The half edge running the other way along the same edge.
+		[[nodiscard]] Index Twin(Index halfEdge) const { return mHalfEdges[halfEdge].twin; }
+		/// The half edges after and before this one around its face, or around its boundary loop.
+		[[nodiscard]] Index Next(Index halfEdge) const { return mHalfEdges[halfEdge].next; }
+		[[nodiscard]] Index Prev(Index halfEdge) const { return mHalfEdges[halfEdge].prev; }
+		/// The face to the left of a half edge, or NONE for boundary half edges.
+		[[nodiscard]] Index Face(Index halfEdge) const { return mHalfEdges[halfEdge].face; }
+		[[nodiscard]] bool IsBoundary(Index halfEdge) const { return Face(halfEdge) == NONE; }
+
+
+		/// Returns one of the half edges of face.
+		[[nodiscard]] Index FaceHalfEdge(Index face) const { return mFaceHalfEdges[face]; }
+
+
+		/// Returns a half edge starting from vertex, or NONE if it has no edges. Boundary half edges are preferred.
+		[[nodiscard]] Index VertexHalfEdge(Index vertex) const { return mVertexHalfEdges[vertex]; }
+
+
+		/// Returns whether an edge is on the outside of the mesh, or of a hole in it.
+		[[nodiscard]] bool IsBoundaryEdge(Index halfEdge) const
+		{
+			return IsBoundary(halfEdge) || IsBoundary(Twin(halfEdge));
+		}
+
+
+		/// Returns the half edge from a to b, if there is one. This is O(the degree of a).
+		[[nodiscard]] Optional<Index> FindHalfEdge(Index a, Index b) const
+		{
+			Optional<Index> found;
+			ForEachOutgoingHalfEdge(a, [&] (Index halfEdge)
+			{
+				if (Target(halfEdge) == b) found = halfEdge;
+			});
+			return found;
+		}
+
+
+		/// Calls function with each half edge of face, in counter clockwise order.
+		template <std::invocable<Index> F>
+		void ForEachFaceHalfEdge(Index face, F&& function) const
+		{
+			const Index first = FaceHalfEdge(face);
+			Index halfEdge = first;
+			do
+			{
+				std::invoke(function, halfEdge);
+				halfEdge = Next(halfEdge);
+			}
+			while (halfEdge != first);
+		}
+
+
+		/// Calls function with each vertex of face, in counter clockwise order.
+		template <std::invocable<Index> F>
+		void ForEachFaceVertex(Index face, F&& function) const
+		{
+			ForEachFaceHalfEdge(face, [&] (Index halfEdge) { std::invoke(function, Origin(halfEdge)); });
+		}
+
+
+		/// Calls function with each face which shares an edge with face. Faces sharing several edges are repeated.
+		template <std::invocable<Index> F>
+		void ForEachAdjacentFace(Index face, F&& function) const
+		{
+			ForEachFaceHalfEdge(face, [&] (Index halfEdge)
+			{
+				if (Index other = Face(Twin(halfEdge)); other != NONE) std::invoke(function, other);
+			});
+		}
+
+
+		/// Calls function with each half edge starting from vertex, in clockwise order.
+		///
+		/// Where several fans of faces only meet at vertex, only the fan containing VertexHalfEdge(vertex) is visited.
+		template <std::invocable<Index> F>
+		void ForEachOutgoingHalfEdge(Index vertex, F&& function) const
+		{
+			const Index first = VertexHalfEdge(vertex);
+			if (first == NONE) return;
+
+			Index halfEdge = first;
+			do
+			{
+				std::invoke(function, halfEdge);
+				halfEdge = Next(Twin(halfEdge));
+			}
+			while (halfEdge != first);
+		}
+
+
+		/// Calls function with each vertex joined to vertex by an edge, in clockwise order.
+		template <std::invocable<Index> F>
+		void ForEachNeighbour(Index vertex, F&& function) const
+		{
+			ForEachOutgoingHalfEdge(vertex, [&] (Index halfEdge) { std::invoke(function, Target(halfEdge)); });
+		}
+
+
+		/// Returns a view of the boundary half edges. Those on the outside of the mesh run clockwise around it.
+		[[nodiscard]] auto BoundaryHalfEdges() const noexcept
+		{
+			return std::views::iota(Index(0), HalfEdgeCount())
+				| std::views::filter([this] (Index halfEdge) { return IsBoundary(halfEdge); });
+		}
+
+
+	private:
+		struct HalfEdge
+		{
+			Index origin = NONE;
+			Index twin   = NONE;
+			Index next   = NONE;
+			Index prev   = NONE;
+			Index face   = NONE;
+		};
+
+
+		/// Pairs up half edges running in opposite directions. Sorting the half edges by their vertices, in either
+		/// order, puts the two half edges of each edge next to each other. Half edges left without a twin get a boundary
+		/// half edge as their twin.
+		void LinkTwins()
+		{
+			using Key = std::tuple<Index, Index, Index>;
+
+			const Index faceHalfEdgeCount = HalfEdgeCount();
+			std::vector<Key> keys;
+			keys.reserve(faceHalfEdgeCount);
+			for (Index halfEdge = 0; halfEdge < faceHalfEdgeCount; halfEdge++)
+			{
+				const Index from = Origin(halfEdge), to = Origin(Next(halfEdge));
+				keys.emplace_back(std::min(from, to), std::max(from, to), halfEdge);
+			}
+			std::ranges::sort(keys);
+
+			auto sameEdge = [&] (size_t i, size_t j)
+			{
+				return j < keys.size() && std::get<0>(keys[i]) == std::get<0>(keys[j]) && std::get<1>(keys[i]) == std::get<1>(keys[j]);
+			};
+
+			for (size_t i = 0; i < keys.size(); i++)
+			{
+				const Index halfEdge = std::get<2>(keys[i]);
+				if (sameEdge(i, i + 1))
+				{
+					const Index twin = std::get<2>(keys[i + 1]);
+					Assert(Origin(halfEdge) != Origin(twin) && !sameEdge(i, i + 2),
+						   "Edge is shared by more than two faces, or by two faces in the same direction!");
+					mHalfEdges[halfEdge].twin = twin;
+					mHalfEdges[twin].twin     = halfEdge;
+					i++;
+				}
+				else
+				{
+					const Index boundary = HalfEdgeCount();
+					mHalfEdges.emplace_back(HalfEdge{.origin = Origin(Next(halfEdge)), .twin = halfEdge});
+					mHalfEdges[halfEdge].twin = boundary;
+				}
+			}
+		}
+
+
+		/// Links the boundary half edges into loops. The boundary half edge following one which ends at a vertex is
+		/// found by turning counter clockwise around that vertex, through the faces, until the boundary is reached.
+		void LinkBoundaries()
+		{
+			for (Index boundary = 0; boundary < HalfEdgeCount(); boundary++)
+			{
+				if (!IsBoundary(boundary)) continue;
+
+				Index halfEdge = Twin(boundary);
+				while (!IsBoundary(halfEdge))
+				{
+					halfEdge = Twin(Prev(halfEdge));
+				}
+
+				mHalfEdges[boundary].next = halfEdge;
+				mHalfEdges[halfEdge].prev = boundary;
+			}
+		}
+
+
+		std::vector<Value>    mValues;
+		std::vector<HalfEdge> mHalfEdges;
+		/// A half edge of each face.
+		std::vector<Index>    mFaceHalfEdges;
+		/// A half edge starting from each vertex, or NONE for vertices without edges.
+		std::vector<Index>    mVertexHalfEdges;
+	};
+}
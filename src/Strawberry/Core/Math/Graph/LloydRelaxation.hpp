@@ -0,0 +1,292 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Math/Geometry/Predicates.hpp"
+#include "Strawberry/Core/Math/Graph/Delauney.hpp"
+#include "Strawberry/Core/Math/Vector.hpp"
+#include "Strawberry/Core/Thread/ThreadPool.hpp"
+#include "Strawberry/Core/Types/Optional.hpp"
+// Standard Library
+#include <algorithm>
+#include <cmath>
+#include <memory_resource>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+
+namespace Strawberry::Core::Math
+{
+	/// Base template.
+	template <typename T>
+	class LloydRelaxation;
+
+
+	/// Lloyd relaxation of a set of points within a bounding box, which moves each point towards the center of mass of
+	/// its Voronoi cell every iteration.
+	///
+	/// The triangulation of the points is kept between iterations. As the points only move a little each time, it is
+	/// repaired by flipping edges rather than built again, and each cell is read straight from the triangles around
+	/// its point, so no Delaunay or Voronoi graph is made.
+	template <typename T>
+	class LloydRelaxation<Vector<T, 2>>
+	{
+	public:
+		using Delaunay = Delaunay<Vector<T, 2>>;
+		using NodeID = Delaunay::NodeID;
+
+
+		/// Prepares to relax the given points, which are clamped to bounds.
+		template <std::ranges::range Range>
+		LloydRelaxation(const AABB<T, 2>& bounds, Range&& points)
+			: mBounds(bounds)
+		{
+			// The supporting nodes make a triangle far enough around the bounds that no point of the bounds is nearer
+			// to one of them than to the points, so clipping the cells to the bounds gives their true shape.
+			const Vector<T, 2> center = bounds.Center();
+			const T radius = 4 * static_cast<T>(bounds.Span().Magnitude());
+			mPoints.emplace_back(center + radius * Vector<T, 2>(0, 1));
+			mPoints.emplace_back(center + radius * Vector<T, 2>(static_cast<T>(-0.866025403784438647), static_cast<T>(-0.5)));
+			mPoints.emplace_back(center + radius * Vector<T, 2>(static_cast<T>(0.866025403784438647), static_cast<T>(-0.5)));
+
+			for (const auto& point : std::forward<Range>(points))
+			{
+				mPoints.emplace_back(mBounds.Clamp(Vector<T, 2>(point)));
+			}
+
+			Triangulate();
+		}
+
+
+		/// The triangulation refers to the points by address, so relaxations stay where they were made.
+		LloydRelaxation(const LloydRelaxation&) = delete;
+		LloydRelaxation& operator=(const LloydRelaxation&) = delete;
+
+
+		/// Runs up to iterationCount iterations, each moving every point by strength times the distance to the center of
+		/// mass of its cell. Stops early once no point moves further than tolerance in an iteration. Returns the number
+		/// of iterations run.
+		unsigned int Relax(unsigned int iterationCount, double strength = 1.0, T tolerance = 0)
+		{
+			auto forEach = [] (size_t count, auto&& function)
+			{
+				for (size_t i = 0; i < count; i++)
+				{
+					function(i);
+				}
+			};
+
+			return Run(forEach, iterationCount, strength, tolerance);
+		}
+
+
+		/// Runs the iterations as above, finding the cells and their centers of mass on the threads of pool. The results
+		/// are the same as without one.
+		unsigned int Relax(ThreadPool& pool, unsigned int iterationCount, double strength = 1.0, T tolerance = 0)
+		{
+			auto forEach = [&pool] (size_t count, auto&& function)
+			{
+				pool.ParallelFor(std::views::iota(size_t(0), count), function);
+			};
+
+			return Run(forEach, iterationCount, strength, tolerance);
+		}
+
+
+		/// The points, in the order they were given.
+		std::span<const Vector<T, 2>> Points() const noexcept
+		{
+			return std::span(mPoints).subspan(3);
+		}
+
+
+	private:
+		using Builder = Delaunay::Builder;
+		using Triangulation = Builder::Triangulation;
+		using Triangle = Builder::Triangle;
+
+
+		template <typename ForEach>
+		unsigned int Run(ForEach&& forEach, unsigned int iterationCount, double strength, T tolerance)
+		{
+			unsigned int iteration = 0;
+			while (iteration < iterationCount)
+			{
+				const T displacement = Step(forEach, strength);
+				iteration++;
+
+				if (displacement <= tolerance) break;
+			}
+			return iteration;
+		}
+
+
+		/// Moves each point towards the center of mass of its cell, then brings the triangulation up to date. Returns
+		/// the furthest any point moved.
+		template <typename ForEach>
+		T Step(ForEach& forEach, double strength)
+		{
+			const std::vector<Triangle>& triangles = mTriangulation->Triangles();
+
+			mCircumcenters.resize(triangles.size());
+			forEach(triangles.size(), [&] (size_t triangle)
+			{
+				const auto& [a, b, c] = triangles[triangle].nodes;
+				mCircumcenters[triangle] = Delaunay::MakeCircumcircle(mPoints[a], mPoints[b], mPoints[c]).center;
+			});
+
+			mNodeTriangles.resize(mPoints.size());
+			for (NodeID triangle = 0; triangle < triangles.size(); triangle++)
+			{
+				for (NodeID node : triangles[triangle].nodes)
+				{
+					mNodeTriangles[node] = triangle;
+				}
+			}
+
+			mNextPoints.resize(mPoints.size());
+			std::copy_n(mPoints.begin(), 3, mNextPoints.begin());
+			forEach(mPoints.size() - 3, [&] (size_t i)
+			{
+				const NodeID node = static_cast<NodeID>(i + 3);
+				const Vector<T, 2>& point = mPoints[node];
+				const Vector<T, 2> target = point + static_cast<T>(strength) * (CellCenterOfMass(node) - point);
+				mNextPoints[node] = mBounds.Clamp(target);
+			});
+
+			T displacementSquared = 0;
+			for (NodeID node = 3; node < mPoints.size(); node++)
+			{
+				displacementSquared = std::max(displacementSquared, (mNextPoints[node] - mPoints[node]).SquareMagnitude());
+			}
+
+			// The triangulation refers to mPoints, so it sees the new points once they are swapped in.
+			std::swap(mPoints, mNextPoints);
+			UpdateTriangulation();
+
+			return std::sqrt(displacementSquared);
+		}
+
+
+		/// Brings the triangulation up to date with the points, which have moved from where they are in mNextPoints.
+		/// Flips cannot untangle triangles which have turned over, so the points which turned them over are held back
+		/// where they were while the rest are repaired, then taken out and inserted again where they are going.
+		void UpdateTriangulation()
+		{
+			const std::vector<Triangle>& triangles = mTriangulation->Triangles();
+
+			mHeldBack.clear();
+			bool turnedOver = true;
+			while (turnedOver)
+			{
+				turnedOver = false;
+				for (const Triangle& triangle : triangles)
+				{
+					const auto& [a, b, c] = triangle.nodes;
+					if (Orient2D(mPoints[a], mPoints[b], mPoints[c]) > 0) continue;
+
+					// Every triangle was the right way around before the points moved, so this always holds one back.
+					for (NodeID node : triangle.nodes)
+					{
+						if (mPoints[node] == mNextPoints[node]) continue;
+
+						mHeldBack.emplace_back(node, mPoints[node]);
+						mPoints[node] = mNextPoints[node];
+					}
+					turnedOver = true;
+				}
+			}
+
+			bool updated = mTriangulation->Repair();
+			for (auto held = mHeldBack.begin(); updated && held != mHeldBack.end(); ++held)
+			{
+				updated = mTriangulation->Remove(held->first);
+				mPoints[held->first] = held->second;
+				if (updated) mTriangulation->Insert(held->first);
+			}
+
+			if (!updated)
+			{
+				for (const auto& [node, point] : mHeldBack)
+				{
+					mPoints[node] = point;
+				}
+				Triangulate();
+			}
+		}
+
+
+		/// Returns the center of mass of the cell of node, clipped to the bounds.
+		Vector<T, 2> CellCenterOfMass(NodeID node) const
+		{
+			thread_local std::vector<Vector<T, 2>> cell, clipped;
+
+			// The circumcenters of the triangles around node, in counter clockwise order, are the corners of its cell.
+			// The supporting nodes surround every point, so the triangles always go all the way around.
+			const std::vector<Triangle>& triangles = mTriangulation->Triangles();
+			cell.clear();
+			const NodeID first = mNodeTriangles[node];
+			NodeID triangle = first;
+			do
+			{
+				cell.emplace_back(mCircumcenters[triangle]);
+
+				const Triangle& current = triangles[triangle];
+				const unsigned int i = std::ranges::find(current.nodes, node) - current.nodes.begin();
+				triangle = current.neighbours[(i + 1) % 3];
+			}
+			while (triangle != first);
+
+			if (!std::ranges::all_of(cell, [this] (const Vector<T, 2>& corner) { return mBounds.Contains(corner); }))
+			{
+				for (unsigned int side = 0; side < 4; side++)
+				{
+					mBounds.ClipToSide(cell, clipped, side);
+					std::swap(cell, clipped);
+				}
+			}
+
+			// Corners are taken relative to the point, which keeps the sums small.
+			const Vector<T, 2>& origin = mPoints[node];
+			T doubleArea = 0;
+			Vector<T, 2> weightedSum;
+			for (size_t i = 0; i < cell.size(); i++)
+			{
+				const Vector<T, 2> a = cell[i] - origin, b = cell[(i + 1) % cell.size()] - origin;
+				const T cross = a.DotPerp(b);
+				doubleArea += cross;
+				weightedSum = weightedSum + cross * (a + b);
+			}
+
+			return origin + (1 / (3 * doubleArea)) * weightedSum;
+		}
+
+
+		/// Triangulates the points from scratch.
+		void Triangulate()
+		{
+			mTriangulation.Emplace(mPoints);
+
+			auto nodes = std::views::iota(NodeID(3), static_cast<NodeID>(mPoints.size()));
+			for (NodeID node : Builder::InsertionOrder(mBounds, mPoints, nodes, std::pmr::new_delete_resource()))
+			{
+				mTriangulation->Insert(node);
+			}
+		}
+
+
+		/// The box the points are kept within.
+		AABB<T, 2>                 mBounds;
+		/// The value of each node, starting with the three supporting nodes.
+		std::vector<Vector<T, 2>>  mPoints;
+		/// The triangulation of mPoints.
+		Optional<Triangulation>    mTriangulation;
+		/// The circumcenter of each triangle, and a triangle with each node, for the current iteration.
+		std::vector<Vector<T, 2>>  mCircumcenters;
+		std::vector<NodeID>        mNodeTriangles;
+		/// The points being made by the current iteration. Kept to reuse their memory.
+		std::vector<Vector<T, 2>>  mNextPoints;
+		/// The points held back from moving while the triangulation is repaired, with where they are going.
+		std::vector<std::pair<NodeID, Vector<T, 2>>> mHeldBack;
+	};
+}
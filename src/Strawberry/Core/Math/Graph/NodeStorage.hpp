@@ -0,0 +1,129 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Util/SlotMap.hpp"
+// Standard Library
+#include <functional>
+#include <map>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+namespace Strawberry::Core::Math
+{
+	/// Returns whether a Graph or Tree config asks for its nodes to be stored densely, in a SlotMap.
+	template <typename Config>
+	constexpr bool HasDenseNodes = requires { requires Config::DenseNodes; };
+
+
+	/// Node storage which keeps values in a map, ordered by node ID. IDs increase monotonically and are never reused.
+	template <std::integral NodeID, typename Value, typename Allocator>
+	class MapNodeStorage
+	{
+	public:
+		explicit MapNodeStorage(const Allocator& allocator = Allocator())
+			: mValues(allocator)
+		{}
+
+
+		template <typename T>
+		NodeID Insert(T&& value)
+		{
+			mValues.emplace(mNextID, std::forward<T>(value));
+			return mNextID++;
+		}
+
+
+		      Value& at(NodeID id)       { return mValues.at(id); }
+		const Value& at(NodeID id) const { return mValues.at(id); }
+		bool contains(NodeID id) const { return mValues.contains(id); }
+		void erase(NodeID id) { mValues.erase(id); }
+		size_t size() const noexcept { return mValues.size(); }
+
+
+		/// Pairs of IDs and values, in order of ID.
+		auto Entries() const noexcept { return std::views::all(mValues); }
+		auto IDs() const noexcept { return mValues | std::views::keys; }
+		auto Values() const noexcept { return mValues | std::views::values; }
+
+
+	private:
+		template <typename T>
+		using Rebind = std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+
+		NodeID                                                                           mNextID = 0;
+		std::map<NodeID, Value, std::less<NodeID>, Rebind<std::pair<const NodeID, Value>>> mValues;
+	};
+
+
+	/// Node storage which keeps values packed in a SlotMap, whose slot indices are the node IDs.
+	///
+	/// Lookups are O(1) and iteration is over contiguous memory, but the IDs of removed nodes are reused, and
+	/// iteration is not in order of ID.
+	template <std::integral NodeID, typename Value, typename Allocator>
+	class DenseNodeStorage
+	{
+	public:
+		explicit DenseNodeStorage(const Allocator& allocator = Allocator())
+			: mValues(allocator)
+		{}
+
+
+		template <typename T>
+		NodeID Insert(T&& value)
+		{
+			return static_cast<NodeID>(mValues.Emplace(std::forward<T>(value)).index);
+		}
+
+
+		      Value& at(NodeID id)       { return mValues[Handle(id)]; }
+		const Value& at(NodeID id) const { return mValues[Handle(id)]; }
+		bool contains(NodeID id) const { return mValues.HandleOf(static_cast<uint32_t>(id)).HasValue(); }
+		void erase(NodeID id) { if (contains(id)) mValues.Erase(Handle(id)); }
+		size_t size() const noexcept { return mValues.Size(); }
+
+
+		/// Pairs of IDs and values, in storage order.
+		auto Entries() const noexcept
+		{
+			return std::views::iota(size_t(0), mValues.Size())
+				| std::views::transform([this] (size_t i)
+				{
+					return std::pair<NodeID, const Value&>(static_cast<NodeID>(mValues.HandleAt(i).index), mValues.Values()[i]);
+				});
+		}
+
+
+		auto IDs() const noexcept
+		{
+			return std::views::iota(size_t(0), mValues.Size())
+				| std::views::transform([this] (size_t i) { return static_cast<NodeID>(mValues.HandleAt(i).index); });
+		}
+
+
+		auto Values() const noexcept { return std::views::all(mValues.Values()); }
+
+
+	private:
+		typename SlotMap<Value, Allocator>::Handle Handle(NodeID id) const
+		{
+			// Missing IDs throw, as they do for MapNodeStorage.
+			auto handle = mValues.HandleOf(static_cast<uint32_t>(id));
+			if (!handle) throw std::out_of_range("Accessed a node which does not exist!");
+			return *handle;
+		}
+
+
+		SlotMap<Value, Allocator> mValues;
+	};
+
+
+	template <typename Config, typename Value, typename Allocator>
+	using NodeStorage = std::conditional_t<
+		HasDenseNodes<Config>,
+		DenseNodeStorage<typename Config::NodeID, Value, Allocator>,
+		MapNodeStorage<typename Config::NodeID, Value, Allocator>>;
+}
@@ -0,0 +1,316 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+#include "Strawberry/Core/Math/Graph/CSRGraph.hpp"
+#include "Strawberry/Core/Math/Math.hpp"
+#include "Strawberry/Core/Thread/ThreadPool.hpp"
+#include "Strawberry/Core/Types/Optional.hpp"
+#include "Strawberry/Core/Util/DisjointSets.hpp"
+// Standard Library
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <vector>
+
+
+namespace Strawberry::Core::Math
+{
+	/// Level synchronous breadth first search over a CSRGraph, which expands each level in parallel on a ThreadPool.
+	///
+	/// The search is direction optimising: while the frontier is small, each frontier node claims its unvisited
+	/// neighbours (top down), but once the edges out of the frontier outnumber those out of the unvisited nodes by
+	/// topDownToBottomUpRatio, each unvisited node instead looks for any neighbour in the frontier, and stops at the
+	/// first (bottom up), which skips most of the edges of a large frontier. It returns to top down once the frontier
+	/// shrinks below NodeCount / bottomUpToTopDownRatio. Directed graphs search bottom up along incoming edges.
+	///
+	/// The buffers are kept between searches, so a search object which is reused does not allocate once it has grown.
+	template <std::unsigned_integral NodeID = unsigned int>
+	class ParallelBreadthFirstSearch
+	{
+	public:
+		static constexpr NodeID NONE = std::numeric_limits<NodeID>::max();
+
+
+		/// Edges out of the frontier must exceed edges out of unvisited nodes divided by this to switch to bottom up.
+		size_t topDownToBottomUpRatio = 14;
+		/// The frontier must be smaller than the node count divided by this to switch back to top down.
+		size_t bottomUpToTopDownRatio = 24;
+
+
+		/// Searches graph from source. Afterwards the depth and parent of each node reached are available.
+		template <typename Value, GraphConfig Config> requires (std::same_as<typename Config::NodeID, NodeID>)
+		void Run(ThreadPool& pool, const CSRGraph<Value, Config>& graph, NodeID source)
+		{
+			ZoneScoped;
+
+			Assert(graph.ContainsNode(source), "Searched from a node which is not in the graph!");
+			const size_t nodeCount = graph.NodeCount();
+
+			mDepths.assign(nodeCount, NONE);
+			mParents.assign(nodeCount, NONE);
+			mFrontier.assign(1, source);
+			mDepths[source]  = 0;
+			mParents[source] = source;
+			mTopDownLevels   = 0;
+			mBottomUpLevels  = 0;
+
+			// The edges out of nodes which have not been in a top down frontier yet. Nodes visited bottom up are not
+			// subtracted, which only delays switching to bottom up again, as a frontier of them is never counted.
+			size_t unvisitedEdges = graph.EdgeCount() * (Config::Directed ? 1 : 2);
+
+			bool   bottomUp     = false;
+			NodeID depth        = 0;
+			size_t frontierSize = 1;
+			while (frontierSize > 0)
+			{
+				// The frontier is a list while searching top down, and a bitmap while searching bottom up.
+				if (!bottomUp)
+				{
+					const size_t frontierEdges = FrontierEdges(pool, graph);
+					unvisitedEdges -= std::min(unvisitedEdges, frontierEdges);
+					if (frontierEdges * topDownToBottomUpRatio > unvisitedEdges)
+					{
+						bottomUp = true;
+						ListToBitmap(pool, nodeCount);
+					}
+				}
+				else if (frontierSize * bottomUpToTopDownRatio < nodeCount)
+				{
+					bottomUp = false;
+					BitmapToList(nodeCount);
+				}
+
+				depth++;
+				if (bottomUp)
+				{
+					frontierSize = StepBottomUp(pool, graph, depth);
+					mBottomUpLevels++;
+				}
+				else
+				{
+					frontierSize = StepTopDown(pool, graph, depth);
+					mTopDownLevels++;
+				}
+			}
+		}
+
+
+		[[nodiscard]] bool IsReached(NodeID node) const noexcept
+		{
+			return node < mDepths.size() && mDepths[node] != NONE;
+		}
+
+
+		/// Returns the number of edges on a shortest path from the source to node.
+		[[nodiscard]] NodeID GetDepth(NodeID node) const noexcept
+		{
+			Assert(IsReached(node), "Asked for the depth of a node which was not reached!");
+			return mDepths[node];
+		}
+
+
+		/// Returns the node before node on a shortest path from the source to it, or nothing for the source.
+		[[nodiscard]] Optional<NodeID> GetParent(NodeID node) const noexcept
+		{
+			Assert(IsReached(node), "Asked for the parent of a node which was not reached!");
+			if (mParents[node] == node) return NullOpt;
+			return mParents[node];
+		}
+
+
+		/// The depth of every node, which is NONE for nodes which were not reached.
+		[[nodiscard]] std::span<const NodeID> Depths() const noexcept { return mDepths; }
+
+
+		/// The number of levels of the last search which were expanded in each direction.
+		[[nodiscard]] size_t TopDownLevels() const noexcept { return mTopDownLevels; }
+		[[nodiscard]] size_t BottomUpLevels() const noexcept { return mBottomUpLevels; }
+
+
+	private:
+		/// The number of frontier nodes, or of nodes, each task handles.
+		static constexpr size_t GRAIN_SIZE = 1024;
+
+
+		/// Returns the number of tasks which process count items in grains.
+		static size_t TaskCount(size_t count) noexcept
+		{
+			return Math::CeilDiv(count, GRAIN_SIZE);
+		}
+
+
+		template <typename Graph>
+		size_t FrontierEdges(ThreadPool& pool, const Graph& graph) const
+		{
+			return pool.ParallelReduce(
+				mFrontier | std::views::transform([&] (NodeID node) { return graph.Degree(node); }),
+				size_t(0), std::plus{}, GRAIN_SIZE);
+		}
+
+
+		/// Expands each node in the frontier list, claiming its unvisited neighbours with compare and swap. Each task
+		/// collects the nodes it claims into a buffer of its own, and the buffers are joined into the next frontier.
+		template <typename Graph>
+		size_t StepTopDown(ThreadPool& pool, const Graph& graph, NodeID depth)
+		{
+			const size_t taskCount = TaskCount(mFrontier.size());
+			if (mTaskFrontiers.size() < taskCount) mTaskFrontiers.resize(taskCount);
+
+			pool.ParallelFor(std::views::iota(size_t(0), taskCount), [&] (size_t task)
+			{
+				auto& next = mTaskFrontiers[task];
+				next.clear();
+
+				const size_t last = std::min(mFrontier.size(), (task + 1) * GRAIN_SIZE);
+				for (size_t i = task * GRAIN_SIZE; i < last; i++)
+				{
+					const NodeID node = mFrontier[i];
+					for (NodeID neighbour : graph.GetNeighbours(node))
+					{
+						std::atomic_ref parent(mParents[neighbour]);
+						NodeID expected = NONE;
+						if (parent.load(std::memory_order::relaxed) == NONE
+							&& parent.compare_exchange_strong(expected, node, std::memory_order::relaxed))
+						{
+							mDepths[neighbour] = depth;
+							next.emplace_back(neighbour);
+						}
+					}
+				}
+			}, 1);
+
+			mFrontier.clear();
+			for (size_t task = 0; task < taskCount; task++)
+			{
+				mFrontier.insert(mFrontier.end(), mTaskFrontiers[task].begin(), mTaskFrontiers[task].end());
+			}
+			return mFrontier.size();
+		}
+
+
+		/// Has each unvisited node look for a neighbour in the frontier bitmap. Each node is only written by the task
+		/// which owns it, so no atomics are needed, and tasks own whole bytes of the bitmap.
+		template <typename Value, GraphConfig Config>
+		size_t StepBottomUp(ThreadPool& pool, const CSRGraph<Value, Config>& graph, NodeID depth)
+		{
+			const size_t nodeCount = graph.NodeCount();
+			const size_t taskCount = TaskCount(nodeCount);
+			mNextBitmap.assign(nodeCount, 0);
+			mTaskCounts.assign(taskCount, 0);
+
+			pool.ParallelFor(std::views::iota(size_t(0), taskCount), [&] (size_t task)
+			{
+				size_t       claimed = 0;
+				const size_t last    = std::min(nodeCount, (task + 1) * GRAIN_SIZE);
+				for (size_t node = task * GRAIN_SIZE; node < last; node++)
+				{
+					if (mParents[node] != NONE) continue;
+
+					auto neighbours = [&]
+					{
+						if constexpr (Config::Directed) return graph.GetIncomingNeighbours(node);
+						else return graph.GetNeighbours(node);
+					}();
+
+					for (NodeID neighbour : neighbours)
+					{
+						if (mBitmap[neighbour])
+						{
+							mParents[node]    = neighbour;
+							mDepths[node]     = depth;
+							mNextBitmap[node] = 1;
+							claimed++;
+							break;
+						}
+					}
+				}
+				mTaskCounts[task] = claimed;
+			}, 1);
+
+			std::swap(mBitmap, mNextBitmap);
+			return std::reduce(mTaskCounts.begin(), mTaskCounts.end());
+		}
+
+
+		void ListToBitmap(ThreadPool& pool, size_t nodeCount)
+		{
+			mBitmap.assign(nodeCount, 0);
+			pool.ParallelFor(mFrontier, [&] (NodeID node) { mBitmap[node] = 1; }, GRAIN_SIZE);
+		}
+
+
+		void BitmapToList(size_t nodeCount)
+		{
+			mFrontier.clear();
+			for (size_t node = 0; node < nodeCount; node++)
+			{
+				if (mBitmap[node]) mFrontier.emplace_back(static_cast<NodeID>(node));
+			}
+		}
+
+
+		std::vector<NodeID>              mDepths;
+		/// The parent of each node, or NONE. The source is its own parent, so that it is never claimed.
+		std::vector<NodeID>              mParents;
+		std::vector<NodeID>              mFrontier;
+		std::vector<std::vector<NodeID>> mTaskFrontiers;
+		/// A byte rather than a bit per node, so that tasks never share a word.
+		std::vector<uint8_t>             mBitmap;
+		std::vector<uint8_t>             mNextBitmap;
+		/// The number of nodes each task claimed in a bottom up step.
+		std::vector<size_t>              mTaskCounts;
+		size_t                           mTopDownLevels  = 0;
+		size_t                           mBottomUpLevels = 0;
+	};
+
+
+	/// Labels each node with the index of its connected component, from 0, in order of the lowest node in each. For
+	/// directed graphs these are the weakly connected components. The labels match ConnectedComponents.
+	///
+	/// The edges are merged into a ConcurrentDisjointSets in parallel. Sets are linked towards their least element,
+	/// so each root is the lowest node of its component, and numbering the roots in order gives the labels.
+	///
+	/// @returns The number of components.
+	template <typename Value, GraphConfig Config, std::unsigned_integral NodeID = typename Config::NodeID>
+	size_t ParallelConnectedComponents(ThreadPool& pool, const CSRGraph<Value, Config>& graph, std::vector<NodeID>& labels, ConcurrentDisjointSets<NodeID>& sets)
+	{
+		ZoneScoped;
+
+		static constexpr size_t GRAIN_SIZE = 1024;
+
+		const size_t nodeCount = graph.NodeCount();
+		sets.Reset(nodeCount);
+		pool.ParallelFor(graph.NodeIndices(), [&] (NodeID node)
+		{
+			for (NodeID neighbour : graph.GetNeighbours(node))
+			{
+				// Undirected edges are stored in both directions, but only need merging once.
+				if (Config::Directed || node < neighbour) sets.Union(node, neighbour);
+			}
+		}, GRAIN_SIZE);
+
+		labels.resize(nodeCount);
+		pool.ParallelFor(graph.NodeIndices(), [&] (NodeID node) { labels[node] = sets.Find(node); }, GRAIN_SIZE);
+
+		// Roots precede the rest of their component, so their labels are known by the time the rest are relabelled.
+		size_t count = 0;
+		for (size_t node = 0; node < nodeCount; node++)
+		{
+			labels[node] = labels[node] == node ? static_cast<NodeID>(count++) : labels[labels[node]];
+		}
+		return count;
+	}
+
+
+	template <typename Value, GraphConfig Config, std::unsigned_integral NodeID = typename Config::NodeID>
+	size_t ParallelConnectedComponents(ThreadPool& pool, const CSRGraph<Value, Config>& graph, std::vector<NodeID>& labels)
+	{
+		ConcurrentDisjointSets<NodeID> sets;
+		return ParallelConnectedComponents(pool, graph, labels, sets);
+	}
+}
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "Strawberry/Core/Markers.hpp"
+#include "Strawberry/Core/Math/Graph/NodeStorage.hpp"
 #include <bitset>
 #include <concepts>
 #include <map>
+#include <memory>
 #include <vector>
 #include <algorithm>
 #include <set>
@@ -29,34 +31,59 @@ namespace Strawberry::Core::Math
 	&& (Config::Sorted == false || (Config::Ordered == true && requires { typename Config::SortingFunction; }));
 
 
-	template <typename T, TreeConfigType Config>
+	template <typename T, TreeConfigType Config, typename Allocator>
 	class Tree;
 
 
-	template <typename Value, TreeConfigType Config>
+	template <typename Value, TreeConfigType Config, typename Allocator>
 	struct TreeStorage;
 
 
-	template <typename Value, TreeConfigType Config> requires (Config::ChildCount == 0)
-	struct TreeStorage<Value, Config>
+	template <typename Value, TreeConfigType Config, typename Allocator> requires (Config::ChildCount == 0)
+	struct TreeStorage<Value, Config, Allocator>
 	{
-		std::map<typename Config::NodeID, Value>                                mValues;
-		std::map<typename Config::NodeID, std::vector<typename Config::NodeID>> childrenMap;
+		template <typename T>
+		using Rebind = std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+		using NodeID    = Config::NodeID;
+		using ChildList = std::vector<NodeID, Rebind<NodeID>>;
+
+
+		explicit TreeStorage(const Allocator& allocator)
+			: mValues(allocator)
+			, childrenMap(allocator)
+		{}
+
+
+		NodeStorage<Config, Value, Allocator>                                                          mValues;
+		std::map<NodeID, ChildList, std::less<NodeID>, Rebind<std::pair<const NodeID, ChildList>>> childrenMap;
 	};
 
 
-	template <typename Value, TreeConfigType Config> requires (Config::ChildCount > 0)
-	struct TreeStorage<Value, Config>
+	template <typename Value, TreeConfigType Config, typename Allocator> requires (Config::ChildCount > 0)
+	struct TreeStorage<Value, Config, Allocator>
 	{
+		template <typename T>
+		using Rebind = std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+		using NodeID   = Config::NodeID;
+		using ValueMap = NodeStorage<Config, Value, Allocator>;
 		struct ChildArray;
 
-		std::map<typename Config::NodeID, Value>      mValues;
-		std::map<typename Config::NodeID, ChildArray> childrenMap;
+
+		explicit TreeStorage(const Allocator& allocator)
+			: mValues(allocator)
+			, childrenMap(allocator)
+		{}
+
+
+		ValueMap                                                                                     mValues;
+		std::map<NodeID, ChildArray, std::less<NodeID>, Rebind<std::pair<const NodeID, ChildArray>>> childrenMap;
 	};
 
 
-	template <typename Value, TreeConfigType Config> requires (Config::ChildCount > 0)
-	struct TreeStorage<Value, Config>::ChildArray
+	template <typename Value, TreeConfigType Config, typename Allocator> requires (Config::ChildCount > 0)
+	struct TreeStorage<Value, Config, Allocator>::ChildArray
 	{
 	public:
 		void AddNode(Config::NodeID node) requires (!Config::Sorted)
@@ -74,7 +101,7 @@ namespace Strawberry::Core::Math
 			Unreachable();
 		}
 
-		void AddNode(Config::NodeID node, const std::map<typename Config::NodeID, Value>& values) requires (Config::Sorted)
+		void AddNode(Config::NodeID node, const ValueMap& values) requires (Config::Sorted)
 		{
 			auto pos = std::ranges::lower_bound(
 				mValues.begin(), std::next(mValues.begin(), ChildCount()),
@@ -144,17 +171,21 @@ namespace Strawberry::Core::Math
 	};
 
 
-	template <typename _Value, TreeConfigType _Config>
+	/// Rooted tree of values.
+	///
+	/// Nodes are allocated with Allocator, which may be a std::pmr::polymorphic_allocator over an Arena or BlockPool.
+	template <typename _Value, TreeConfigType _Config, typename _Allocator = std::allocator<_Value>>
 	class Tree
 	{
 	public:
 		using Value = _Value;
 		using Config = _Config;
+		using Allocator = _Allocator;
 
-		Tree(Value root)
+		Tree(Value root, const Allocator& allocator = Allocator())
+			: mStorage(allocator)
 		{
-			mRoot = 0;
-			mStorage.mValues.emplace(0, std::move(root));
+			mRoot = mStorage.mValues.Insert(std::move(root));
 		}
 
 
@@ -172,8 +203,7 @@ namespace Strawberry::Core::Math
 
 		Config::NodeID AddNode(Config::NodeID parent, Value value)
 		{
-			typename Config::NodeID id = mStorage.mValues.rbegin()->first + 1;
-			mStorage.mValues.emplace(id, std::move(value));
+			typename Config::NodeID id = mStorage.mValues.Insert(std::move(value));
 			if constexpr (Config::ChildCount == 0)
 			{
 				if constexpr (Config::Sorted)
@@ -207,8 +237,7 @@ namespace Strawberry::Core::Math
 
 		Config::NodeID InsertNode(Config::NodeID parent, unsigned int index, Value value) requires (Config::Ordered)
 		{
-			typename Config::NodeID id = mStorage.mValues.rbegin()->first + 1;
-			mStorage.mValues.emplace(id, std::move(value));
+			typename Config::NodeID id = mStorage.mValues.Insert(std::move(value));
 			if constexpr (Config::ChildCount == 0)
 			{
 				mStorage.childrenMap[parent].insert(index, id);
@@ -371,7 +400,7 @@ namespace Strawberry::Core::Math
 
 	private:
 		Config::NodeID mRoot;
-		mutable TreeStorage<Value, Config> mStorage;
+		mutable TreeStorage<Value, Config, Allocator> mStorage;
 	};
 
 
@@ -414,9 +443,22 @@ namespace Strawberry::Core::Math
 		static constexpr unsigned int ChildCount = Base::ChildCount;
 		static constexpr bool Ordered = true;
 		static constexpr bool Sorted = true;
+		static constexpr bool DenseNodes = HasDenseNodes<Base>;
 		using SortingFunction = SORTING_FUNCTION;
 	};
 
 	template <typename _Tree, typename SORTING_FUNCTION = std::less<typename _Tree::Value>>
-	using SortedTree = Tree<typename _Tree::Value, MakeSortedTreeConfig<typename _Tree::Config, SORTING_FUNCTION>>;
+	using SortedTree = Tree<typename _Tree::Value, MakeSortedTreeConfig<typename _Tree::Config, SORTING_FUNCTION>, typename _Tree::Allocator>;
+
+
+	/// Stores the values of a tree densely in a SlotMap, rather than in a map.
+	template <TreeConfigType Base>
+	struct MakeDenseTreeConfig
+		: Base
+	{
+		static constexpr bool DenseNodes = true;
+	};
+
+	template <typename _Tree>
+	using DenseTree = Tree<typename _Tree::Value, MakeDenseTreeConfig<typename _Tree::Config>, typename _Tree::Allocator>;
 }
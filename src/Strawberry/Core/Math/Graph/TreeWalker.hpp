@@ -61,8 +61,8 @@ namespace Strawberry::Core::Math
 	};
 
 
-	template <typename Value, TreeConfigType Config>
-	TreeWalker(const Tree<Value, Config>&) -> TreeWalker<Tree<Value, Config>>;
-	template <typename Value, TreeConfigType Config>
-	TreeWalker(const Tree<Value, Config>&, typename Config::NodeID) -> TreeWalker<Tree<Value, Config>>;
+	template <typename Value, TreeConfigType Config, typename Allocator>
+	TreeWalker(const Tree<Value, Config, Allocator>&) -> TreeWalker<Tree<Value, Config, Allocator>>;
+	template <typename Value, TreeConfigType Config, typename Allocator>
+	TreeWalker(const Tree<Value, Config, Allocator>&, typename Config::NodeID) -> TreeWalker<Tree<Value, Config, Allocator>>;
 }
\ No newline at end of file
@@ -1,15 +1,20 @@
 #pragma once
 // Strawberry Core
+#include "Strawberry/Core/Markers.hpp"
 #include "Strawberry/Core/Math/Geometry/ConvexPolygon.hpp"
-#include "Strawberry/Core/Math/Geometry/Line.hpp"
-#include "Strawberry/Core/Math/Geometry/LineSegment.hpp"
-#include "Strawberry/Core/Math/Geometry/Ray.hpp"
 #include "Strawberry/Core/Math/Graph/Delauney.hpp"
 #include "Strawberry/Core/Math/Graph/Graph.hpp"
+#include "Strawberry/Core/Math/Graph/HalfEdgeMesh.hpp"
 #include "Strawberry/Core/Math/Vector.hpp"
 // Standard Library
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <map>
 #include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
 
 
 namespace Strawberry::Core::Math
@@ -30,16 +35,26 @@ namespace Strawberry::Core::Math
 		using CellNodeID = UndirectedGraph<Vector<T, 2>>::NodeID;
 		using DirectedEdge = DirectedGraph<Vector<T, 2>>::Edge;
 		using Edge = UndirectedGraph<Vector<T, 2>>::Edge;
+		/// Half edge mesh of the cells, whose vertices are indexed by the node IDs of GetGraph().
+		using Mesh = HalfEdgeMesh<Vector<T, 2>, CellNodeID>;
 
 
 		class Builder;
 
 
 		/// Structure representing a cell in a voronoi diagram.
+		///
+		/// A cell does not own its nodes: it views the storage of the Voronoi it came from, so it dangles once that
+		/// Voronoi is destroyed or moved from. Keep the Voronoi alive for as long as its cells, or copy out the nodes.
 		struct Cell
 		{
-			/// Default comparisons for use in ordered structures.
-			auto operator<=>(const Cell& other) const = default;
+			/// Lexicographic comparisons for use in ordered structures.
+			auto operator<=>(const Cell& other) const
+			{
+				return std::lexicographical_compare_three_way(mNodeIDs.begin(), mNodeIDs.end(), other.mNodeIDs.begin(), other.mNodeIDs.end());
+			}
+
+			bool operator==(const Cell& other) const { return std::ranges::equal(mNodeIDs, other.mNodeIDs); }
 
 			std::vector<DirectedEdge> Edges() const
 			{
@@ -51,29 +66,46 @@ namespace Strawberry::Core::Math
 				return edges;
 			}
 
-			std::vector<CellNodeID> mNodeIDs;
+			/// The nodes around the cell, in counter clockwise order. Views the storage of the Voronoi it came from.
+			std::span<const CellNodeID> mNodeIDs;
 		};
 
 		/// Returns the graph containing the boundaries of the voronoi.
 		const auto& GetGraph() const noexcept { return mGraph; }
 
 
-		Optional<Cell> GetCell(CellID id) const
+		/// The cells as a half edge mesh, with a face for each cell, so neighbouring cells are found through the twins
+		/// of a face's half edges.
+		const Mesh& GetMesh() const noexcept { return mMesh; }
+
+
+		/// Returns the ID of the cell which is the given face of GetMesh().
+		CellID GetMeshFaceCell(CellNodeID face) const { return mMeshFaceCells[face]; }
+
+
+		/// Returns the cell of the node with the given ID in the triangulation, or nothing if it has none. The cell views
+		/// this Voronoi's storage, so must not outlive it, and so cannot be taken from a temporary Voronoi.
+		Optional<Cell> GetCell(CellID id) const&
 		{
-			auto search = mCellMap.find(id);
-			if (search == mCellMap.end())
+			if (id + 1 >= mCellOffsets.size() || mCellOffsets[id] == mCellOffsets[id + 1])
 				return NullOpt;
 
-			return search->second;
+			return MakeCell(id);
 		}
 
+		Optional<Cell> GetCell(CellID id) const&& = delete;
 
-		decltype(auto) Cells(this auto&& self)
+
+		/// Returns a view of every cell, in order of ID. The view and the cells it gives refer to this Voronoi, so must not
+		/// outlive it, and so cannot be taken from a temporary Voronoi.
+		decltype(auto) Cells(this auto&& self) requires std::is_lvalue_reference_v<decltype(self)>
 		{
-			return self.mCellMap | std::views::values;
+			return std::views::iota(CellID(0), CellID(self.mCellOffsets.size() - 1))
+				| std::views::filter([&self] (CellID id) { return self.mCellOffsets[id] != self.mCellOffsets[id + 1]; })
+				| std::views::transform([&self] (CellID id) { return self.MakeCell(id); });
 		}
 
-		ConvexPolygon<T> GetCellAsPolygon(const Cell& cell)
+		ConvexPolygon<T> GetCellAsPolygon(const Cell& cell) const
 		{
 			auto points = cell.mNodeIDs | std::views::transform(
 				[&] (const auto& x) { return mGraph.GetValue(x); });
@@ -86,14 +118,35 @@ namespace Strawberry::Core::Math
 		{}
 
 
-		UndirectedVectorGraph<Vector<T, 2>>             mGraph;
-		Delaunay                                        mTriangulation;
-		std::map<typename Delaunay::Face, unsigned int> mTriangleToNodeMapping;
-		/// Maps the IDs of nodes from the triangulation to their respective cells.
-		std::map<CellID, Cell>                          mCellMap;
+		Cell MakeCell(CellID id) const
+		{
+			return Cell{std::span(mCellNodes).subspan(mCellOffsets[id], mCellOffsets[id + 1] - mCellOffsets[id])};
+		}
+
+
+		UndirectedVectorGraph<Vector<T, 2>> mGraph;
+		Delaunay                            mTriangulation;
+		/// The nodes of every cell, one after another.
+		std::vector<CellNodeID>             mCellNodes;
+		/// Where the nodes of each cell start in mCellNodes, indexed by the ID of its node in the triangulation, followed
+		/// by where the last one ends. Nodes without a cell have an empty range.
+		std::vector<size_t>                 mCellOffsets{0};
+		Mesh                                mMesh;
+		/// The cell of each face of mMesh.
+		std::vector<CellID>                 mMeshFaceCells;
 	};
 
 
+	/// Builds a Voronoi diagram as the dual of a Delaunay triangulation, in time linear in its size.
+	///
+	/// The cell of each node is found by walking around the node in the triangulation's mesh: its corners are the
+	/// circumcenters of the faces around it, and nodes on the outside of the triangulation also have two edges running
+	/// outwards to infinity, which are cut off far outside the bounds. Each cell is then clipped to the bounds with one
+	/// pass of Sutherland-Hodgman, unless it is already inside them, as most are.
+	///
+	/// Cells share the nodes of their shared corners. Every corner is identified by what made it: the face whose
+	/// circumcenter it is, the edge and side of the bounds it is the crossing of, or the corner of the bounds. A crossing
+	/// is only computed by the first cell to clip it, and the others reuse its position, so all agree on it exactly.
 	template <typename T>
 	class Voronoi<Vector<T, 2>>::Builder
 	{
@@ -103,285 +156,325 @@ namespace Strawberry::Core::Math
 		{}
 
 
+		/// Builds the diagram. The builder is used up by this, and should not be built again.
 		Voronoi Build()
 		{
-			MakeDual();
-			Normalise();
-			return mResult;
+			MakeCells();
+			BuildMesh();
+			BuildGraph();
+			return std::move(mResult);
 		}
 
 
 
 	private:
-		/// Creates the dual graph of the delaunay triangulation used to create this builder.
-		void MakeDual()
-		{
-			MakeEdgesFromDelaunayFaces();
-			CreateOuterEdges();
-			ClipToOutline();
-		}
+		using HalfEdgeID = Delaunay::NodeID;
 
 
-		void MakeEdgesFromDelaunayFaces()
+		static constexpr CellNodeID NONE = std::numeric_limits<CellNodeID>::max();
+
+
+		enum class VertexKind : uint8_t
 		{
-			for (const auto& face : mResult.mTriangulation.Faces())
-			{
-				auto centroid = mResult.mTriangulation.GetFaceCircumcenter(face);
-				auto centroidNode = mResult.mGraph.AddNode(centroid);
-				mResult.mTriangleToNodeMapping.emplace(face, centroidNode);
+			/// The circumcenter of a face of the triangulation.
+			CIRCUMCENTER,
+			/// Where the dual of an edge of the triangulation crosses a side of the bounds.
+			CROSSING,
+			/// A corner of the bounds.
+			CORNER,
+			/// A point far outside the bounds, which cuts an unbounded cell off.
+			FAR,
+		};
 
-				for (const auto& [otherFace, otherCentroidIndex] : mResult.mTriangleToNodeMapping)
-				{
-					if (face != otherFace && face.SharesEdgeWith(otherFace))
-					{
-						Edge edge{centroidNode, otherCentroidIndex};
-						mResult.mGraph.AddEdge(edge);
 
-						auto sharedEdge = face.GetSharedEdge(otherFace).Value();
-						mEdgeOwnership[edge].emplace(sharedEdge.A());
-						mEdgeOwnership[edge].emplace(sharedEdge.B());
-					}
-				}
-			}
-		}
+		enum class EdgeKind : uint8_t
+		{
+			/// The dual of an edge of the triangulation.
+			DUAL,
+			/// Part of a side of the bounds.
+			SIDE,
+			/// The edge cutting off an unbounded cell.
+			CAP,
+		};
 
 
-		void ClipToOutline()
+		/// A corner of a cell while it is clipped.
+		struct ClipVertex
 		{
-			const auto& bounds = mResult.mTriangulation.GetBoundingBox();
-			/// Record edges that overlap the bounds of the mTriangulation
-			/// and adjust them so that they are clipped by the bounds.
-			std::set<CellNodeID> nodesToRemove;
-			std::vector<Edge> edgesToRemove;
-			std::vector<Edge> edgesToAdd;
-			for (auto edge : mResult.mGraph.Edges())
-			{
-				auto a = mResult.mGraph.GetValue(edge.A());
-				auto b = mResult.mGraph.GetValue(edge.B());
+			Vector<T, 2> position;
+			VertexKind   kind;
+			/// The face of a circumcenter, the edge of a crossing or the index of a corner.
+			HalfEdgeID   index;
+			/// The side of the bounds a crossing is on.
+			unsigned int side = 0;
+			/// The edge to the next vertex, and the canonical half edge of its dual or the side of the bounds it is on.
+			EdgeKind     edgeKind;
+			HalfEdgeID   edge;
+		};
 
-				bool containsA = bounds.Contains(a);
-				bool containsB = bounds.Contains(b);
 
-				// If both points of an edge are contained by the bounds,
-				// then nothing needs to be done
-				if (containsA && containsB) [[likely]]
-				{
-					continue;
-				}
+		/// A crossing of an edge with the bounds, shared by the cells on either side of the edge.
+		struct Crossing
+		{
+			Vector<T, 2> position;
+			CellNodeID   node = NONE;
+		};
 
 
-				if (containsA)
-				{
-					Assert(!containsB);
+		void MakeCells()
+		{
+			const auto& mesh = mResult.mTriangulation.GetMesh();
+			const auto& bounds = mResult.mTriangulation.GetBoundingBox();
 
-					Vector<T, 2> edgeDir = b - a;
-					Ray<T, 2> ray(a, edgeDir);
-					auto intersections = ray.Intersection(bounds.AsPolygon());
-					auto intersection = *std::ranges::min_element(intersections, {}, [] (const auto& x) { return x.rayDistance; });
+			// Cut off points must be far enough away that the edges between them cannot reach the bounds.
+			const Vector<T, 2> center = bounds.Center();
+			T farthest = (bounds.Max() - center).Magnitude();
+			mCircumcenters.reserve(mesh.FaceCount());
+			for (HalfEdgeID face = 0; face < mesh.FaceCount(); face++)
+			{
+				const Vector<T, 2>& circumcenter = mCircumcenters.emplace_back(mResult.mTriangulation.GetMeshFaceCircumcenter(face));
+				farthest = std::max<T>(farthest, (circumcenter - center).Magnitude());
+			}
+			mFarDistance = 8 * farthest;
+			mCircumcenterNodes.assign(mesh.FaceCount(), NONE);
+			mCornerNodes.fill(NONE);
 
-					AssertEQ(mResult.mGraph.Degree(edge.B()), 1);
-					edgesToRemove.emplace_back(edge);
-					nodesToRemove.emplace(edge.B());
+			mResult.mCellNodes.reserve(6 * mesh.VertexCount());
+			mResult.mCellOffsets.reserve(mesh.VertexCount() + 1);
+			for (CellID site = 0; site < mesh.VertexCount(); site++)
+			{
+				MakeCell(site);
+				mResult.mCellOffsets.emplace_back(mResult.mCellNodes.size());
+			}
+		}
 
-					auto newNode = mResult.mGraph.AddNode(intersection.position);
-					Edge newEdge(edge.A(), newNode);
-					edgesToAdd.emplace_back(edge.A(), newNode);
-					mEdgeOwnership[newEdge] = mEdgeOwnership[edge];
-				}
-				else if (containsB)
-				{
-					Assert(!containsA);
 
-					Vector<T, 2> edgeDir = a - b;
-					Ray<T, 2> ray(b, edgeDir);
-					auto intersections = ray.Intersection(bounds.AsPolygon());
-					auto intersection = *std::ranges::min_element(intersections, {}, [] (const auto& x) { return x.rayDistance; });
+		void MakeCell(CellID site)
+		{
+			const auto& mesh = mResult.mTriangulation.GetMesh();
 
-					AssertEQ(mResult.mGraph.Degree(edge.A()), 1);
-					edgesToRemove.emplace_back(edge);
-					nodesToRemove.emplace(edge.A());
+			const HalfEdgeID first = mesh.VertexHalfEdge(site);
+			if (first == Delaunay::Mesh::NONE)
+			{
+				return;
+			}
 
-					auto newNode = mResult.mGraph.AddNode(intersection.position);
-					Edge newEdge(edge.B(), newNode);
-					edgesToAdd.emplace_back(edge.B(), newNode);
-					mEdgeOwnership[newEdge] = mEdgeOwnership[edge];
+			mPolygon.clear();
+			bool inside = true;
+			if (!mesh.IsBoundary(first))
+			{
+				// Walk counter clockwise around the site. The edge from one face's circumcenter to the next is the dual
+				// of the edge between them.
+				HalfEdgeID halfEdge = first;
+				do
+				{
+					const HalfEdgeID face = mesh.Face(halfEdge);
+					const HalfEdgeID next = mesh.Twin(mesh.Prev(halfEdge));
+					inside = inside && IsInside(mCircumcenters[face]);
+					mPolygon.emplace_back(ClipVertex{mCircumcenters[face], VertexKind::CIRCUMCENTER, face, 0, EdgeKind::DUAL, Canonical(next)});
+					halfEdge = next;
 				}
-				else
+				while (halfEdge != first);
+
+				if (inside) [[likely]]
 				{
-					auto intersections = bounds.AsPolygon().Intersection(LineSegment<T, 2>(a, b));
-					if (intersections.size() == 2)
+					for (const auto& vertex : mPolygon)
 					{
-						auto n1 = mResult.mGraph.AddNode(intersections[0].position);
-						auto n2 = mResult.mGraph.AddNode(intersections[1].position);
-
-						Edge e1(n1, n2);
-						edgesToAdd.emplace_back(e1);
-						mEdgeOwnership[e1] = mEdgeOwnership[edge];
+						mResult.mCellNodes.emplace_back(GetNode(vertex));
 					}
-
-					edgesToRemove.emplace_back(edge);
-					nodesToRemove.emplace(edge.A());
-					nodesToRemove.emplace(edge.B());
+					return;
 				}
 			}
+			else
+			{
+				// The site is on the outside of the triangulation, between the boundary half edges coming in to it
+				// and going out of it. Its cell runs out to infinity along the duals of those two edges, and is cut
+				// off far beyond the bounds.
+				const HalfEdgeID outgoing = first;
+				const HalfEdgeID incoming = mesh.Prev(outgoing);
+
+				mPolygon.emplace_back(ClipVertex{FarPoint(incoming), VertexKind::FAR, 0, 0, EdgeKind::DUAL, Canonical(incoming)});
+				for (HalfEdgeID halfEdge = mesh.Twin(incoming); !mesh.IsBoundary(halfEdge); halfEdge = mesh.Twin(mesh.Prev(halfEdge)))
+				{
+					const HalfEdgeID face = mesh.Face(halfEdge);
+					mPolygon.emplace_back(ClipVertex{mCircumcenters[face], VertexKind::CIRCUMCENTER, face, 0, EdgeKind::DUAL, Canonical(mesh.Prev(halfEdge))});
+				}
+				mPolygon.emplace_back(ClipVertex{FarPoint(outgoing), VertexKind::FAR, 0, 0, EdgeKind::CAP, 0});
 
-			for (auto&& edge : edgesToAdd)
+				const Vector<T, 2> outwards = (OutwardDirection(incoming) + OutwardDirection(outgoing)).Normalised();
+				mPolygon.emplace_back(ClipVertex{mesh.GetValue(site) + outwards * (2 * mFarDistance), VertexKind::FAR, 0, 0, EdgeKind::CAP, 0});
+			}
+
+			for (unsigned int side = 0; side < 4; side++)
 			{
-				mResult.mGraph.AddEdge(edge);
+				ClipToSide(side);
 			}
 
-			for (auto&& edge : edgesToRemove)
+			if (mPolygon.size() < 3)
 			{
-				mResult.mGraph.RemoveEdge(edge);
-				mEdgeOwnership.erase(edge);
+				return;
 			}
 
-			for (auto&& node : nodesToRemove)
+			for (const auto& vertex : mPolygon)
 			{
-				mResult.mGraph.RemoveNode(node);
+				mResult.mCellNodes.emplace_back(GetNode(vertex));
 			}
 		}
 
 
-		// Take each outer edge A and extend an edge B from
-		// the circumcentre of A to the boundary of the graph,
-		// intersecting the midpoint of edge A.
-		//
-		// If an edge doesn't have a face at all,
-		// then we extend in both directions a ray,
-		// from the centre of the edge to the boundary,
-		// in the two directions perpendicular to the edge.
-		void CreateOuterEdges()
+		/// Sutherland-Hodgman clipping of mPolygon against one side of the bounds. Where the cell leaves the bounds, it
+		/// continues along the side up to where it comes back in.
+		void ClipToSide(unsigned int side)
 		{
-			const auto bounds = mResult.mTriangulation.GetBoundingBox();
-
-			for (const auto edge : mResult.mTriangulation.GetOuterEdges())
-			{
-				auto vEdgeA = mResult.mTriangulation.GetGraph().GetValue(edge.A());
-				auto vEdgeB = mResult.mTriangulation.GetGraph().GetValue(edge.B());
-
-				auto faces = mResult.mTriangulation.FindFacesWithEdge(edge);
-				Assert(faces.size() < 2,
-					   "FindFacesWithEdge returns more than 1 face when using outer edges. This should never happen!");
-
-				if (faces.size() == 0)
-				{
-					auto vMidPoint = 0.5 * (vEdgeA + vEdgeB);
-					auto vEdgeDir = (vEdgeB - vEdgeA).Perpendicular();
-
-					Line<T, 2> line(vMidPoint, vMidPoint + vEdgeDir);
-					auto intersections = line.Intersection(bounds.AsPolygon());
-					AssertEQ(intersections.size(), 2);
-					std::array<typename decltype(mGraph)::NodeID, 2> newNodes{
-						mResult.mGraph.AddNode(intersections[0].position),
-						mResult.mGraph.AddNode(intersections[1].position)};
-
-					Edge newEdge{newNodes[0], newNodes[1]};
-					mResult.mGraph.AddEdge(newEdge);
-					mEdgeOwnership[newEdge].emplace(edge.A());
-					mEdgeOwnership[newEdge].emplace(edge.B());
-				}
-				else if (faces.size() == 1)
+			const auto& bounds = mResult.mTriangulation.GetBoundingBox();
+			bounds.ClipToSide(mPolygon, mClipped, side, &ClipVertex::position,
+				[&] (const ClipVertex& vertex, const ClipVertex& next, T t) { return MakeCrossing(vertex, next, side, t); },
+				[side] (ClipVertex& vertex)
 				{
-					auto face = faces[0];
-					auto vMean = mResult.mTriangulation.GetFaceAsTriangle(face).GetMean();
+					vertex.edgeKind = EdgeKind::SIDE;
+					vertex.edge     = side;
+				});
+			std::swap(mPolygon, mClipped);
+		}
 
-					auto centerNode = mResult.mTriangleToNodeMapping.at(face);
-					auto vFaceCircumcenter = mResult.mGraph.GetValue(centerNode);
 
-					// Make sure edges are in CW order, so they all point outwards from the face.
-					if ((vEdgeA - vMean).DotPerp(vEdgeB - vMean) > 0.0)
-					{
-						std::swap(vEdgeA, vEdgeB);
-					}
+		/// Returns the point where the edge from vertex to next crosses the given side of the bounds.
+		ClipVertex MakeCrossing(const ClipVertex& vertex, const ClipVertex& next, unsigned int side, T t)
+		{
+			const auto& bounds = mResult.mTriangulation.GetBoundingBox();
 
-					auto vAlongEdge = vEdgeB - vEdgeA;
-					auto vVoronoiEdgeDirection = vAlongEdge.Perpendicular();
+			ClipVertex crossing = vertex;
+			if (vertex.edgeKind == EdgeKind::SIDE)
+			{
+				const unsigned int xSide = std::min(side, vertex.edge), ySide = std::max(side, vertex.edge);
+				Assert(xSide < 2 && ySide >= 2);
 
-					Ray<T, 2> ray(vFaceCircumcenter, vVoronoiEdgeDirection);
+				crossing.kind     = VertexKind::CORNER;
+				crossing.index    = 2 * xSide + (ySide - 2);
+				crossing.position = Vector<T, 2>(xSide == 0 ? bounds.Min()[0] : bounds.Max()[0], ySide == 2 ? bounds.Min()[1] : bounds.Max()[1]);
+				return crossing;
+			}
 
-					auto intersections = ray.Intersection(bounds.AsPolygon());
-					if (intersections.size() > 0)
-					{
-						auto intersection = *std::ranges::max_element(intersections, {}, [] (const auto& x) { return x.rayDistance; });
-						auto newNode = mResult.mGraph.AddNode(intersection.position);
-						Edge newEdge{centerNode, newNode};
-						mResult.mGraph.AddEdge(newEdge);
+			Vector<T, 2> position = vertex.position + (next.position - vertex.position) * t;
+			position[side / 2] = bounds.SideValue(side);
 
-						mEdgeOwnership[newEdge].emplace(edge.A());
-						mEdgeOwnership[newEdge].emplace(edge.B());
-					}
-				}
+			// The line of a side can cross the edge cutting a cell off, but only outside the bounds, where the crossing
+			// is clipped away by another side.
+			if (vertex.edgeKind == EdgeKind::CAP)
+			{
+				crossing.kind     = VertexKind::FAR;
+				crossing.position = position;
+				return crossing;
 			}
+
+			crossing.kind     = VertexKind::CROSSING;
+			crossing.index    = vertex.edge;
+			crossing.side     = side;
+			crossing.position = mCrossings.try_emplace({vertex.edge, side}, Crossing{position}).first->second.position;
+			return crossing;
 		}
 
 
-		void Normalise()
+		/// Returns the node of a vertex of a finished cell, adding it the first time.
+		CellNodeID GetNode(const ClipVertex& vertex)
 		{
-			std::map<CellID, std::set<CellNodeID>> cellSets;
-			for (auto& [edge, cells] : mEdgeOwnership)
+			CellNodeID* node = nullptr;
+			switch (vertex.kind)
 			{
-				AssertEQ(cells.size(), 2);
-				for (auto& cell : cells)
-				{
-					cellSets[cell].emplace(edge.A());
-					cellSets[cell].emplace(edge.B());
-				}
+				case VertexKind::CIRCUMCENTER:
+					node = &mCircumcenterNodes[vertex.index];
+					break;
+				case VertexKind::CROSSING:
+					node = &mCrossings.at({vertex.index, vertex.side}).node;
+					break;
+				case VertexKind::CORNER:
+					node = &mCornerNodes[vertex.index];
+					break;
+				case VertexKind::FAR:
+					// Only reachable if a cut off point was not far enough outside the bounds.
+					Unreachable();
 			}
 
-			for (auto& [id, cellSet] : cellSets)
+			if (*node == NONE)
 			{
-				std::vector<CellNodeID> cellList = cellSet | std::ranges::to<std::vector>();
+				*node = mVertices.size();
+				mVertices.emplace_back(vertex.position);
+			}
+			return *node;
+		}
 
-				Vector<T, 2> mean;
-				for (const auto& node : cellList)
-				{
-					mean = mean + mResult.mGraph.GetValue(node);
-				}
-				mean = (1.0 / cellList.size()) * mean;
 
-				std::ranges::sort(cellList, std::greater{}, [&] (const auto& x) { return (mResult.mGraph.GetValue(x) - mean).ATan2(); });
+		bool IsInside(const Vector<T, 2>& point) const
+		{
+			return mResult.mTriangulation.GetBoundingBox().Contains(point);
+		}
 
-				mResult.mCellMap.emplace(id, std::move(cellList));
-			}
 
-			for (auto corner : mResult.mTriangulation.GetBoundingBox().Corners())
-			{
-				auto nearest = *std::ranges::min_element(
-					mResult.mTriangulation.GetGraph().NodeIndices(),
-					std::less{},
-					[&] (const auto& v) { return (corner - mResult.mTriangulation.GetGraph().GetValue(v)).SquareMagnitude(); });
+		/// Returns the direction in which the dual of a boundary edge runs out to infinity.
+		Vector<T, 2> OutwardDirection(HalfEdgeID boundary) const
+		{
+			const auto& mesh = mResult.mTriangulation.GetMesh();
+			// Boundary half edges run clockwise around the triangulation, so the outside is on their left.
+			return (mesh.GetValue(mesh.Target(boundary)) - mesh.GetValue(mesh.Origin(boundary))).Perpendicular().Normalised();
+		}
 
-				auto cornerNode = mResult.mGraph.AddNode(corner);
-				mResult.mCellMap[nearest].mNodeIDs.emplace_back(cornerNode);
 
-				Vector<T, 2> mean;
-				for (const auto& node : mResult.mCellMap[nearest].mNodeIDs)
-				{
-					mean = mean + mResult.mGraph.GetValue(node);
-				}
-				mean = (1.0 / mResult.mCellMap[nearest].mNodeIDs.size()) * mean;
+		/// Returns the point at which the dual of a boundary edge is cut off. The cells on both sides of it compute it
+		/// from the same half edge, so they agree on it exactly.
+		Vector<T, 2> FarPoint(HalfEdgeID boundary) const
+		{
+			const auto& mesh = mResult.mTriangulation.GetMesh();
+			return mCircumcenters[mesh.Face(mesh.Twin(boundary))] + OutwardDirection(boundary) * mFarDistance;
+		}
+
+
+		/// Returns the lower of the half edges of an edge, which identifies it.
+		HalfEdgeID Canonical(HalfEdgeID halfEdge) const
+		{
+			return std::min(halfEdge, mResult.mTriangulation.GetMesh().Twin(halfEdge));
+		}
+
 
-				std::ranges::sort(
-					mResult.mCellMap[nearest].mNodeIDs,
-					std::greater{},
-					[&] (const auto& x) { return (mResult.mGraph.GetValue(x) - mean).ATan2(); });
+		/// Builds the half edge mesh of the cells.
+		void BuildMesh()
+		{
+			for (CellID id = 0; id + 1 < mResult.mCellOffsets.size(); id++)
+			{
+				if (mResult.mCellOffsets[id] != mResult.mCellOffsets[id + 1]) mResult.mMeshFaceCells.emplace_back(id);
 			}
 
-			for (auto& [id, cell] : mResult.mCellMap)
+			mResult.mMesh = Mesh(mVertices, mResult.Cells() | std::views::transform([] (const Cell& cell) { return cell.mNodeIDs; }));
+		}
+
+
+		/// Builds the graph from the mesh, which already has each edge once.
+		void BuildGraph()
+		{
+			for (const auto& vertex : mVertices)
 			{
-				for (auto& edge : cell.Edges())
-				{
-					if (!mResult.mGraph.IsConnected(edge.A(), edge.B()))
-					{
-						mResult.mGraph.AddEdge({edge.A(), edge.B()});
-					}
-				}
+				mResult.mGraph.AddNode(vertex);
 			}
+
+			const Mesh& mesh = mResult.mMesh;
+			mResult.mGraph.AddEdges(std::views::iota(CellNodeID(0), mesh.HalfEdgeCount())
+				| std::views::filter([&] (CellNodeID halfEdge) { return halfEdge < mesh.Twin(halfEdge); })
+				| std::views::transform([&] (CellNodeID halfEdge) { return Edge(mesh.Origin(halfEdge), mesh.Target(halfEdge)); }));
 		}
 
 
-		Voronoi mResult;
-		std::map<Edge, std::set<CellID>> mEdgeOwnership;
+		Voronoi                      mResult;
+		/// The circumcenter of each face of the triangulation's mesh, and its node once a cell uses it.
+		std::vector<Vector<T, 2>>    mCircumcenters;
+		std::vector<CellNodeID>      mCircumcenterNodes;
+		/// The crossings of the bounds, by the canonical half edge of the crossing edge's dual and the side crossed.
+		std::map<std::pair<HalfEdgeID, unsigned int>, Crossing> mCrossings;
+		std::array<CellNodeID, 4>    mCornerNodes;
+		/// The position of each node, in the order they were added.
+		std::vector<Vector<T, 2>>    mVertices;
+		/// How far beyond the triangulation unbounded cells are cut off.
+		T                            mFarDistance = 0;
+		/// The cell being clipped, and the buffer it is clipped into.
+		std::vector<ClipVertex>      mPolygon;
+		std::vector<ClipVertex>      mClipped;
 	};
 }
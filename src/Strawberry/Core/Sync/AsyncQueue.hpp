@@ -0,0 +1,130 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+#include "Strawberry/Core/Types/Optional.hpp"
+// Standard Library
+#include <coroutine>
+#include <deque>
+#include <mutex>
+
+
+namespace Strawberry::Core
+{
+	/// Unbounded multi-producer, multi-consumer queue which coroutines can await values from.
+	///
+	/// Awaiting Pop on an empty queue suspends the coroutine rather than blocking its thread. The next Push
+	/// hands its value directly to the longest waiting coroutine and resumes it inline on the pushing thread.
+	template <typename T>
+	class AsyncQueue
+	{
+	public:
+		AsyncQueue() = default;
+		AsyncQueue(const AsyncQueue&) = delete;
+		AsyncQueue& operator=(const AsyncQueue&) = delete;
+
+
+		~AsyncQueue()
+		{
+			Assert(mWaiters.empty(), "AsyncQueue destroyed while coroutines are waiting on it!");
+		}
+
+
+		/// Pushes a value, or hands it to a waiting coroutine and resumes it.
+		template <typename... Args>
+		void Push(Args&&... args)
+		{
+			std::unique_lock lock(mMutex);
+			if (mWaiters.empty())
+			{
+				mValues.emplace_back(std::forward<Args>(args)...);
+				return;
+			}
+
+			PopAwaiter* waiter = mWaiters.front();
+			mWaiters.pop_front();
+			lock.unlock();
+
+			waiter->value.Emplace(std::forward<Args>(args)...);
+			waiter->handle.resume();
+		}
+
+
+		/// Pops a value if there is one, without waiting.
+		Optional<T> TryPop()
+		{
+			std::unique_lock lock(mMutex);
+			return TryPopLocked();
+		}
+
+
+		/// Returns an awaitable which produces the next value from the queue.
+		auto Pop() noexcept
+		{
+			return PopAwaiter{*this};
+		}
+
+
+		[[nodiscard]] size_t Size() const
+		{
+			std::unique_lock lock(mMutex);
+			return mValues.size();
+		}
+
+
+	private:
+		struct PopAwaiter
+		{
+			AsyncQueue&             queue;
+			Optional<T>             value;
+			std::coroutine_handle<> handle;
+
+
+			bool await_ready()
+			{
+				value = queue.TryPop();
+				return value.HasValue();
+			}
+
+
+			bool await_suspend(std::coroutine_handle<> awaiting)
+			{
+				std::unique_lock lock(queue.mMutex);
+
+				// A value may have been pushed since await_ready.
+				value = queue.TryPopLocked();
+				if (value)
+				{
+					return false;
+				}
+
+				handle = awaiting;
+				queue.mWaiters.emplace_back(this);
+				return true;
+			}
+
+
+			T await_resume()
+			{
+				return value.Unwrap();
+			}
+		};
+
+
+		Optional<T> TryPopLocked()
+		{
+			if (mValues.empty())
+			{
+				return NullOpt;
+			}
+
+			T value = std::move(mValues.front());
+			mValues.pop_front();
+			return value;
+		}
+
+
+		mutable std::mutex      mMutex;
+		std::deque<T>           mValues;
+		std::deque<PopAwaiter*> mWaiters;
+	};
+}
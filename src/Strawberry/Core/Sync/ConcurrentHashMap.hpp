@@ -0,0 +1,437 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+#include "Strawberry/Core/Sync/Mutex.hpp"
+#include "Strawberry/Core/Types/Optional.hpp"
+#include "Strawberry/Core/Util/Alloc.hpp"
+// Standard Library
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+namespace Strawberry::Core
+{
+	/// Hash map which may be used from any number of threads at once.
+	///
+	/// Keys are split between a fixed number of shards by the top bits of their hash, and each shard is an open
+	/// addressing table with linear probing, guarded by a reader-writer Mutex. Lookups only take a shard's read lock, so
+	/// readers never wait for each other, and threads working on different shards never contend at all.
+	///
+	/// Values are returned by copy, since a reference could be invalidated by a concurrent write. Large or expensive
+	/// values should be stored behind a std::shared_ptr.
+	template <typename K, typename V, typename Hash = std::hash<K>, typename Equal = std::equal_to<K>>
+		requires (std::movable<K> && std::movable<V>)
+	class ConcurrentHashMap
+	{
+	public:
+		static constexpr size_t DEFAULT_SHARD_COUNT = 64;
+
+
+		/// Creates an empty map, with shardCount rounded up to a power of two.
+		explicit ConcurrentHashMap(size_t shardCount = DEFAULT_SHARD_COUNT)
+			: mShardBits(std::countr_zero(std::bit_ceil(std::max<size_t>(shardCount, 1))))
+			, mShards(std::make_unique<Shard[]>(size_t(1) << mShardBits))
+		{}
+
+
+		ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+		ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+
+		/// Returns a copy of the value for key, if there is one.
+		[[nodiscard]] Optional<V> Find(const K& key) const
+		{
+			const uint64_t hash  = HashOf(key);
+			auto           table = GetShard(hash).table.ReadLock();
+
+			if (auto slot = table->Find(key, hash, mEqual))
+			{
+				return table->slots[*slot].entry->second;
+			}
+			return NullOpt;
+		}
+
+
+		[[nodiscard]] bool Contains(const K& key) const
+		{
+			const uint64_t hash = HashOf(key);
+			return GetShard(hash).table.ReadLock()->Find(key, hash, mEqual).HasValue();
+		}
+
+
+		/// Inserts value for key, unless key is already present. Returns whether the value was inserted.
+		template <typename KArg, typename VArg>
+		bool Insert(KArg&& key, VArg&& value)
+		{
+			const uint64_t hash  = HashOf(key);
+			auto           table = GetShard(hash).table.Lock();
+
+			if (table->Find(key, hash, mEqual)) return false;
+			table->Insert(hash, K(std::forward<KArg>(key)), V(std::forward<VArg>(value)));
+			return true;
+		}
+
+
+		/// Sets the value for key, whether or not it is already present. Returns whether a new entry was created.
+		template <typename KArg, typename VArg>
+		bool InsertOrAssign(KArg&& key, VArg&& value)
+		{
+			const uint64_t hash  = HashOf(key);
+			auto           table = GetShard(hash).table.Lock();
+
+			if (auto slot = table->Find(key, hash, mEqual))
+			{
+				table->slots[*slot].entry->second = std::forward<VArg>(value);
+				return false;
+			}
+			table->Insert(hash, K(std::forward<KArg>(key)), V(std::forward<VArg>(value)));
+			return true;
+		}
+
+
+		/// Calls function with a reference to the value for key, if present, while holding the shard's write lock.
+		/// Returns whether key was present.
+		template <std::invocable<V&> F>
+		bool Update(const K& key, F&& function)
+		{
+			const uint64_t hash  = HashOf(key);
+			auto           table = GetShard(hash).table.Lock();
+
+			if (auto slot = table->Find(key, hash, mEqual))
+			{
+				std::invoke(std::forward<F>(function), table->slots[*slot].entry->second);
+				return true;
+			}
+			return false;
+		}
+
+
+		/// Removes key from the map. Returns whether it was present.
+		bool Erase(const K& key)
+		{
+			const uint64_t hash  = HashOf(key);
+			auto           table = GetShard(hash).table.Lock();
+
+			if (auto slot = table->Find(key, hash, mEqual))
+			{
+				table->Erase(*slot);
+				return true;
+			}
+			return false;
+		}
+
+
+		/// Returns the value for key, computing it with function and inserting it if it is not present.
+		///
+		/// Function is called at most once per key, however many threads ask for it at the same time: the others wait
+		/// for its result. No locks are held while function runs, so it may itself use the map, but not to compute the same
+		/// key. If function throws, the exception is rethrown in every waiting thread, nothing is inserted, and a later
+		/// call will try again. If the key is inserted by other means while function runs, that value is kept and returned
+		/// instead of function's.
+		template <std::invocable<const K&> F>
+			requires (std::convertible_to<std::invoke_result_t<F, const K&>, V> && std::copy_constructible<K> && std::copy_constructible<V>)
+		V GetOrCompute(const K& key, F&& function)
+		{
+			const uint64_t hash  = HashOf(key);
+			Shard&         shard = GetShard(hash);
+
+			{
+				auto table = shard.table.ReadLock();
+				if (auto slot = table->Find(key, hash, mEqual))
+				{
+					return table->slots[*slot].entry->second;
+				}
+			}
+
+
+			std::shared_ptr<Computation> computation;
+			bool                         computing = false;
+			{
+				auto table = shard.table.Lock();
+				if (auto slot = table->Find(key, hash, mEqual))
+				{
+					return table->slots[*slot].entry->second;
+				}
+
+				auto inFlight = std::ranges::find_if(table->computations, [&] (const auto& c) { return c->hash == hash && mEqual(c->key, key); });
+				if (inFlight != table->computations.end())
+				{
+					computation = *inFlight;
+				}
+				else
+				{
+					computation = std::make_shared<Computation>(key, hash);
+					table->computations.emplace_back(computation);
+					computing = true;
+				}
+			}
+
+
+			if (!computing)
+			{
+				return computation->Wait();
+			}
+
+
+			try
+			{
+				computation->result.Emplace(std::invoke(std::forward<F>(function), key));
+			}
+			catch (...)
+			{
+				computation->exception = std::current_exception();
+			}
+
+			{
+				auto table = shard.table.Lock();
+				std::erase(table->computations, computation);
+				if (computation->result)
+				{
+					// If the key was inserted while function ran, the value in the map is kept, so that is the one returned.
+					if (auto slot = table->Find(key, hash, mEqual))
+					{
+						computation->result.Emplace(table->slots[*slot].entry->second);
+					}
+					else
+					{
+						table->Insert(hash, K(key), V(*computation->result));
+					}
+				}
+			}
+
+			computation->Finish();
+			if (computation->exception) std::rethrow_exception(computation->exception);
+			return *computation->result;
+		}
+
+
+		/// Returns the number of entries. Only approximate while other threads are modifying the map.
+		[[nodiscard]] size_t Size() const
+		{
+			size_t size = 0;
+			for (size_t i = 0; i < ShardCount(); i++)
+			{
+				size += mShards[i].table.ReadLock()->size;
+			}
+			return size;
+		}
+
+
+		[[nodiscard]] bool IsEmpty() const
+		{
+			return Size() == 0;
+		}
+
+
+		/// Removes every entry.
+		void Clear()
+		{
+			for (size_t i = 0; i < ShardCount(); i++)
+			{
+				mShards[i].table.Lock()->Clear();
+			}
+		}
+
+
+		[[nodiscard]] size_t ShardCount() const noexcept
+		{
+			return size_t(1) << mShardBits;
+		}
+
+
+	private:
+		/// A GetOrCompute call which is running, which other calls for the same key wait on.
+		struct Computation
+		{
+			Computation(const K& key, uint64_t hash)
+				: key(key)
+				, hash(hash)
+			{}
+
+
+			V Wait()
+			{
+				done.wait(false, std::memory_order::acquire);
+				if (exception) std::rethrow_exception(exception);
+				return *result;
+			}
+
+
+			void Finish()
+			{
+				done.store(true, std::memory_order::release);
+				done.notify_all();
+			}
+
+
+			K                  key;
+			uint64_t           hash;
+			std::atomic_bool   done = false;
+			Optional<V>        result;
+			std::exception_ptr exception;
+		};
+
+
+		/// Open addressing table with linear probing.
+		///
+		/// Each slot has a control byte, kept in an array of their own, which is EMPTY, DELETED, or 7 bits of the hash
+		/// with the top bit set. Probing scans the densely packed control bytes, and only looks at an entry, and compares
+		/// its key, when its control byte matches. The full hash is kept next to each entry, so that growing never needs
+		/// to hash keys again.
+		struct Table
+		{
+			static constexpr uint8_t EMPTY            = 0;
+			static constexpr uint8_t DELETED          = 1;
+			static constexpr uint8_t FULL             = 0x80;
+			static constexpr size_t  MINIMUM_CAPACITY = 16;
+
+
+			struct Slot
+			{
+				uint64_t                  hash = 0;
+				Optional<std::pair<K, V>> entry;
+			};
+
+
+			Optional<size_t> Find(const K& key, uint64_t hash, const Equal& equal) const
+			{
+				if (control.empty()) return NullOpt;
+
+				const uint8_t tag  = Tag(hash);
+				const size_t  mask = control.size() - 1;
+				for (size_t i = hash & mask;; i = (i + 1) & mask)
+				{
+					if (control[i] == EMPTY) return NullOpt;
+					if (control[i] == tag && slots[i].hash == hash && equal(slots[i].entry->first, key)) return i;
+				}
+			}
+
+
+			/// Inserts a key which is known not to be present.
+			void Insert(uint64_t hash, K&& key, V&& value)
+			{
+				// Deleted slots still lengthen probes, so they count towards the load factor.
+				if (4 * (size + deleted + 1) > 3 * control.size())
+				{
+					Rehash(std::max(MINIMUM_CAPACITY, std::bit_ceil(2 * (size + 1))));
+				}
+
+				const size_t mask = control.size() - 1;
+				size_t i = hash & mask;
+				while (control[i] & FULL)
+				{
+					i = (i + 1) & mask;
+				}
+
+				if (control[i] == DELETED) deleted--;
+				control[i]    = Tag(hash);
+				slots[i].hash = hash;
+				slots[i].entry.Emplace(std::move(key), std::move(value));
+				size++;
+			}
+
+
+			void Erase(size_t i)
+			{
+				slots[i].entry.Reset();
+				size--;
+
+				// A deleted slot followed by an empty one ends every probe through it anyway, so it can be emptied.
+				if (control[(i + 1) & (control.size() - 1)] == EMPTY)
+				{
+					control[i] = EMPTY;
+				}
+				else
+				{
+					control[i] = DELETED;
+					deleted++;
+				}
+			}
+
+
+			void Clear()
+			{
+				control.clear();
+				slots.clear();
+				size    = 0;
+				deleted = 0;
+			}
+
+
+			void Rehash(size_t capacity)
+			{
+				std::vector<uint8_t> oldControl = std::exchange(control, std::vector<uint8_t>(capacity, EMPTY));
+				std::vector<Slot>    oldSlots   = std::exchange(slots, std::vector<Slot>(capacity));
+
+				const size_t mask = capacity - 1;
+				for (size_t old = 0; old < oldControl.size(); old++)
+				{
+					if (!(oldControl[old] & FULL)) continue;
+
+					size_t i = oldSlots[old].hash & mask;
+					while (control[i] != EMPTY)
+					{
+						i = (i + 1) & mask;
+					}
+					control[i] = oldControl[old];
+					slots[i]   = std::move(oldSlots[old]);
+				}
+				deleted = 0;
+			}
+
+
+			static uint8_t Tag(uint64_t hash) noexcept
+			{
+				// The low bits choose the slot, so the tag is taken from higher bits which are less correlated with it.
+				return FULL | static_cast<uint8_t>(hash >> 32);
+			}
+
+
+			std::vector<uint8_t> control;
+			std::vector<Slot>    slots;
+			size_t               size    = 0;
+			size_t               deleted = 0;
+
+			std::vector<std::shared_ptr<Computation>> computations;
+		};
+
+
+		struct alignas(CACHE_LINE_SIZE) Shard
+		{
+			Mutex<Table, MutexPolicy::Shared> table;
+		};
+
+
+		/// Mixes the user's hash, since std::hash is the identity for integers, and both ends of the hash are used.
+		uint64_t HashOf(const K& key) const
+		{
+			uint64_t hash = static_cast<uint64_t>(mHash(key));
+			hash ^= hash >> 33;
+			hash *= 0xff51afd7ed558ccdull;
+			hash ^= hash >> 33;
+			hash *= 0xc4ceb9fe1a85ec53ull;
+			hash ^= hash >> 33;
+			return hash;
+		}
+
+
+		Shard& GetShard(uint64_t hash) const noexcept
+		{
+			return mShards[mShardBits == 0 ? 0 : hash >> (64 - mShardBits)];
+		}
+
+
+		const unsigned int             mShardBits;
+		const std::unique_ptr<Shard[]> mShards;
+		[[no_unique_address]] Hash     mHash;
+		[[no_unique_address]] Equal    mEqual;
+	};
+}
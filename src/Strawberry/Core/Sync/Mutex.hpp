@@ -8,23 +8,137 @@
 #include "Strawberry/Core/Assert.hpp"
 #include "Strawberry/Core/Types/Optional.hpp"
 // Standard Library
+#include <concepts>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>
 
 namespace Strawberry::Core
 {
-	template<typename T>
+	/// Reader-writer mutex which also supports a single upgradable reader.
+	///
+	/// An upgradable reader shares the mutex with ordinary readers, but excludes writers and other upgradable readers,
+	/// so that it can later become a writer without anyone else having written in between.
+	class UpgradableMutex
+	{
+	public:
+		void lock()
+		{
+			mUpgradeMutex.lock();
+			mMutex.lock();
+		}
+
+
+		bool try_lock()
+		{
+			if (!mUpgradeMutex.try_lock()) return false;
+			if (!mMutex.try_lock())
+			{
+				mUpgradeMutex.unlock();
+				return false;
+			}
+			return true;
+		}
+
+
+		void unlock()
+		{
+			mMutex.unlock();
+			mUpgradeMutex.unlock();
+		}
+
+
+		void lock_shared() { mMutex.lock_shared(); }
+		bool try_lock_shared() { return mMutex.try_lock_shared(); }
+		void unlock_shared() { mMutex.unlock_shared(); }
+
+
+		void lock_upgrade()
+		{
+			mUpgradeMutex.lock();
+			mMutex.lock_shared();
+		}
+
+
+		void unlock_upgrade()
+		{
+			mMutex.unlock_shared();
+			mUpgradeMutex.unlock();
+		}
+
+
+		/// Turns an upgradable lock into an exclusive one, waiting for the remaining readers to leave.
+		void unlock_upgrade_and_lock()
+		{
+			// Writers need mUpgradeMutex, which we keep holding, so none can get in while we swap locks.
+			mMutex.unlock_shared();
+			mMutex.lock();
+		}
+
+
+	private:
+		/// Held by writers and by the upgradable reader.
+		std::mutex        mUpgradeMutex;
+		std::shared_mutex mMutex;
+	};
+
+
+	/// Policies selecting the kind of lock used by a Mutex.
+	namespace MutexPolicy
+	{
+		/// A std::mutex. The fastest option, but may not be locked again by the thread which holds it.
+		struct Plain
+		{
+			using MutexType = std::mutex;
+			static constexpr bool IsShared = false;
+		};
+
+
+		/// A std::recursive_mutex, which may be locked again by the thread which holds it.
+		struct Recursive
+		{
+			using MutexType = std::recursive_mutex;
+			static constexpr bool IsShared = false;
+		};
+
+
+		/// A reader-writer lock. Any number of readers can hold it at once, and one of them can be upgradable.
+		struct Shared
+		{
+			using MutexType = UpgradableMutex;
+			static constexpr bool IsShared = true;
+		};
+	}
+
+
+	template <typename Policy>
+	concept MutexPolicyType = requires
+	{
+		typename Policy::MutexType;
+		{ Policy::IsShared } -> std::convertible_to<bool>;
+	};
+
+
+	template<typename T, MutexPolicyType Policy>
 	class Mutex;
 
 
 	template<typename T>
+	class UpgradableGuard;
+
+
+	template<typename T, typename Lock = std::unique_lock<std::recursive_mutex>>
 	class MutexGuard
 	{
-		template<typename>
+		template<typename, MutexPolicyType>
 		friend class Mutex;
+		template<typename>
+		friend class UpgradableGuard;
 
 	public:
-		using LockType = std::unique_lock<std::recursive_mutex>;
+		using LockType = Lock;
 
 		MutexGuard(const MutexGuard& other) = delete;
 
@@ -61,10 +175,92 @@ namespace Strawberry::Core
 	};
 
 
+	/// Guard for read access to a Mutex with the Shared policy, which can be upgraded to write access.
+	///
+	/// Readers may hold the Mutex alongside this guard, but writers and other upgradable guards may not.
 	template<typename T>
+	class UpgradableGuard
+	{
+		template<typename, MutexPolicyType>
+		friend class Mutex;
+
+	public:
+		UpgradableGuard(const UpgradableGuard&) = delete;
+		UpgradableGuard& operator=(const UpgradableGuard&) = delete;
+
+
+		UpgradableGuard(UpgradableGuard&& other) noexcept
+			: mMutex(std::exchange(other.mMutex, nullptr))
+			, mPayload(other.mPayload) {}
+
+
+		UpgradableGuard& operator=(UpgradableGuard&& other) noexcept
+		{
+			if (this != &other)
+			{
+				if (mMutex) mMutex->unlock_upgrade();
+				mMutex   = std::exchange(other.mMutex, nullptr);
+				mPayload = other.mPayload;
+			}
+			return *this;
+		}
+
+
+		~UpgradableGuard()
+		{
+			if (mMutex) mMutex->unlock_upgrade();
+		}
+
+
+		inline const T& operator*() const
+		{
+			return *mPayload;
+		}
+
+
+		inline const T* operator->() const
+		{
+			return mPayload;
+		}
+
+
+		/// Waits for all other readers to leave, and then returns a guard with write access.
+		MutexGuard<T, std::unique_lock<UpgradableMutex>> Upgrade() &&
+		{
+			ZoneScoped;
+
+			Assert(mMutex != nullptr);
+			UpgradableMutex* mutex = std::exchange(mMutex, nullptr);
+			mutex->unlock_upgrade_and_lock();
+			return {std::unique_lock(*mutex, std::adopt_lock), mPayload};
+		}
+
+	private:
+		UpgradableGuard(UpgradableMutex& mutex, T* ptr)
+			: mMutex(&mutex)
+			, mPayload(ptr) {}
+
+
+		UpgradableMutex* mMutex;
+		T*               mPayload;
+	};
+
+
+	/// A value of type T which may only be accessed while holding its lock.
+	///
+	/// The kind of lock is chosen by Policy. With MutexPolicy::Shared, ReadLock and Lock() const allow any number of
+	/// readers at once, and UpgradableLock allows a reader to later become a writer.
+	template<typename T, MutexPolicyType Policy = MutexPolicy::Recursive>
 	class Mutex
 	{
 	public:
+		using MutexType = typename Policy::MutexType;
+		using WriteGuard = MutexGuard<T, std::unique_lock<MutexType>>;
+		using ReadGuard = std::conditional_t<Policy::IsShared,
+			MutexGuard<const T, std::shared_lock<MutexType>>,
+			MutexGuard<const T, std::unique_lock<MutexType>>>;
+
+
 		template<typename... Ts>
 		Mutex(Ts&&... ts) requires (std::constructible_from<T, Ts...>)
 			: mMutex()
@@ -97,7 +293,7 @@ namespace Strawberry::Core
 		}
 
 
-		MutexGuard<T> Lock() &
+		WriteGuard Lock() &
 		{
 			ZoneScoped;
 
@@ -105,22 +301,40 @@ namespace Strawberry::Core
 		}
 
 
-		MutexGuard<const T> Lock() const &
+		/// Locks for reading. Shared between readers if Policy allows it.
+		ReadGuard Lock() const &
+		{
+			return ReadLock();
+		}
+
+
+		/// Locks for reading. Shared between readers if Policy allows it, and otherwise exclusive.
+		ReadGuard ReadLock() const &
 		{
 			ZoneScoped;
 
-			return {std::unique_lock(mMutex), &mPayload};
+			return {typename ReadGuard::LockType(mMutex), &mPayload};
 		}
 
 
-		Optional<MutexGuard<T>> TryLock() &
+		/// Locks for reading, with the option of later upgrading to write access.
+		UpgradableGuard<T> UpgradableLock() & requires (Policy::IsShared)
 		{
 			ZoneScoped;
 
-			std::unique_lock<std::recursive_mutex> lk(mMutex, std::defer_lock);
+			mMutex.lock_upgrade();
+			return {mMutex, &mPayload};
+		}
+
+
+		Optional<WriteGuard> TryLock() &
+		{
+			ZoneScoped;
+
+			std::unique_lock lk(mMutex, std::defer_lock);
 			if (lk.try_lock())
 			{
-				return MutexGuard<T>(std::move(lk), &mPayload);
+				return WriteGuard(std::move(lk), &mPayload);
 			}
 			else
 			{
@@ -129,14 +343,14 @@ namespace Strawberry::Core
 		}
 
 
-		Optional<MutexGuard<const T>> TryLock() const &
+		Optional<ReadGuard> TryLock() const &
 		{
 			ZoneScoped;
 
-			std::unique_lock lk(mMutex, std::defer_lock);
+			typename ReadGuard::LockType lk(mMutex, std::defer_lock);
 			if (lk.try_lock())
 			{
-				return MutexGuard<T>(std::move(lk), &mPayload);
+				return ReadGuard(std::move(lk), &mPayload);
 			}
 			else
 			{
@@ -145,10 +359,10 @@ namespace Strawberry::Core
 		}
 
 
-		Mutex<T> Clone() &
+		Mutex Clone() &
 		{
-			auto lock = Lock();
-			return Mutex<T>(*lock);
+			auto lock = ReadLock();
+			return Mutex(*lock);
 		}
 
 
@@ -159,7 +373,7 @@ namespace Strawberry::Core
 		}
 
 	private:
-		mutable std::recursive_mutex mMutex;
+		mutable MutexType mMutex;
 
 
 		union
@@ -169,7 +383,7 @@ namespace Strawberry::Core
 	};
 
 
-	template<typename T>
+	template<typename T, MutexPolicyType Policy = MutexPolicy::Recursive>
 	class SharedMutex
 	{
 	public:
@@ -179,7 +393,7 @@ namespace Strawberry::Core
 
 		template<typename... Ts> requires (std::constructible_from<T, Ts...>)
 		explicit SharedMutex(Ts&&... ts)
-			: mPayload(std::make_shared<Mutex<T>>(std::forward<Ts>(ts)...)) {}
+			: mPayload(std::make_shared<Mutex<T, Policy>>(std::forward<Ts>(ts)...)) {}
 
 
 		SharedMutex& operator=(std::nullptr_t)
@@ -204,35 +418,47 @@ namespace Strawberry::Core
 		template<typename... Ts> requires std::constructible_from<T, Ts...>
 		void Emplace(Ts&&... ts) &
 		{
-			mPayload = std::make_shared<Mutex<T>>(std::forward<Ts>(ts)...);
+			mPayload = std::make_shared<Mutex<T, Policy>>(std::forward<Ts>(ts)...);
 		}
 
 
-		MutexGuard<T> Lock()
+		auto Lock()
 		{
 			return mPayload->Lock();
 		}
 
 
-		MutexGuard<const T> Lock() const
+		auto Lock() const
 		{
-			return static_cast<const Mutex<T>*>(mPayload.get())->Lock();
+			return static_cast<const Mutex<T, Policy>*>(mPayload.get())->Lock();
 		}
 
 
-		Optional<MutexGuard<T>> TryLock()
+		auto ReadLock() const
 		{
-			return mPayload->TryLock();
+			return static_cast<const Mutex<T, Policy>*>(mPayload.get())->ReadLock();
 		}
 
 
-		Optional<MutexGuard<const T>> TryLock() const
+		auto UpgradableLock() requires (Policy::IsShared)
+		{
+			return mPayload->UpgradableLock();
+		}
+
+
+		auto TryLock()
 		{
 			return mPayload->TryLock();
 		}
 
+
+		auto TryLock() const
+		{
+			return static_cast<const Mutex<T, Policy>*>(mPayload.get())->TryLock();
+		}
+
 	private:
-		std::shared_ptr<Mutex<T>> mPayload;
+		std::shared_ptr<Mutex<T, Policy>> mPayload;
 	};
 
 
@@ -3,21 +3,36 @@
 // Strawberry Core
 #include "Strawberry/Core/Types/Optional.hpp"
 #include "Strawberry/Core/Util/Alloc.hpp"
-#include "Strawberry/Core/Sync/Spinlock.hpp"
 // Standard Library
+#include <algorithm>
 #include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <stop_token>
+#include <type_traits>
+#include <utility>
 
 
 namespace Strawberry::Core::LockFree
 {
 	/// Lock Free Single Writer Single Reader Queue with a finite capacity.
+	///
+	/// The producer and consumer each own one index, kept on separate cache lines, along with a cached copy of the
+	/// other's index. The other index is only reloaded when the cached copy says the queue is full or empty, so in
+	/// steady state neither thread touches a cache line written by the other except to read and write elements.
+	/// Indices increase monotonically and are masked into a power of two sized buffer.
 	template <typename T, size_t CAPACITY>
 	class SPSCQueue
 	{
+		static_assert(CAPACITY > 0);
+
 	public:
 		/// Construct a fresh queue
 		SPSCQueue()
-			: mData(AlignedAlloc(alignof(T), CAPACITY * sizeof(T)))
+			: mData(static_cast<T*>(AlignedAlloc(alignof(T), BUFFER_SIZE * sizeof(T))))
 		{}
 
 
@@ -28,9 +43,11 @@ namespace Strawberry::Core::LockFree
 
 
 		/// Queues are move-constructible.
-		SPSCQueue(SPSCQueue&& x)
- noexcept 			: mHead(x.mHead.load())
+		SPSCQueue(SPSCQueue&& x) noexcept
+			: mHead(x.mHead.load())
+			, mCachedTail(x.mCachedTail)
 			, mTail(x.mTail.load())
+			, mCachedHead(x.mCachedHead)
 			, mData(std::exchange(x.mData, nullptr))
 		{}
 
@@ -53,112 +70,521 @@ namespace Strawberry::Core::LockFree
 		[[nodiscard]] bool Push(std::common_reference_with<T> auto value) noexcept
 		{	ZoneScoped;
 			// Since this thread is the only one to write to mTail, we can use relaxed ordering.
-			size_t tail = mTail.load(std::memory_order::relaxed);
+			const size_t tail = mTail.load(std::memory_order::relaxed);
 
-			// Don't insert if the queue is full.
-			if (IsFull())
+			// Only look at the consumer's index if our copy of it says the queue is full.
+			if (tail - mCachedHead == CAPACITY)
 			{
-				return false;
+				mCachedHead = mHead.load(std::memory_order::acquire);
+				if (tail - mCachedHead == CAPACITY)
+				{
+					return false;
+				}
 			}
 
 			// Construct the value in the position.
-			std::construct_at(static_cast<T*>(mData) + tail, std::forward<decltype(value)>(value));
-			// Store the new tail
-			mTail.store((tail + 1) % CAPACITY, std::memory_order::release);
-			// Increment the size counter
-			mSize.fetch_add(1, std::memory_order_release);
+			std::construct_at(mData + (tail & MASK), std::forward<decltype(value)>(value));
+			// Publish the value to the consumer.
+			mTail.store(tail + 1, std::memory_order::release);
 			return true;
 		}
 
 
+		/// Pushes as many of values as will fit, publishing them all at once. Returns the number pushed.
+		[[nodiscard]] size_t PushN(std::span<const T> values) noexcept
+		{	ZoneScoped;
+			const size_t tail = mTail.load(std::memory_order::relaxed);
+
+			if (CAPACITY - (tail - mCachedHead) < values.size())
+			{
+				mCachedHead = mHead.load(std::memory_order::acquire);
+			}
+
+			const size_t count = std::min(values.size(), CAPACITY - (tail - mCachedHead));
+			for (size_t i = 0; i < count; i++)
+			{
+				std::construct_at(mData + ((tail + i) & MASK), values[i]);
+			}
+
+			mTail.store(tail + count, std::memory_order::release);
+			return count;
+		}
+
+
 		/// Pop a value from the queue if there is one.
 		[[nodiscard]] Optional<T> Pop() noexcept
 		{	ZoneScoped;
-			// Since this thread is the only one to write to mTail, we can use relaxed ordering.
-			size_t head = mHead.load(std::memory_order::relaxed);
-			// Can't pop if the queue is empty.
-			if (IsEmpty())
+			// Since this thread is the only one to write to mHead, we can use relaxed ordering.
+			const size_t head = mHead.load(std::memory_order::relaxed);
+
+			// Only look at the producer's index if our copy of it says the queue is empty.
+			if (head == mCachedTail)
 			{
-				return NullOpt;
+				mCachedTail = mTail.load(std::memory_order::acquire);
+				if (head == mCachedTail)
+				{
+					return NullOpt;
+				}
 			}
 
 			// Move the value out of the position.
-			T value = std::move(static_cast<T*>(mData)[head]);
+			T* slot = mData + (head & MASK);
+			T value = std::move(*slot);
 			// Clean up the value.
-			std::destroy_at(static_cast<T*>(mData) + head);
-			// Increment the head.
-			mHead.store((head + 1) % CAPACITY, std::memory_order::release);
-			// Decrease the size of the queue
-			mSize.fetch_sub(1, std::memory_order_release);
+			std::destroy_at(slot);
+			// Hand the slot back to the producer.
+			mHead.store(head + 1, std::memory_order::release);
 			// Return the value.
 			return value;
 		}
 
 
+		/// Moves up to output.size() values into output, releasing their slots all at once. Returns the number popped.
+		[[nodiscard]] size_t PopN(std::span<T> output) noexcept
+		{	ZoneScoped;
+			const size_t head = mHead.load(std::memory_order::relaxed);
+
+			if (mCachedTail - head < output.size())
+			{
+				mCachedTail = mTail.load(std::memory_order::acquire);
+			}
+
+			const size_t count = std::min(output.size(), mCachedTail - head);
+			for (size_t i = 0; i < count; i++)
+			{
+				T* slot = mData + ((head + i) & MASK);
+				output[i] = std::move(*slot);
+				std::destroy_at(slot);
+			}
+
+			mHead.store(head + count, std::memory_order::release);
+			return count;
+		}
+
+
 		[[nodiscard]] bool IsFull() const noexcept
 		{
-			return mSize.load(std::memory_order::acquire) == CAPACITY;
+			return Size() >= CAPACITY;
 		}
 
 
 		[[nodiscard]] bool IsEmpty() const noexcept
 		{
-			return mSize.load(std::memory_order::acquire) == 0;
+			return Size() == 0;
+		}
+
+
+		/// Returns the number of values in the queue. Only exact when called by the producer or consumer.
+		[[nodiscard]] size_t Size() const noexcept
+		{
+			// Load the head first, so that it can never be seen to be past the tail.
+			const size_t head = mHead.load(std::memory_order::acquire);
+			const size_t tail = mTail.load(std::memory_order::acquire);
+			return tail - head;
 		}
 
 
 	private:
-		/// The number of items stored in this queue
-		std::atomic<size_t> mSize = 0;
-		/// The index of the next position to be pushed to.
-		std::atomic<size_t> mHead = 0;
-		/// The index of the next position to be popped from.
-		std::atomic<size_t> mTail = 0;
-		/// A pointer to the underlying data for this queue.
-		void* mData = nullptr;
+		/// The size of the underlying buffer, rounded up so that indices can be masked rather than divided.
+		static constexpr size_t BUFFER_SIZE = std::bit_ceil(CAPACITY);
+		static constexpr size_t MASK        = BUFFER_SIZE - 1;
+
+
+		/// The index of the next position to be popped from. Written only by the consumer.
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> mHead = 0;
+		/// The consumer's copy of mTail.
+		size_t mCachedTail = 0;
+
+		/// The index of the next position to be pushed to. Written only by the producer.
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> mTail = 0;
+		/// The producer's copy of mHead.
+		size_t mCachedHead = 0;
+
+		/// A pointer to the underlying data for this queue. Kept off the index lines, since both threads read it.
+		alignas(CACHE_LINE_SIZE) T* mData = nullptr;
 	};
 
 
-	/// Class for a wait-free Multiple Producer, Multiple Consumer queue.
+	/// Lock free bounded Multiple Producer, Multiple Consumer queue.
+	///
+	/// Based on Dmitry Vyukov's bounded MPMC queue. Every cell carries a sequence number which says whether it is
+	/// ready to be pushed to or popped from for a given position, so producers and consumers only contend on their
+	/// own position counter, and a thread preempted mid-operation only delays the cell it has claimed.
 	///
-	/// Uses Core::Spinlock to ensure there is only ever one concurrent pusher, and one concurrent popper.
+	/// If constructing a value throws after its cell has been claimed, the cell is published empty, and consumers
+	/// skip it, so the queue keeps working.
 	template <typename T, size_t CAPACITY>
 	class MPMCQueue
 	{
+		static_assert(CAPACITY > 0);
+		// Pop moves values out, and cannot report a failure to.
+		static_assert(std::is_nothrow_move_constructible_v<T>);
+
 	public:
-		[[nodiscard]] bool Push(std::common_reference_with<T> auto value) noexcept
+		MPMCQueue()
+			: mCells(std::make_unique<Cell[]>(CAPACITY))
+		{
+			for (size_t i = 0; i < CAPACITY; i++)
+			{
+				mCells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+
+		MPMCQueue(const MPMCQueue&) = delete;
+		MPMCQueue& operator=(const MPMCQueue&) = delete;
+		MPMCQueue(MPMCQueue&&) = delete;
+		MPMCQueue& operator=(MPMCQueue&&) = delete;
+
+
+		~MPMCQueue()
 		{
-			mPushLock.Lock();
-			bool pop = mUnderlyingQueue.Push(std::forward<decltype(value)>(value));
-			mPushLock.Unlock();
-			return pop;
+			while (Pop()) {}
 		}
 
 
+		/// Push a value onto the queue. Returns true if the value was pushed.
+		/// If the queue is full, false is returned and value is left untouched.
+		/// If constructing the value throws, the exception is passed on and nothing is pushed.
+		template <typename U> requires (std::constructible_from<T, U&&>)
+		[[nodiscard]] bool Push(U&& value) noexcept(std::is_nothrow_constructible_v<T, U&&>)
+		{	ZoneScoped;
+			size_t position = mEnqueuePosition.load(std::memory_order::relaxed);
+			Cell* cell;
+			while (true)
+			{
+				cell = &mCells[position % CAPACITY];
+				const size_t sequence = cell->sequence.load(std::memory_order::acquire);
+				const auto   diff     = static_cast<std::ptrdiff_t>(sequence - position);
+
+				if (diff == 0)
+				{
+					// The cell is free for this position, so try to claim it.
+					if (mEnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order::relaxed))
+					{
+						break;
+					}
+				}
+				else if (diff < 0)
+				{
+					// The cell still holds the value from one lap ago, so the queue is full.
+					return false;
+				}
+				else
+				{
+					// Another producer claimed this position first.
+					position = mEnqueuePosition.load(std::memory_order::relaxed);
+				}
+			}
+
+			if constexpr (std::is_nothrow_constructible_v<T, U&&>)
+			{
+				std::construct_at(cell->Pointer(), std::forward<U>(value));
+			}
+			else
+			{
+				try
+				{
+					std::construct_at(cell->Pointer(), std::forward<U>(value));
+				}
+				catch (...)
+				{
+					// The position is already claimed, so it is published empty for a consumer to skip.
+					cell->filled = false;
+					cell->sequence.store(position + 1, std::memory_order::release);
+					throw;
+				}
+			}
+
+			cell->filled = true;
+			cell->sequence.store(position + 1, std::memory_order::release);
+			return true;
+		}
+
+
+		/// Pop a value from the queue if there is one.
 		[[nodiscard]] Optional<T> Pop() noexcept
+		{	ZoneScoped;
+			size_t position = mDequeuePosition.load(std::memory_order::relaxed);
+			Cell* cell;
+			while (true)
+			{
+				cell = &mCells[position % CAPACITY];
+				const size_t sequence = cell->sequence.load(std::memory_order::acquire);
+				const auto   diff     = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+				if (diff == 0)
+				{
+					// The cell has been filled for this position, so try to claim it.
+					if (mDequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order::relaxed))
+					{
+						if (cell->filled) [[likely]] break;
+
+						// The push to this position threw, so free the cell and move on to the next.
+						cell->sequence.store(position + CAPACITY, std::memory_order::release);
+						position++;
+					}
+				}
+				else if (diff < 0)
+				{
+					// The cell has not been filled yet, so the queue is empty.
+					return NullOpt;
+				}
+				else
+				{
+					// Another consumer claimed this position first.
+					position = mDequeuePosition.load(std::memory_order::relaxed);
+				}
+			}
+
+			T value = std::move(*cell->Pointer());
+			std::destroy_at(cell->Pointer());
+			// Mark the cell as free for the position one lap ahead.
+			cell->sequence.store(position + CAPACITY, std::memory_order::release);
+			return value;
+		}
+
+
+		/// Returns the number of values in the queue. Only approximate while other threads are using the queue.
+		[[nodiscard]] size_t Size() const noexcept
 		{
-			mPopLock.Lock();
-			auto pop = mUnderlyingQueue.Pop();
-			mPopLock.Unlock();
-			return pop;
+			// Load the dequeue position first, so that it can never be seen to be past the enqueue position.
+			const size_t dequeue = mDequeuePosition.load(std::memory_order::acquire);
+			const size_t enqueue = mEnqueuePosition.load(std::memory_order::acquire);
+			return std::min(enqueue - dequeue, CAPACITY);
 		}
 
 
 		[[nodiscard]] bool IsFull() const noexcept
 		{
-			return mUnderlyingQueue.IsFull();
+			return Size() == CAPACITY;
+		}
+
+
+		[[nodiscard]] bool IsEmpty() const noexcept
+		{
+			return Size() == 0;
+		}
+
+
+	private:
+		struct Cell
+		{
+			T* Pointer() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+
+			std::atomic<size_t> sequence;
+			/// Whether storage holds a value, which is false if the push which claimed the cell threw. Published by
+			/// sequence.
+			bool                filled = false;
+			alignas(T) std::byte storage[sizeof(T)];
+		};
+
+
+		/// The next position to be pushed to.
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> mEnqueuePosition = 0;
+		/// The next position to be popped from.
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> mDequeuePosition = 0;
+		alignas(CACHE_LINE_SIZE) std::unique_ptr<Cell[]> mCells;
+	};
+
+
+	/// MPMCQueue which can also be waited on.
+	///
+	/// PushWait and PopWait spin briefly, and then sleep on an atomic wait until the other side makes progress
+	/// or the given stop token is triggered. Compared with MPMCQueue, each Push and Pop pays for one memory
+	/// fence so that it can tell whether anyone needs waking.
+	template <typename T, size_t CAPACITY>
+	class BlockingMPMCQueue
+	{
+	public:
+		/// Push a value if there is space, without waiting. If the queue is full, value is left untouched.
+		template <typename U> requires (std::constructible_from<T, U&&>)
+		[[nodiscard]] bool Push(U&& value)
+		{
+			if (!mQueue.Push(std::forward<U>(value)))
+			{
+				return false;
+			}
+
+			Notify(mPushEpoch, mWaitingPoppers);
+			return true;
+		}
+
+
+		/// Pop a value if there is one, without waiting.
+		[[nodiscard]] Optional<T> Pop()
+		{
+			auto value = mQueue.Pop();
+			if (value)
+			{
+				Notify(mPopEpoch, mWaitingPushers);
+			}
+			return value;
+		}
+
+
+		/// Pushes value, waiting for space if the queue is full.
+		/// Returns false, leaving value untouched, if stop was requested before there was space.
+		template <typename U> requires (std::constructible_from<T, U&&>)
+		bool PushWait(U&& value, std::stop_token stop = {})
+		{
+			return Wait(mPopEpoch, mWaitingPushers, stop, [&] { return Push(std::forward<U>(value)); });
+		}
+
+
+		/// Pops a value, waiting for one if the queue is empty.
+		/// Returns nothing if stop was requested before a value arrived.
+		Optional<T> PopWait(std::stop_token stop = {})
+		{
+			Optional<T> value;
+			Wait(mPushEpoch, mWaitingPoppers, stop, [&] { value = Pop(); return value.HasValue(); });
+			return value;
+		}
+
+
+		[[nodiscard]] size_t Size() const noexcept { return mQueue.Size(); }
+		[[nodiscard]] bool IsFull() const noexcept { return mQueue.IsFull(); }
+		[[nodiscard]] bool IsEmpty() const noexcept { return mQueue.IsEmpty(); }
+
+
+	private:
+		/// The number of failed attempts before a waiting thread goes to sleep.
+		static constexpr unsigned int SPIN_COUNT = 64;
+
+
+		/// Wakes threads sleeping on epoch, if there are any.
+		static void Notify(std::atomic<uint32_t>& epoch, std::atomic<uint32_t>& waiting)
+		{
+			// Orders our update of the queue before reading the waiter count. Paired with the sequentially
+			// consistent increment in Wait, this means either we see the waiter, or the waiter sees our update.
+			std::atomic_thread_fence(std::memory_order::seq_cst);
+			if (waiting.load(std::memory_order::relaxed) > 0)
+			{
+				epoch.fetch_add(1, std::memory_order::release);
+				epoch.notify_all();
+			}
+		}
+
+
+		/// Retries operation until it succeeds or stop is requested, sleeping on epoch between attempts.
+		template <typename F>
+		static bool Wait(std::atomic<uint32_t>& epoch, std::atomic<uint32_t>& waiting, std::stop_token& stop, F&& operation)
+		{
+			ZoneScoped;
+
+			for (unsigned int i = 0; i < SPIN_COUNT; i++)
+			{
+				if (operation()) return true;
+			}
+
+			// Wakes us if stop is requested while we are asleep.
+			std::stop_callback wake(stop, [&epoch]
+			{
+				epoch.fetch_add(1, std::memory_order::release);
+				epoch.notify_all();
+			});
+
+			while (!stop.stop_requested())
+			{
+				const uint32_t current = epoch.load(std::memory_order::acquire);
+				waiting.fetch_add(1, std::memory_order::seq_cst);
+				const bool succeeded = operation();
+				if (!succeeded && !stop.stop_requested())
+				{
+					epoch.wait(current, std::memory_order::acquire);
+				}
+				waiting.fetch_sub(1, std::memory_order::relaxed);
+
+				if (succeeded) return true;
+			}
+
+			return false;
 		}
 
 
+		MPMCQueue<T, CAPACITY> mQueue;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> mPushEpoch = 0;
+		std::atomic<uint32_t> mWaitingPoppers = 0;
+		alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> mPopEpoch = 0;
+		std::atomic<uint32_t> mWaitingPushers = 0;
+	};
+
+
+	/// Unbounded lock free Multiple Producer, Single Consumer queue.
+	///
+	/// Based on Dmitry Vyukov's intrusive MPSC queue. A push is one atomic exchange plus one store, and never waits for
+	/// other threads. Nodes are only ever freed by the consumer, after it has moved past them, and producers only write
+	/// to the node they swapped out of the head, which the consumer cannot have moved past yet, so no further memory
+	/// reclamation is needed. A producer preempted between its exchange and its store hides its own value, and any
+	/// pushed after it, from the consumer until it resumes.
+	template <typename T>
+	class MPSCQueue
+	{
+	public:
+		MPSCQueue()
+			: mHead(new Node)
+			, mTail(mHead.load(std::memory_order::relaxed))
+		{}
+
+
+		MPSCQueue(const MPSCQueue&) = delete;
+		MPSCQueue& operator=(const MPSCQueue&) = delete;
+		MPSCQueue(MPSCQueue&&) = delete;
+		MPSCQueue& operator=(MPSCQueue&&) = delete;
+
+
+		~MPSCQueue()
+		{
+			while (Pop()) {}
+			delete mTail;
+		}
+
+
+		/// Push a value onto the queue. May be called from any thread.
+		template <typename U> requires (std::constructible_from<T, U&&>)
+		void Push(U&& value)
+		{
+			Node* node = new Node;
+			node->value.Emplace(std::forward<U>(value));
+
+			Node* previous = mHead.exchange(node, std::memory_order::acq_rel);
+			previous->next.store(node, std::memory_order::release);
+		}
+
+
+		/// Pop a value from the queue if there is one. Must only be called from the consumer thread.
+		[[nodiscard]] Optional<T> Pop()
+		{
+			Node* next = mTail->next.load(std::memory_order::acquire);
+			if (!next) return NullOpt;
+
+			// Next becomes the new stub node, so its value is moved out, and the old stub is freed.
+			Optional<T> value = std::move(next->value);
+			next->value.Reset();
+			delete std::exchange(mTail, next);
+			return value;
+		}
+
+
+		/// Returns whether the queue is empty. Must only be called from the consumer thread.
 		[[nodiscard]] bool IsEmpty() const noexcept
 		{
-			return mUnderlyingQueue.IsEmpty();
+			return mTail->next.load(std::memory_order::acquire) == nullptr;
 		}
 
 
 	private:
-		Spinlock mPushLock;
-		Spinlock mPopLock;
-		SPSCQueue<T, CAPACITY> mUnderlyingQueue;
+		struct Node
+		{
+			std::atomic<Node*> next = nullptr;
+			Optional<T>        value;
+		};
+
+
+		/// The most recently pushed node, which producers swap themselves into.
+		alignas(CACHE_LINE_SIZE) std::atomic<Node*> mHead;
+		/// The stub node before the next value to pop, only used by the consumer.
+		alignas(CACHE_LINE_SIZE) Node* mTail;
 	};
 }
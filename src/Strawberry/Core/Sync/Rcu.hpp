@@ -0,0 +1,233 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+#include "Strawberry/Core/Util/Alloc.hpp"
+// Standard Library
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace Strawberry::Core
+{
+	/// Read-copy-update cell, for larger state which is read far more often than it is written.
+	///
+	/// Readers get a const reference to the current version, and never block. Writers build a new version, publish it
+	/// with a single atomic pointer swap, and then wait for every reader of the old version to finish before deleting it.
+	///
+	/// Readers are counted in one of several counters, chosen per thread, so that readers on different threads do not
+	/// write to the same cache line. As in sleepable RCU, each counter has two halves, and a writer flips which half new
+	/// readers use, so that it only ever waits for readers which started before the new version was published.
+	///
+	/// A thread must not write while it holds a ReadGuard of the same cell, as the writer would wait for its own read
+	/// forever.
+	template<typename T>
+	class Rcu
+	{
+		struct alignas(CACHE_LINE_SIZE) ReaderCounter
+		{
+			std::array<std::atomic<size_t>, 2> count{};
+		};
+
+
+	public:
+		/// Keeps the version of the value which was current when it was created alive.
+		class ReadGuard
+		{
+			friend class Rcu;
+
+		public:
+			ReadGuard(const ReadGuard&) = delete;
+			ReadGuard& operator=(const ReadGuard&) = delete;
+
+
+			ReadGuard(ReadGuard&& other) noexcept
+				: mCounter(std::exchange(other.mCounter, nullptr))
+				, mPayload(other.mPayload)
+#if STRAWBERRY_CORE_ENABLE_ASSERTIONS
+				, mOwner(other.mOwner)
+#endif
+			{}
+
+
+			ReadGuard& operator=(ReadGuard&& other) noexcept
+			{
+				if (this != &other)
+				{
+					Release();
+					mCounter = std::exchange(other.mCounter, nullptr);
+					mPayload = other.mPayload;
+#if STRAWBERRY_CORE_ENABLE_ASSERTIONS
+					mOwner   = other.mOwner;
+#endif
+				}
+				return *this;
+			}
+
+
+			~ReadGuard()
+			{
+				Release();
+			}
+
+
+			const T& operator*() const noexcept { return *mPayload; }
+			const T* operator->() const noexcept { return mPayload; }
+
+
+		private:
+			ReadGuard(std::atomic<size_t>& counter, const T* payload, [[maybe_unused]] const Rcu* owner)
+				: mCounter(&counter)
+				, mPayload(payload)
+#if STRAWBERRY_CORE_ENABLE_ASSERTIONS
+				, mOwner(owner)
+#endif
+			{
+#if STRAWBERRY_CORE_ENABLE_ASSERTIONS
+				HeldByThisThread().emplace_back(mOwner);
+#endif
+			}
+
+
+			void Release() noexcept
+			{
+				if (!mCounter) return;
+
+				mCounter->fetch_sub(1, std::memory_order::release);
+#if STRAWBERRY_CORE_ENABLE_ASSERTIONS
+				auto& held = HeldByThisThread();
+				if (auto guard = std::ranges::find(held, mOwner); guard != held.end()) held.erase(guard);
+#endif
+			}
+
+
+			std::atomic<size_t>* mCounter;
+			const T*             mPayload;
+#if STRAWBERRY_CORE_ENABLE_ASSERTIONS
+			/// The cell this guard reads, to catch its thread writing to it.
+			const Rcu*           mOwner;
+#endif
+		};
+
+
+		template<typename... Args> requires (std::constructible_from<T, Args...>)
+		explicit Rcu(Args&&... args)
+			: mCurrent(new T(std::forward<Args>(args)...)) {}
+
+
+		Rcu(const Rcu&) = delete;
+		Rcu& operator=(const Rcu&) = delete;
+
+
+		~Rcu()
+		{
+			delete mCurrent.load(std::memory_order::acquire);
+		}
+
+
+		/// Returns a guard for the current version. Later writes will not affect it.
+		[[nodiscard]] ReadGuard Read() const noexcept
+		{
+			auto& counter = mReaders[ThreadIndex() % READER_COUNTERS].count[mPhase.load(std::memory_order::seq_cst) % 2];
+			counter.fetch_add(1, std::memory_order::seq_cst);
+			return {counter, mCurrent.load(std::memory_order::seq_cst), this};
+		}
+
+
+		/// Publishes value, and deletes the previous version once nobody is reading it.
+		/// Must not be called while the calling thread holds a ReadGuard of this cell, as it would wait for it forever.
+		void Store(T value)
+		{
+			AssertNotReading();
+			Publish(std::make_unique<T>(std::move(value)));
+		}
+
+
+		/// Publishes a copy of the current version modified by function, with no other write in between.
+		/// Must not be called while the calling thread holds a ReadGuard of this cell, as it would wait for it forever.
+		template<std::invocable<T&> F>
+		void Update(F&& function)
+		{
+			AssertNotReading();
+			std::unique_lock lock(mWriterMutex);
+
+			auto next = std::make_unique<T>(*mCurrent.load(std::memory_order::relaxed));
+			std::invoke(std::forward<F>(function), *next);
+			PublishLocked(std::move(next));
+		}
+
+
+	private:
+		static constexpr size_t READER_COUNTERS = 16;
+
+
+		void Publish(std::unique_ptr<T> next)
+		{
+			std::unique_lock lock(mWriterMutex);
+			PublishLocked(std::move(next));
+		}
+
+
+		void PublishLocked(std::unique_ptr<T> next)
+		{
+			ZoneScoped;
+
+			std::unique_ptr<T> previous(mCurrent.exchange(next.release(), std::memory_order::seq_cst));
+
+			// Readers which loaded the phase before the first flip may have registered in either half, so both are drained.
+			for (int pass = 0; pass < 2; pass++)
+			{
+				const unsigned int phase = mPhase.fetch_add(1, std::memory_order::seq_cst);
+				for (auto& reader : mReaders)
+				{
+					while (reader.count[phase % 2].load(std::memory_order::seq_cst) != 0)
+					{
+						std::this_thread::yield();
+					}
+				}
+			}
+		}
+
+
+		/// Checks that the calling thread holds no ReadGuard of this cell, which a write would wait for forever.
+		void AssertNotReading() const
+		{
+#if STRAWBERRY_CORE_ENABLE_ASSERTIONS
+			Assert(!std::ranges::contains(HeldByThisThread(), this), "Wrote to an Rcu while holding a ReadGuard of it!");
+#endif
+		}
+
+
+#if STRAWBERRY_CORE_ENABLE_ASSERTIONS
+		/// The cells which the calling thread holds a ReadGuard of, once for each guard. The reader counters are shared
+		/// between threads, so cannot tell which thread is reading.
+		static std::vector<const Rcu*>& HeldByThisThread() noexcept
+		{
+			thread_local std::vector<const Rcu*> sHeld;
+			return sHeld;
+		}
+#endif
+
+
+		/// Spreads threads over the reader counters.
+		static size_t ThreadIndex() noexcept
+		{
+			static std::atomic<size_t> sNextIndex = 0;
+			thread_local const size_t sIndex = sNextIndex.fetch_add(1, std::memory_order::relaxed);
+			return sIndex;
+		}
+
+
+		std::atomic<T*>                                    mCurrent;
+		std::atomic<unsigned int>                          mPhase = 0;
+		mutable std::array<ReaderCounter, READER_COUNTERS> mReaders;
+		std::mutex                                         mWriterMutex;
+	};
+}
@@ -0,0 +1,387 @@
+#include "Reclamation.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Util/Alloc.hpp"
+// Standard Library
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+
+namespace Strawberry::Core::LockFree
+{
+	namespace
+	{
+		/// An object waiting to be deleted, and the epoch in which it was retired.
+		struct RetiredObject
+		{
+			void*    object;
+			void   (*deleter)(void*);
+			uint64_t epoch;
+		};
+
+
+		/// Deletes the objects matching predicate, and removes them from retired.
+		template <typename P>
+		void DeleteIf(std::vector<RetiredObject>& retired, P&& predicate)
+		{
+			auto kept = std::ranges::partition(retired, [&] (const RetiredObject& r) { return !predicate(r); }).begin();
+
+			// Deleters may retire more objects, so the list must be consistent before any of them run.
+			std::vector<RetiredObject> reclaimed(kept, retired.end());
+			retired.erase(kept, retired.end());
+			for (const RetiredObject& r : reclaimed)
+			{
+				r.deleter(r.object);
+			}
+		}
+
+
+		/// Retired objects left behind by threads which have exited, to be adopted by a later collection.
+		struct Orphans
+		{
+			~Orphans()
+			{
+				// No threads can be running lock-free code once statics are destroyed.
+				for (const RetiredObject& r : objects)
+				{
+					r.deleter(r.object);
+				}
+			}
+
+
+			void Adopt(std::vector<RetiredObject>& retired)
+			{
+				std::unique_lock lock(mutex);
+				objects.insert(objects.end(), retired.begin(), retired.end());
+				retired.clear();
+			}
+
+
+			/// Moves the orphans into retired, blocking if wait, and otherwise only if nobody else holds the lock.
+			void MoveInto(std::vector<RetiredObject>& retired, bool wait)
+			{
+				std::unique_lock lock(mutex, std::defer_lock);
+				if (wait) lock.lock();
+				else if (!lock.try_lock()) return;
+
+				retired.insert(retired.end(), objects.begin(), objects.end());
+				objects.clear();
+			}
+
+
+			size_t Size()
+			{
+				std::unique_lock lock(mutex);
+				return objects.size();
+			}
+
+
+			std::mutex                 mutex;
+			std::vector<RetiredObject> objects;
+		};
+
+
+		/// Claims an unused record from an intrusive list, or pushes a new one onto it. Records are never freed, only reused.
+		template <typename Record>
+		Record* AcquireRecord(std::atomic<Record*>& head, std::atomic<size_t>* count = nullptr)
+		{
+			for (Record* record = head.load(std::memory_order::acquire); record; record = record->next)
+			{
+				bool inUse = false;
+				if (!record->inUse.load(std::memory_order::relaxed)
+					&& record->inUse.compare_exchange_strong(inUse, true, std::memory_order::acquire, std::memory_order::relaxed))
+				{
+					return record;
+				}
+			}
+
+			if (count) count->fetch_add(1, std::memory_order::relaxed);
+			Record* record = new Record();
+			record->next = head.load(std::memory_order::relaxed);
+			while (!head.compare_exchange_weak(record->next, record, std::memory_order::release, std::memory_order::relaxed)) {}
+			return record;
+		}
+
+
+		//==============================================================================================================
+		//  Epochs
+		//--------------------------------------------------------------------------------------------------------------
+		/// The number of objects a thread retires between attempts to reclaim them.
+		constexpr size_t EPOCH_COLLECT_THRESHOLD = 64;
+		/// The epoch of objects which have been retired since the last time the epoch was read.
+		constexpr uint64_t UNSEALED_EPOCH = std::numeric_limits<uint64_t>::max();
+
+
+		struct alignas(CACHE_LINE_SIZE) EpochRecord
+		{
+			/// The epoch shifted left by one, with the lowest bit set while the thread is pinned.
+			std::atomic<uint64_t> state = 0;
+			std::atomic_bool      inUse = true;
+			EpochRecord*          next  = nullptr;
+		};
+
+
+		constinit std::atomic<uint64_t>     sGlobalEpoch  = 0;
+		constinit std::atomic<EpochRecord*> sEpochRecords = nullptr;
+
+
+		Orphans& EpochOrphans()
+		{
+			static Orphans orphans;
+			return orphans;
+		}
+
+
+		/// Gives every unsealed object at the end of retired the current epoch.
+		///
+		/// Objects are only sealed in batches, so that retiring one only costs a fence per batch. Sealing with a later
+		/// epoch than the one an object was really retired in is safe, since it just delays reclaiming it.
+		void SealEpoch(std::vector<RetiredObject>& retired)
+		{
+			if (retired.empty() || retired.back().epoch != UNSEALED_EPOCH) return;
+
+			// Orders unlinking the objects before reading the epoch they are retired in.
+			std::atomic_thread_fence(std::memory_order::seq_cst);
+			const uint64_t epoch = sGlobalEpoch.load(std::memory_order::relaxed);
+			for (auto r = retired.rbegin(); r != retired.rend() && r->epoch == UNSEALED_EPOCH; ++r)
+			{
+				r->epoch = epoch;
+			}
+		}
+
+
+		struct EpochThreadState
+		{
+			~EpochThreadState()
+			{
+				SealEpoch(retired);
+				if (!retired.empty()) EpochOrphans().Adopt(retired);
+				if (record)
+				{
+					record->state.store(0, std::memory_order::relaxed);
+					record->inUse.store(false, std::memory_order::release);
+				}
+			}
+
+
+			EpochRecord*               record  = nullptr;
+			unsigned int               nesting = 0;
+			std::vector<RetiredObject> retired;
+		};
+
+
+		thread_local EpochThreadState tEpochState;
+
+
+		/// Increments the global epoch if every pinned thread has already seen the current one.
+		void TryAdvanceEpoch()
+		{
+			uint64_t epoch = sGlobalEpoch.load(std::memory_order::relaxed);
+			std::atomic_thread_fence(std::memory_order::seq_cst);
+
+			for (EpochRecord* record = sEpochRecords.load(std::memory_order::acquire); record; record = record->next)
+			{
+				const uint64_t state = record->state.load(std::memory_order::relaxed);
+				if ((state & 1) && (state >> 1) != epoch)
+				{
+					return;
+				}
+			}
+
+			std::atomic_thread_fence(std::memory_order::acquire);
+			sGlobalEpoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order::release, std::memory_order::relaxed);
+		}
+
+
+		void CollectEpoch(std::vector<RetiredObject>& retired, bool waitForOrphans)
+		{
+			ZoneScoped;
+
+			SealEpoch(retired);
+			EpochOrphans().MoveInto(retired, waitForOrphans);
+			TryAdvanceEpoch();
+
+			const uint64_t epoch = sGlobalEpoch.load(std::memory_order::acquire);
+			DeleteIf(retired, [epoch] (const RetiredObject& r) { return r.epoch + 2 <= epoch; });
+		}
+
+
+		//==============================================================================================================
+		//  Hazard Pointers
+		//--------------------------------------------------------------------------------------------------------------
+		/// The smallest number of objects a thread retires between scans of the hazard pointers.
+		constexpr size_t HAZARD_SCAN_THRESHOLD = 64;
+
+
+		struct alignas(CACHE_LINE_SIZE) HazardRecord
+		{
+			std::atomic<void*> hazard = nullptr;
+			std::atomic_bool   inUse  = true;
+			HazardRecord*      next   = nullptr;
+		};
+
+
+		constinit std::atomic<HazardRecord*> sHazardRecords     = nullptr;
+		constinit std::atomic<size_t>        sHazardRecordCount = 0;
+
+
+		Orphans& HazardOrphans()
+		{
+			static Orphans orphans;
+			return orphans;
+		}
+
+
+		struct HazardThreadState
+		{
+			~HazardThreadState()
+			{
+				if (!retired.empty()) HazardOrphans().Adopt(retired);
+				for (HazardRecord* record : freeRecords)
+				{
+					record->inUse.store(false, std::memory_order::release);
+				}
+			}
+
+
+			/// Records owned by this thread which no Guard is using, so that creating a Guard is usually uncontended.
+			std::vector<HazardRecord*> freeRecords;
+			std::vector<RetiredObject> retired;
+			std::vector<void*>         hazards;
+		};
+
+
+		thread_local HazardThreadState tHazardState;
+
+
+		void ScanHazards(HazardThreadState& state, bool waitForOrphans)
+		{
+			ZoneScoped;
+
+			HazardOrphans().MoveInto(state.retired, waitForOrphans);
+
+			// Pairs with the fence in Guard::Protect, so that every hazard published before the object was unlinked is seen.
+			std::atomic_thread_fence(std::memory_order::seq_cst);
+
+			state.hazards.clear();
+			for (HazardRecord* record = sHazardRecords.load(std::memory_order::acquire); record; record = record->next)
+			{
+				if (void* hazard = record->hazard.load(std::memory_order::acquire))
+				{
+					state.hazards.emplace_back(hazard);
+				}
+			}
+			std::ranges::sort(state.hazards);
+
+			DeleteIf(state.retired, [&] (const RetiredObject& r) { return !std::ranges::binary_search(state.hazards, r.object); });
+		}
+	}
+
+
+	void EpochReclaimer::Pin() noexcept
+	{
+		EpochThreadState& state = tEpochState;
+		if (state.nesting++ > 0) return;
+
+		if (!state.record) [[unlikely]]
+		{
+			state.record = AcquireRecord(sEpochRecords);
+		}
+
+		state.record->state.store((sGlobalEpoch.load(std::memory_order::relaxed) << 1) | 1, std::memory_order::relaxed);
+		// Orders announcing the epoch before any loads from the structure.
+		std::atomic_thread_fence(std::memory_order::seq_cst);
+	}
+
+
+	void EpochReclaimer::Unpin() noexcept
+	{
+		EpochThreadState& state = tEpochState;
+		if (--state.nesting == 0)
+		{
+			state.record->state.store(0, std::memory_order::release);
+		}
+	}
+
+
+	void EpochReclaimer::Retire(void* object, void (*deleter)(void*))
+	{
+		EpochThreadState& state = tEpochState;
+		state.retired.emplace_back(RetiredObject{object, deleter, UNSEALED_EPOCH});
+
+		if (state.retired.size() % EPOCH_COLLECT_THRESHOLD == 0)
+		{
+			CollectEpoch(state.retired, false);
+		}
+	}
+
+
+	void EpochReclaimer::Flush()
+	{
+		// Each object needs two advances, and the first may only catch up with an epoch which another thread began.
+		for (int i = 0; i < 3; i++)
+		{
+			TryAdvanceEpoch();
+		}
+		CollectEpoch(tEpochState.retired, true);
+	}
+
+
+	size_t EpochReclaimer::PendingCount()
+	{
+		return tEpochState.retired.size() + EpochOrphans().Size();
+	}
+
+
+	HazardPointerReclaimer::Guard::Guard()
+	{
+		HazardThreadState& state = tHazardState;
+		HazardRecord* record;
+		if (!state.freeRecords.empty())
+		{
+			record = state.freeRecords.back();
+			state.freeRecords.pop_back();
+		}
+		else
+		{
+			record = AcquireRecord(sHazardRecords, &sHazardRecordCount);
+		}
+		mHazard = &record->hazard;
+	}
+
+
+	HazardPointerReclaimer::Guard::~Guard()
+	{
+		mHazard->store(nullptr, std::memory_order::release);
+
+		// The hazard is the first member of its record.
+		tHazardState.freeRecords.emplace_back(reinterpret_cast<HazardRecord*>(mHazard));
+	}
+
+
+	void HazardPointerReclaimer::Retire(void* object, void (*deleter)(void*))
+	{
+		HazardThreadState& state = tHazardState;
+		state.retired.emplace_back(RetiredObject{object, deleter, 0});
+
+		// Scanning costs a pass over every record, so it is amortised over at least that many retirements.
+		const size_t threshold = std::max(HAZARD_SCAN_THRESHOLD, 2 * sHazardRecordCount.load(std::memory_order::relaxed));
+		if (state.retired.size() >= threshold)
+		{
+			ScanHazards(state, false);
+		}
+	}
+
+
+	void HazardPointerReclaimer::Flush()
+	{
+		ScanHazards(tHazardState, true);
+	}
+
+
+	size_t HazardPointerReclaimer::PendingCount()
+	{
+		return tHazardState.retired.size() + HazardOrphans().Size();
+	}
+}
@@ -0,0 +1,159 @@
+#pragma once
+// Standard Library
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Strawberry::Core::LockFree
+{
+	/// Deleter used for objects retired as a T.
+	template <typename T>
+	void DeleteRetired(void* object)
+	{
+		delete static_cast<T*>(object);
+	}
+
+
+	/// Safe memory reclamation for node based lock-free structures.
+	///
+	/// A thread which is going to dereference a pointer loaded from a shared atomic holds a Guard, and loads the pointer
+	/// through Guard::Protect. Once a node has been unlinked, it is passed to Retire instead of being deleted, and the
+	/// reclaimer deletes it once no Guard could still be reading it.
+	template <typename R>
+	concept Reclaimer = std::default_initializable<typename R::Guard>
+		&& requires (typename R::Guard& guard, const std::atomic<int*>& source, int* object)
+	{
+		{ guard.Protect(source) } -> std::same_as<int*>;
+		R::Retire(object);
+		R::Flush();
+	};
+
+
+	/// Epoch based reclamation.
+	///
+	/// Guards are very cheap: pinning stores the global epoch into a per-thread record and issues a fence, and Protect
+	/// is a plain load. An object retired during epoch E is deleted once the global epoch reaches E + 2, which can only
+	/// happen after every pinned thread has been seen in a later epoch. The cost is that one thread which stays pinned
+	/// stops all reclamation until it unpins, so guards should be short lived.
+	class EpochReclaimer
+	{
+	public:
+		/// Pins the calling thread for its lifetime. Guards may be nested.
+		class Guard
+		{
+		public:
+			Guard() noexcept { Pin(); }
+			~Guard() { Unpin(); }
+
+			Guard(const Guard&) = delete;
+			Guard& operator=(const Guard&) = delete;
+
+
+			template <typename T>
+			T* Protect(const std::atomic<T*>& source) const noexcept
+			{
+				return source.load(std::memory_order::acquire);
+			}
+		};
+
+
+		/// Deletes object once no thread can be reading it. Object must already be unreachable from the structure.
+		template <typename T>
+		static void Retire(T* object)
+		{
+			Retire(object, &DeleteRetired<T>);
+		}
+
+
+		static void Retire(void* object, void (*deleter)(void*));
+
+
+		/// Advances the epoch as far as possible, and reclaims every object which no thread can still be reading.
+		///
+		/// While the calling thread holds a Guard, the epoch cannot advance far enough for any recent objects to be reclaimed.
+		static void Flush();
+
+
+		/// Returns the number of objects retired by the calling thread or by threads which have exited, which have not yet been deleted.
+		static size_t PendingCount();
+
+
+	private:
+		static void Pin() noexcept;
+		static void Unpin() noexcept;
+	};
+
+
+	/// Hazard pointer based reclamation.
+	///
+	/// Each Guard owns a hazard pointer slot, which Protect publishes the loaded pointer in before checking that it is
+	/// still current. A retired object is deleted by a scan which finds it in no slot. Guards cost a fence per Protect,
+	/// but unlike epochs, a stalled reader only keeps the one object it protects alive.
+	class HazardPointerReclaimer
+	{
+	public:
+		/// Holds one hazard pointer, which protects the last object loaded through it.
+		class Guard
+		{
+		public:
+			Guard();
+			~Guard();
+
+			Guard(const Guard&) = delete;
+			Guard& operator=(const Guard&) = delete;
+
+
+			template <typename T>
+			T* Protect(const std::atomic<T*>& source) noexcept
+			{
+				T* object = source.load(std::memory_order::relaxed);
+				while (true)
+				{
+					mHazard->store(object, std::memory_order::relaxed);
+					// Orders publishing the hazard before checking that the object is still reachable.
+					std::atomic_thread_fence(std::memory_order::seq_cst);
+
+					T* current = source.load(std::memory_order::acquire);
+					if (current == object) return object;
+					object = current;
+				}
+			}
+
+
+			/// Stops protecting the last object loaded.
+			void Reset() noexcept
+			{
+				mHazard->store(nullptr, std::memory_order::release);
+			}
+
+
+		private:
+			std::atomic<void*>* mHazard;
+		};
+
+
+		/// Deletes object once it is not protected by any Guard. Object must already be unreachable from the structure.
+		template <typename T>
+		static void Retire(T* object)
+		{
+			Retire(object, &DeleteRetired<T>);
+		}
+
+
+		static void Retire(void* object, void (*deleter)(void*));
+
+
+		/// Reclaims every retired object which is not currently protected.
+		static void Flush();
+
+
+		/// Returns the number of objects retired by the calling thread or by threads which have exited, which have not yet been deleted.
+		static size_t PendingCount();
+	};
+
+
+	static_assert(Reclaimer<EpochReclaimer>);
+	static_assert(Reclaimer<HazardPointerReclaimer>);
+}
@@ -0,0 +1,135 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Sync/Spinlock.hpp"
+// Standard Library
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+
+namespace Strawberry::Core
+{
+	/// A seqlock protected copy of a small, trivially copyable value, for state which is read far more often than it is written.
+	///
+	/// Readers never block and never write to shared memory. They copy the value out and retry if a writer was
+	/// publishing a new one at the same time. Writers are serialised with each other, and each write is seen by
+	/// readers either entirely or not at all.
+	template<typename T> requires (std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>)
+	class Snapshot
+	{
+	public:
+		/// Holds the value whose bytes are all zero. Constant initialised, so that it can be used safely from static constructors.
+		constexpr Snapshot() noexcept = default;
+
+
+		explicit Snapshot(const T& value)
+		{
+			StoreWords(value);
+		}
+
+
+		Snapshot(const Snapshot&) = delete;
+		Snapshot& operator=(const Snapshot&) = delete;
+
+
+		/// Returns a consistent copy of the current value.
+		[[nodiscard]] T Load() const noexcept
+		{
+			while (true)
+			{
+				const uint64_t before = mSequence.load(std::memory_order::acquire);
+				if (before % 2 == 0) [[likely]]
+				{
+					T value = LoadWords();
+					std::atomic_thread_fence(std::memory_order::acquire);
+					if (mSequence.load(std::memory_order::relaxed) == before) [[likely]]
+					{
+						return value;
+					}
+				}
+
+				CpuRelax();
+			}
+		}
+
+
+		/// Publishes a new value.
+		void Store(const T& value) noexcept
+		{
+			const uint64_t sequence = BeginWrite();
+			StoreWords(value);
+			EndWrite(sequence);
+		}
+
+
+		/// Replaces the value with the result of calling function on it, with no other write in between.
+		template<std::invocable<const T&> F> requires (std::convertible_to<std::invoke_result_t<F, const T&>, T>)
+		void Update(F&& function)
+		{
+			const uint64_t sequence = BeginWrite();
+			// Only writers modify the words, and we are the only writer, so this read cannot be torn.
+			StoreWords(std::invoke(std::forward<F>(function), LoadWords()));
+			EndWrite(sequence);
+		}
+
+
+	private:
+		using Word = uintptr_t;
+		static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+
+		/// Waits for the sequence number to be even, and makes it odd, which excludes other writers and invalidates readers.
+		uint64_t BeginWrite() noexcept
+		{
+			uint64_t sequence = mSequence.load(std::memory_order::relaxed);
+			while (sequence % 2 != 0 || !mSequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order::acquire, std::memory_order::relaxed))
+			{
+				CpuRelax();
+				sequence = mSequence.load(std::memory_order::relaxed);
+			}
+			// Orders the payload stores after the sequence number becomes odd.
+			std::atomic_thread_fence(std::memory_order::release);
+			return sequence;
+		}
+
+
+		void EndWrite(uint64_t sequence) noexcept
+		{
+			mSequence.store(sequence + 2, std::memory_order::release);
+		}
+
+
+		/// The payload is held as atomic words, so that a reader racing with a writer is not a data race.
+		T LoadWords() const noexcept
+		{
+			std::array<Word, WORD_COUNT> words;
+			for (size_t i = 0; i < WORD_COUNT; i++)
+			{
+				words[i] = mWords[i].load(std::memory_order::relaxed);
+			}
+
+			T value;
+			std::memcpy(&value, words.data(), sizeof(T));
+			return value;
+		}
+
+
+		void StoreWords(const T& value) noexcept
+		{
+			std::array<Word, WORD_COUNT> words{};
+			std::memcpy(words.data(), &value, sizeof(T));
+			for (size_t i = 0; i < WORD_COUNT; i++)
+			{
+				mWords[i].store(words[i], std::memory_order::relaxed);
+			}
+		}
+
+
+		std::atomic<uint64_t>                     mSequence = 0;
+		std::array<std::atomic<Word>, WORD_COUNT> mWords{};
+	};
+}
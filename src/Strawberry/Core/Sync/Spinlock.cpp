@@ -1,15 +1,53 @@
 #include "Spinlock.hpp"
+// Standard Library
+#include <algorithm>
+#include <thread>
 
 
 namespace Strawberry::Core
 {
-	void Spinlock::Lock() noexcept
+	void Spinlock::LockSlow() noexcept
 	{
-		while (mFlag.test_and_set(std::memory_order::acquire));
-	}
+		ZoneScoped;
 
-	void Spinlock::Unlock() noexcept
-	{
-		mFlag.clear(std::memory_order_release);
+		/// The total number of pauses to spin for before yielding.
+		static constexpr unsigned int SPIN_LIMIT = 1024;
+		/// The largest number of pauses between two attempts.
+		static constexpr unsigned int MAX_BACKOFF = 64;
+		/// The number of times to yield before sleeping.
+		static constexpr unsigned int YIELD_LIMIT = 4;
+
+
+		// Test and test-and-set, so that spinning only reads the cache line until the lock looks free.
+		for (unsigned int spins = 0, backoff = 1; spins < SPIN_LIMIT; spins += backoff, backoff = std::min(2 * backoff, MAX_BACKOFF))
+		{
+			if (mState.load(std::memory_order::relaxed) == UNLOCKED && TryLock())
+			{
+				return;
+			}
+
+			for (unsigned int i = 0; i < backoff; i++)
+			{
+				CpuRelax();
+			}
+		}
+
+
+		for (unsigned int i = 0; i < YIELD_LIMIT; i++)
+		{
+			std::this_thread::yield();
+			if (mState.load(std::memory_order::relaxed) == UNLOCKED && TryLock())
+			{
+				return;
+			}
+		}
+
+
+		// Mark the lock as contended, so that the holder wakes us when it unlocks. Once we have slept, we can't
+		// know whether anyone else is still sleeping, so we keep taking the lock as contended.
+		while (mState.exchange(CONTENDED, std::memory_order::acquire) != UNLOCKED)
+		{
+			mState.wait(CONTENDED, std::memory_order::relaxed);
+		}
 	}
 }
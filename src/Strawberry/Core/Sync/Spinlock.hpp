@@ -1,19 +1,80 @@
 #pragma once
 // Standard Library
 #include <atomic>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_ARM64) || defined(_M_ARM))
+	#include <intrin.h>
+#endif
 
 
 namespace Strawberry::Core
 {
-	/// Class for a wait-free spin lock.
+	/// Hints to the CPU that we are in a spin loop, which saves power and frees resources for a sibling hyperthread.
+	inline void CpuRelax() noexcept
+	{
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+		_mm_pause();
+#elif defined(_MSC_VER) && (defined(_M_ARM64) || defined(_M_ARM))
+		__yield();
+#elif defined(__aarch64__) || defined(__arm__)
+		__asm__ __volatile__("yield");
+#endif
+	}
+
+
+	/// Class for an adaptive spin lock.
+	///
+	/// Waiting threads spin on a plain load with exponential backoff, so that they do not fight over the cache line,
+	/// then yield a few times, and finally sleep on an atomic wait until the lock is released. Uncontended locking
+	/// and unlocking is a single atomic operation each.
+	///
+	/// Satisfies the standard Lockable requirements, so may be used with std::scoped_lock and std::unique_lock.
 	class Spinlock
 	{
 	public:
-		void Lock() noexcept;
-		void Unlock() noexcept;
+		void Lock() noexcept
+		{
+			if (!TryLock()) [[unlikely]]
+			{
+				LockSlow();
+			}
+		}
+
+
+		[[nodiscard]] bool TryLock() noexcept
+		{
+			uint32_t expected = UNLOCKED;
+			return mState.compare_exchange_strong(expected, LOCKED, std::memory_order::acquire, std::memory_order::relaxed);
+		}
+
+
+		void Unlock() noexcept
+		{
+			if (mState.exchange(UNLOCKED, std::memory_order::release) == CONTENDED) [[unlikely]]
+			{
+				mState.notify_one();
+			}
+		}
+
+
+		void lock() noexcept { Lock(); }
+		[[nodiscard]] bool try_lock() noexcept { return TryLock(); }
+		void unlock() noexcept { Unlock(); }
 
 
 	private:
-		std::atomic_flag mFlag;
+		static constexpr uint32_t UNLOCKED  = 0;
+		static constexpr uint32_t LOCKED    = 1;
+		/// Locked, and there may be threads sleeping on the lock which need waking when it is released.
+		static constexpr uint32_t CONTENDED = 2;
+
+
+		void LockSlow() noexcept;
+
+
+		std::atomic<uint32_t> mState = UNLOCKED;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,79 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Sync/Reclamation.hpp"
+#include "Strawberry/Core/Types/Optional.hpp"
+// Standard Library
+#include <atomic>
+#include <concepts>
+#include <utility>
+
+
+namespace Strawberry::Core::LockFree
+{
+	/// Unbounded lock free stack (Treiber stack), for any number of pushing and popping threads.
+	///
+	/// Popped nodes are handed to R, so that a thread which loaded the old top can still read its next pointer, and so
+	/// that a node cannot be freed and reallocated at the same address while another thread is trying to pop it.
+	template <typename T, Reclaimer R = EpochReclaimer>
+	class Stack
+	{
+	public:
+		Stack() = default;
+		Stack(const Stack&) = delete;
+		Stack& operator=(const Stack&) = delete;
+
+
+		~Stack()
+		{
+			Node* node = mTop.load(std::memory_order::acquire);
+			while (node)
+			{
+				delete std::exchange(node, node->next);
+			}
+		}
+
+
+		template <typename U> requires (std::constructible_from<T, U&&>)
+		void Push(U&& value)
+		{
+			Node* node = new Node{T(std::forward<U>(value)), mTop.load(std::memory_order::relaxed)};
+			while (!mTop.compare_exchange_weak(node->next, node, std::memory_order::release, std::memory_order::relaxed)) {}
+		}
+
+
+		Optional<T> Pop()
+		{
+			typename R::Guard guard;
+			while (true)
+			{
+				Node* top = guard.Protect(mTop);
+				if (!top) return NullOpt;
+
+				// Nodes are never modified once pushed, and top cannot be freed while it is protected.
+				if (mTop.compare_exchange_weak(top, top->next, std::memory_order::acquire, std::memory_order::relaxed))
+				{
+					Optional<T> value(std::move(top->value));
+					R::Retire(top);
+					return value;
+				}
+			}
+		}
+
+
+		[[nodiscard]] bool IsEmpty() const noexcept
+		{
+			return mTop.load(std::memory_order::relaxed) == nullptr;
+		}
+
+
+	private:
+		struct Node
+		{
+			T     value;
+			Node* next;
+		};
+
+
+		std::atomic<Node*> mTop = nullptr;
+	};
+}
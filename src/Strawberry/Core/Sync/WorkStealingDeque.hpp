@@ -0,0 +1,190 @@
+#pragma once
+// Includes
+// Strawberry Core
+#include "Strawberry/Core/Types/Optional.hpp"
+#include "Strawberry/Core/Util/Alloc.hpp"
+// Standard Library
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+
+namespace Strawberry::Core::LockFree
+{
+	/// Lock free Chase-Lev work stealing deque.
+	///
+	/// The owning thread pushes and pops from the bottom of the deque, whilst any other thread may steal from the top.
+	/// The deque grows without bound. Buffers which have been outgrown are kept alive until the deque is destroyed,
+	/// since a concurrent thief may still be reading from them.
+	template <typename T> requires (std::is_trivially_copyable_v<T>)
+	class WorkStealingDeque
+	{
+	public:
+		/// Construct a deque with space for initialCapacity elements before growing.
+		explicit WorkStealingDeque(size_t initialCapacity = 256)
+		{
+			size_t capacity = 1;
+			while (capacity < initialCapacity) capacity <<= 1;
+			mBuffers.emplace_back(std::make_unique<Buffer>(capacity));
+			mBuffer.store(mBuffers.back().get(), std::memory_order_relaxed);
+		}
+
+
+		/// Deque is not copyable.
+		WorkStealingDeque(const WorkStealingDeque&) = delete;
+		/// Deque is not copy assignable.
+		WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+		/// Deque is not movable, since thieves hold references to it.
+		WorkStealingDeque(WorkStealingDeque&&) = delete;
+		/// Deque is not move assignable.
+		WorkStealingDeque& operator=(WorkStealingDeque&&) = delete;
+
+
+		/// Push a value onto the bottom of the deque. May only be called by the owning thread.
+		void Push(T value) noexcept
+		{
+			int64_t bottom = mBottom.load(std::memory_order_relaxed);
+			int64_t top    = mTop.load(std::memory_order_acquire);
+			Buffer* buffer = mBuffer.load(std::memory_order_relaxed);
+
+			// Grow if there is no room left.
+			if (bottom - top > static_cast<int64_t>(buffer->Capacity()) - 1) [[unlikely]]
+			{
+				buffer = Grow(buffer, top, bottom);
+			}
+
+			buffer->Store(bottom, value);
+			std::atomic_thread_fence(std::memory_order_release);
+			mBottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+
+
+		/// Pop the most recently pushed value from the bottom of the deque. May only be called by the owning thread.
+		[[nodiscard]] Optional<T> Pop() noexcept
+		{
+			int64_t bottom = mBottom.load(std::memory_order_relaxed) - 1;
+			Buffer* buffer = mBuffer.load(std::memory_order_relaxed);
+			mBottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t top = mTop.load(std::memory_order_relaxed);
+
+			// The deque was empty.
+			if (top > bottom)
+			{
+				mBottom.store(bottom + 1, std::memory_order_relaxed);
+				return NullOpt;
+			}
+
+			T value = buffer->Load(bottom);
+			if (top == bottom)
+			{
+				// This is the last element, so we race any thieves for it.
+				bool won = mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+				mBottom.store(bottom + 1, std::memory_order_relaxed);
+				if (!won) return NullOpt;
+			}
+
+			return value;
+		}
+
+
+		/// Steal the oldest value from the top of the deque. May be called from any thread.
+		[[nodiscard]] Optional<T> Steal() noexcept
+		{
+			int64_t top = mTop.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t bottom = mBottom.load(std::memory_order_acquire);
+
+			if (top >= bottom)
+			{
+				return NullOpt;
+			}
+
+			Buffer* buffer = mBuffer.load(std::memory_order_acquire);
+			T value = buffer->Load(top);
+			if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				// Lost the race to another thief or the owner.
+				return NullOpt;
+			}
+
+			return value;
+		}
+
+
+		/// Returns whether the deque appeared empty at the time of calling.
+		[[nodiscard]] bool IsEmpty() const noexcept
+		{
+			return Size() == 0;
+		}
+
+
+		/// Returns the approximate number of elements in the deque.
+		[[nodiscard]] size_t Size() const noexcept
+		{
+			int64_t bottom = mBottom.load(std::memory_order_relaxed);
+			int64_t top    = mTop.load(std::memory_order_relaxed);
+			return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+		}
+
+
+	private:
+		/// Circular array of atomic slots.
+		class Buffer
+		{
+		public:
+			explicit Buffer(size_t capacity)
+				: mMask(capacity - 1)
+				, mSlots(std::make_unique<std::atomic<T>[]>(capacity))
+			{}
+
+
+			size_t Capacity() const noexcept { return mMask + 1; }
+
+
+			void Store(int64_t index, T value) noexcept
+			{
+				mSlots[static_cast<size_t>(index) & mMask].store(value, std::memory_order_relaxed);
+			}
+
+
+			T Load(int64_t index) const noexcept
+			{
+				return mSlots[static_cast<size_t>(index) & mMask].load(std::memory_order_relaxed);
+			}
+
+
+		private:
+			size_t                            mMask;
+			std::unique_ptr<std::atomic<T>[]> mSlots;
+		};
+
+
+		/// Replaces the current buffer with one twice the size, copying the live range across.
+		Buffer* Grow(Buffer* old, int64_t top, int64_t bottom)
+		{
+			auto grown = std::make_unique<Buffer>(2 * old->Capacity());
+			for (int64_t i = top; i < bottom; i++)
+			{
+				grown->Store(i, old->Load(i));
+			}
+
+			Buffer* result = grown.get();
+			mBuffers.emplace_back(std::move(grown));
+			mBuffer.store(result, std::memory_order_release);
+			return result;
+		}
+
+
+		/// The index of the oldest element. Written by thieves and the owner.
+		alignas(CACHE_LINE_SIZE) std::atomic<int64_t> mTop = 0;
+		/// The index one past the newest element. Only written by the owner.
+		alignas(CACHE_LINE_SIZE) std::atomic<int64_t> mBottom = 0;
+		/// The buffer currently in use.
+		alignas(CACHE_LINE_SIZE) std::atomic<Buffer*> mBuffer = nullptr;
+		/// Every buffer this deque has used, kept alive for the lifetime of the deque.
+		std::vector<std::unique_ptr<Buffer>> mBuffers;
+	};
+}
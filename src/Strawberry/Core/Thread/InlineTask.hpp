@@ -0,0 +1,155 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace Strawberry::Core
+{
+	/// Move-only type erased void() callable.
+	///
+	/// Callables of up to INLINE_SIZE bytes which are nothrow move constructible are stored inside the task itself,
+	/// so constructing, moving and running the task never touches the heap. Larger callables fall back to a single
+	/// heap allocation.
+	class InlineTask
+	{
+	public:
+		static constexpr size_t INLINE_SIZE = 64;
+
+
+		template <typename F>
+		static constexpr bool FitsInline =
+			sizeof(F) <= INLINE_SIZE
+			&& alignof(std::max_align_t) % alignof(F) == 0
+			&& std::is_nothrow_move_constructible_v<F>;
+
+
+		/// Construct an empty task.
+		InlineTask() noexcept = default;
+
+
+		/// Construct a task wrapping the given callable.
+		template <typename F> requires (!std::same_as<std::decay_t<F>, InlineTask> && std::invocable<std::decay_t<F>&>)
+		InlineTask(F&& function)
+		{
+			using Function = std::decay_t<F>;
+
+			if constexpr (FitsInline<Function>)
+			{
+				std::construct_at(reinterpret_cast<Function*>(mStorage), std::forward<F>(function));
+				mOperations = &INLINE_OPERATIONS<Function>;
+			}
+			else
+			{
+				*reinterpret_cast<Function**>(mStorage) = new Function(std::forward<F>(function));
+				mOperations = &HEAP_OPERATIONS<Function>;
+			}
+		}
+
+
+		InlineTask(const InlineTask&) = delete;
+		InlineTask& operator=(const InlineTask&) = delete;
+
+
+		InlineTask(InlineTask&& other) noexcept
+		{
+			if (other.mOperations)
+			{
+				other.mOperations->move(other.mStorage, mStorage);
+				mOperations = std::exchange(other.mOperations, nullptr);
+			}
+		}
+
+
+		InlineTask& operator=(InlineTask&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Reset();
+				if (other.mOperations)
+				{
+					other.mOperations->move(other.mStorage, mStorage);
+					mOperations = std::exchange(other.mOperations, nullptr);
+				}
+			}
+
+			return *this;
+		}
+
+
+		~InlineTask()
+		{
+			Reset();
+		}
+
+
+		/// Runs the wrapped callable.
+		void operator()()
+		{
+			Assert(HasValue(), "Attempted to run an empty InlineTask!");
+			mOperations->invoke(mStorage);
+		}
+
+
+		/// Destroys the wrapped callable without running it.
+		void Reset() noexcept
+		{
+			if (mOperations)
+			{
+				std::exchange(mOperations, nullptr)->destroy(mStorage);
+			}
+		}
+
+
+		[[nodiscard]] bool HasValue() const noexcept { return mOperations != nullptr; }
+		explicit operator bool() const noexcept { return HasValue(); }
+
+
+	private:
+		/// Table of functions for manipulating the type erased callable.
+		struct Operations
+		{
+			void (*invoke)(std::byte* storage);
+			/// Move constructs into to, and destroys the original in from.
+			void (*move)(std::byte* from, std::byte* to) noexcept;
+			void (*destroy)(std::byte* storage) noexcept;
+		};
+
+
+		template <typename F>
+		static constexpr Operations INLINE_OPERATIONS
+		{
+			.invoke  = [] (std::byte* storage) { std::invoke(*std::launder(reinterpret_cast<F*>(storage))); },
+			.move    = [] (std::byte* from, std::byte* to) noexcept
+			{
+				F* source = std::launder(reinterpret_cast<F*>(from));
+				std::construct_at(reinterpret_cast<F*>(to), std::move(*source));
+				std::destroy_at(source);
+			},
+			.destroy = [] (std::byte* storage) noexcept { std::destroy_at(std::launder(reinterpret_cast<F*>(storage))); },
+		};
+
+
+		template <typename F>
+		static constexpr Operations HEAP_OPERATIONS
+		{
+			.invoke  = [] (std::byte* storage) { std::invoke(**reinterpret_cast<F**>(storage)); },
+			.move    = [] (std::byte* from, std::byte* to) noexcept
+			{
+				*reinterpret_cast<F**>(to) = std::exchange(*reinterpret_cast<F**>(from), nullptr);
+			},
+			.destroy = [] (std::byte* storage) noexcept { delete *reinterpret_cast<F**>(storage); },
+		};
+
+
+		alignas(std::max_align_t) std::byte mStorage[INLINE_SIZE];
+		const Operations* mOperations = nullptr;
+	};
+}
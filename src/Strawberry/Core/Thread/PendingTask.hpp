@@ -0,0 +1,266 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+#include "Strawberry/Core/Types/Optional.hpp"
+#include "Strawberry/Core/Util/Recycler.hpp"
+// Standard Library
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <future>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+
+namespace Strawberry::Core
+{
+	template <typename T>
+	class PendingTask;
+
+
+	/// Shared state between a queued task and its PendingTask.
+	///
+	/// States are allocated through a Recycler, so in steady state queueing a task does not allocate.
+	template <typename T>
+	class PendingTaskState
+	{
+	public:
+		enum class Status : uint32_t
+		{
+			Pending,
+			Value,
+			Exception,
+			/// The task was destroyed without being run.
+			Abandoned,
+		};
+
+
+		static PendingTaskState* Create()
+		{
+			return Recycler<PendingTaskState>::New();
+		}
+
+
+		template <typename... Args>
+		void SetValue(Args&&... args)
+		{
+			if constexpr (!std::is_void_v<T>)
+			{
+				mValue.Emplace(std::forward<Args>(args)...);
+			}
+			Publish(Status::Value);
+		}
+
+
+		void SetException(std::exception_ptr exception)
+		{
+			mException = std::move(exception);
+			Publish(Status::Exception);
+		}
+
+
+		void Abandon()
+		{
+			Publish(Status::Abandoned);
+		}
+
+
+		/// Drops one of the two references to this state, recycling it if it was the last.
+		void Release() noexcept
+		{
+			if (mReferences.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				Recycler<PendingTaskState>::Delete(this);
+			}
+		}
+
+
+	private:
+		friend class PendingTask<T>;
+
+
+		void Publish(Status status)
+		{
+			mStatus.store(status, std::memory_order_release);
+			mStatus.notify_all();
+		}
+
+
+		using Storage = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+
+		std::atomic<Status>  mStatus     = Status::Pending;
+		std::atomic<uint8_t> mReferences = 2;
+		Optional<Storage>    mValue;
+		std::exception_ptr   mException;
+	};
+
+
+	/// Handle to the result of a queued task.
+	///
+	/// A lighter replacement for std::future. The shared state is recycled rather than heap allocated,
+	/// and waiting is done with an atomic wait rather than a mutex and condition variable.
+	template <typename T>
+	class [[nodiscard]] PendingTask
+	{
+	public:
+		PendingTask() = default;
+
+
+		explicit PendingTask(PendingTaskState<T>* state)
+			: mState(state)
+		{}
+
+
+		PendingTask(const PendingTask&) = delete;
+		PendingTask& operator=(const PendingTask&) = delete;
+
+
+		PendingTask(PendingTask&& other) noexcept
+			: mState(std::exchange(other.mState, nullptr))
+		{}
+
+
+		PendingTask& operator=(PendingTask&& other) noexcept
+		{
+			if (this != &other)
+			{
+				if (mState) mState->Release();
+				mState = std::exchange(other.mState, nullptr);
+			}
+			return *this;
+		}
+
+
+		~PendingTask()
+		{
+			if (mState) mState->Release();
+		}
+
+
+		/// Returns whether this handle refers to a task.
+		[[nodiscard]] bool IsValid() const noexcept { return mState != nullptr; }
+
+
+		/// Returns whether the task has finished, either by running or by being abandoned.
+		[[nodiscard]] bool IsReady() const noexcept
+		{
+			Assert(IsValid());
+			return mState->mStatus.load(std::memory_order_acquire) != PendingTaskState<T>::Status::Pending;
+		}
+
+
+		/// Blocks until the task has finished.
+		void Wait() const noexcept
+		{
+			Assert(IsValid());
+			mState->mStatus.wait(PendingTaskState<T>::Status::Pending, std::memory_order_acquire);
+		}
+
+
+		/// Waits for the task, and returns its result.
+		///
+		/// Rethrows any exception thrown by the task, and throws std::future_error if the task was
+		/// abandoned before it could run, matching std::future.
+		T Get()
+		{
+			Wait();
+
+			switch (mState->mStatus.load(std::memory_order_acquire))
+			{
+				case PendingTaskState<T>::Status::Value:
+					if constexpr (std::is_void_v<T>)
+					{
+						return;
+					}
+					else
+					{
+						return mState->mValue.Unwrap();
+					}
+				case PendingTaskState<T>::Status::Exception:
+					std::rethrow_exception(mState->mException);
+				case PendingTaskState<T>::Status::Abandoned:
+					throw std::future_error(std::future_errc::broken_promise);
+				default:
+					Unreachable();
+			}
+		}
+
+
+	private:
+		PendingTaskState<T>* mState = nullptr;
+	};
+
+
+	template <typename T>
+	using PendingTaskList = std::vector<PendingTask<T>>;
+
+
+	/// Callable which runs a function and publishes its result to a PendingTaskState.
+	///
+	/// If it is destroyed without having been run, the state is marked as abandoned.
+	template <typename F, typename T = std::invoke_result_t<F&>>
+	class CompletingTask
+	{
+	public:
+		CompletingTask(PendingTaskState<T>* state, F function)
+			: mState(state)
+			, mFunction(std::move(function))
+		{}
+
+
+		CompletingTask(const CompletingTask&) = delete;
+		CompletingTask& operator=(const CompletingTask&) = delete;
+
+
+		CompletingTask(CompletingTask&& other) noexcept(std::is_nothrow_move_constructible_v<F>)
+			: mState(std::exchange(other.mState, nullptr))
+			, mFunction(std::move(other.mFunction))
+		{}
+
+
+		CompletingTask& operator=(CompletingTask&&) = delete;
+
+
+		~CompletingTask()
+		{
+			if (mState)
+			{
+				mState->Abandon();
+				mState->Release();
+			}
+		}
+
+
+		void operator()()
+		{
+			Assert(mState != nullptr, "CompletingTask run more than once!");
+
+			try
+			{
+				if constexpr (std::is_void_v<T>)
+				{
+					std::invoke(mFunction);
+					mState->SetValue();
+				}
+				else
+				{
+					mState->SetValue(std::invoke(mFunction));
+				}
+			}
+			catch (...)
+			{
+				mState->SetException(std::current_exception());
+			}
+
+			std::exchange(mState, nullptr)->Release();
+		}
+
+
+	private:
+		PendingTaskState<T>* mState;
+		F                    mFunction;
+	};
+}
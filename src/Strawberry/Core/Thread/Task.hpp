@@ -0,0 +1,319 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+#include "Strawberry/Core/Thread/ThreadPool.hpp"
+#include "Strawberry/Core/Thread/Worker.hpp"
+#include "Strawberry/Core/Types/Optional.hpp"
+// Standard Library
+#include <coroutine>
+#include <exception>
+#include <semaphore>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+
+namespace Strawberry::Core
+{
+	template <typename T = void>
+	class Task;
+
+
+	/// Result storage shared by the promise types of every Task.
+	class TaskPromiseBase
+	{
+	public:
+		/// Tasks are lazy, and only start when they are awaited.
+		std::suspend_always initial_suspend() noexcept { return {}; }
+
+
+		/// Resumes whichever coroutine awaited this task, on the thread which finished it.
+		struct FinalAwaiter
+		{
+			bool await_ready() noexcept { return false; }
+
+			template <typename Promise>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+			{
+				auto continuation = handle.promise().mContinuation;
+				return continuation ? continuation : std::noop_coroutine();
+			}
+
+			void await_resume() noexcept {}
+		};
+
+
+		FinalAwaiter final_suspend() noexcept { return {}; }
+
+
+		void unhandled_exception() noexcept
+		{
+			mException = std::current_exception();
+		}
+
+
+		void SetContinuation(std::coroutine_handle<> continuation) noexcept
+		{
+			mContinuation = continuation;
+		}
+
+
+	protected:
+		void RethrowIfFailed()
+		{
+			if (mException)
+			{
+				std::rethrow_exception(mException);
+			}
+		}
+
+
+	private:
+		std::coroutine_handle<> mContinuation;
+		std::exception_ptr      mException;
+	};
+
+
+	template <typename T>
+	class TaskPromise : public TaskPromiseBase
+	{
+	public:
+		Task<T> get_return_object() noexcept;
+
+
+		template <typename U> requires (std::constructible_from<T, U&&>)
+		void return_value(U&& value)
+		{
+			mValue.Emplace(std::forward<U>(value));
+		}
+
+
+		T Result()
+		{
+			RethrowIfFailed();
+			return mValue.Unwrap();
+		}
+
+
+	private:
+		Optional<T> mValue;
+	};
+
+
+	template <>
+	class TaskPromise<void> : public TaskPromiseBase
+	{
+	public:
+		Task<void> get_return_object() noexcept;
+
+
+		void return_void() noexcept {}
+
+
+		void Result()
+		{
+			RethrowIfFailed();
+		}
+	};
+
+
+	/// A lazily started coroutine which produces a T.
+	///
+	/// A Task starts running when it is awaited, and when it finishes, the awaiting coroutine is resumed
+	/// directly on the thread which finished it. Tasks can await other Tasks, a ThreadPool or Worker to
+	/// continue on one of its threads, a Timer, or an AsyncQueue. Use SyncWait to run a Task from ordinary code,
+	/// or Spawn to run one without waiting on it.
+	template <typename T>
+	class [[nodiscard]] Task
+	{
+	public:
+		using promise_type = TaskPromise<T>;
+		using Handle       = std::coroutine_handle<promise_type>;
+
+
+		Task() = default;
+
+
+		explicit Task(Handle handle) noexcept
+			: mHandle(handle)
+		{}
+
+
+		Task(const Task&) = delete;
+		Task& operator=(const Task&) = delete;
+
+
+		Task(Task&& other) noexcept
+			: mHandle(std::exchange(other.mHandle, nullptr))
+		{}
+
+
+		Task& operator=(Task&& other) noexcept
+		{
+			if (this != &other)
+			{
+				if (mHandle) mHandle.destroy();
+				mHandle = std::exchange(other.mHandle, nullptr);
+			}
+			return *this;
+		}
+
+
+		~Task()
+		{
+			if (mHandle) mHandle.destroy();
+		}
+
+
+		[[nodiscard]] bool IsValid() const noexcept { return static_cast<bool>(mHandle); }
+		[[nodiscard]] bool IsDone() const noexcept { return mHandle && mHandle.done(); }
+
+
+		auto operator co_await() && noexcept
+		{
+			struct Awaiter
+			{
+				Handle handle;
+
+				bool await_ready() const noexcept { return handle.done(); }
+
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+				{
+					handle.promise().SetContinuation(awaiting);
+					return handle;
+				}
+
+				T await_resume() { return handle.promise().Result(); }
+			};
+
+			Assert(IsValid(), "Awaited an empty Task!");
+			return Awaiter{mHandle};
+		}
+
+
+	private:
+		Handle mHandle = nullptr;
+	};
+
+
+	template <typename T>
+	Task<T> TaskPromise<T>::get_return_object() noexcept
+	{
+		return Task<T>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+	}
+
+
+	inline Task<void> TaskPromise<void>::get_return_object() noexcept
+	{
+		return Task<void>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+	}
+
+
+	/// Coroutine which starts immediately and destroys itself when it finishes. Used to drive Tasks from ordinary code.
+	class DetachedTask
+	{
+	public:
+		struct promise_type
+		{
+			DetachedTask get_return_object() noexcept { return {}; }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() noexcept {}
+			void unhandled_exception() noexcept { std::terminate(); }
+		};
+	};
+
+
+	/// Runs task on the calling thread until it first suspends, and then blocks until it has finished.
+	template <typename T>
+	T SyncWait(Task<T> task)
+	{
+		ZoneScoped;
+
+		using Storage = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+		struct State
+		{
+			/// Released by the coroutine as its last use of this state, which lives on the waiting thread's stack.
+			std::binary_semaphore done{0};
+			Optional<Storage>     value;
+			std::exception_ptr    exception;
+		} state;
+
+		[] (Task<T> task, State* state) -> DetachedTask
+		{
+			try
+			{
+				if constexpr (std::is_void_v<T>)
+				{
+					co_await std::move(task);
+				}
+				else
+				{
+					state->value.Emplace(co_await std::move(task));
+				}
+			}
+			catch (...)
+			{
+				state->exception = std::current_exception();
+			}
+
+			state->done.release();
+		}(std::move(task), &state);
+
+		state.done.acquire();
+
+		if (state.exception)
+		{
+			std::rethrow_exception(state.exception);
+		}
+
+		if constexpr (!std::is_void_v<T>)
+		{
+			return state.value.Unwrap();
+		}
+	}
+
+
+	/// Awaiting a ThreadPool suspends the coroutine, and resumes it on one of the pool's threads.
+	inline auto operator co_await(ThreadPool& pool) noexcept
+	{
+		struct Awaiter
+		{
+			ThreadPool& pool;
+
+			bool await_ready() const noexcept { return pool.ThreadCount() == 0; }
+			void await_suspend(std::coroutine_handle<> handle) { pool.Post([handle] { handle.resume(); }); }
+			void await_resume() const noexcept {}
+		};
+
+		return Awaiter{pool};
+	}
+
+
+	/// Awaiting a Worker suspends the coroutine, and resumes it on the Worker's thread.
+	inline auto operator co_await(Worker& worker) noexcept
+	{
+		struct Awaiter
+		{
+			Worker& worker;
+
+			bool await_ready() const noexcept { return false; }
+			void await_suspend(std::coroutine_handle<> handle) { worker.Post([handle] { handle.resume(); }); }
+			void await_resume() const noexcept {}
+		};
+
+		return Awaiter{worker};
+	}
+
+
+	/// Starts task on the given pool without waiting for it. Exceptions thrown by the task terminate the program.
+	inline void Spawn(ThreadPool& pool, Task<void> task)
+	{
+		[] (ThreadPool& pool, Task<void> task) -> DetachedTask
+		{
+			co_await pool;
+			co_await std::move(task);
+		}(pool, std::move(task));
+	}
+}
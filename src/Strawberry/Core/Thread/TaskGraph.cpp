@@ -0,0 +1,217 @@
+#include "TaskGraph.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+#include "Strawberry/Core/Types/Optional.hpp"
+// Standard Library
+#include <algorithm>
+
+
+namespace Strawberry::Core
+{
+	TaskGraph::NodeID TaskGraph::AddNode(std::string name, std::function<void()> work)
+	{
+		Assert(!mRunning, "Attempted to modify a TaskGraph while it is running!");
+
+		mNodes.emplace_back(Node{.name = std::move(name), .work = std::move(work)});
+		mSorted = false;
+		return static_cast<NodeID>(mNodes.size() - 1);
+	}
+
+
+	void TaskGraph::AddEdge(NodeID before, NodeID after)
+	{
+		Assert(!mRunning, "Attempted to modify a TaskGraph while it is running!");
+		Assert(before < mNodes.size() && after < mNodes.size());
+		AssertNEQ(before, after);
+
+		mNodes[before].successors.emplace_back(after);
+		mNodes[after].predecessorCount++;
+		mSorted = false;
+	}
+
+
+	const std::string& TaskGraph::GetName(NodeID node) const
+	{
+		Assert(node < mNodes.size());
+		return mNodes[node].name;
+	}
+
+
+	const TaskGraph::NodeTiming& TaskGraph::GetTiming(NodeID node) const
+	{
+		Assert(node < mNodes.size());
+		return mNodes[node].timing;
+	}
+
+
+	std::vector<TaskGraph::NodeID> TaskGraph::CriticalPath() const
+	{
+		ZoneScoped;
+
+		if (mNodes.empty()) return {};
+
+		// Longest path through the DAG, weighted by how long each node took, found in topological order.
+		std::vector<Duration>         finish(mNodes.size(), Duration::zero());
+		std::vector<Optional<NodeID>> previous(mNodes.size());
+		for (NodeID node : mTopologicalOrder)
+		{
+			finish[node] += mNodes[node].timing.Elapsed();
+			for (NodeID successor : mNodes[node].successors)
+			{
+				if (!previous[successor] || finish[node] > finish[successor])
+				{
+					finish[successor]   = finish[node];
+					previous[successor] = node;
+				}
+			}
+		}
+
+		NodeID last = static_cast<NodeID>(std::ranges::max_element(finish) - finish.begin());
+		std::vector<NodeID> path{last};
+		while (previous[path.back()])
+		{
+			path.emplace_back(previous[path.back()].Value());
+		}
+		std::ranges::reverse(path);
+		return path;
+	}
+
+
+	void TaskGraph::Run(ThreadPool& pool)
+	{
+		ZoneScoped;
+
+		Assert(!mRunning.exchange(true), "TaskGraph run while it is already running!");
+
+		Sort();
+		for (NodeID node = 0; node < mNodes.size(); node++)
+		{
+			mRemainingPredecessors[node].store(mNodes[node].predecessorCount, std::memory_order_relaxed);
+		}
+		mRemainingNodes.store(mNodes.size(), std::memory_order_relaxed);
+		mFailed    = false;
+		mException = nullptr;
+		mRunStart  = Clock::now();
+
+		std::latch done(mNodes.empty() ? 0 : 1);
+		mDone = &done;
+		for (NodeID node = 0; node < mNodes.size(); node++)
+		{
+			if (mNodes[node].predecessorCount == 0)
+			{
+				Dispatch(pool, node);
+			}
+		}
+
+		done.wait();
+		mDone = nullptr;
+
+		mElapsed = Clock::now() - mRunStart;
+		mRunning = false;
+
+		if (mException)
+		{
+			std::rethrow_exception(std::exchange(mException, nullptr));
+		}
+	}
+
+
+	void TaskGraph::Sort()
+	{
+		if (mSorted) return;
+
+		ZoneScoped;
+
+		// Kahn's algorithm.
+		std::vector<unsigned int> remaining(mNodes.size());
+		mTopologicalOrder.clear();
+		mTopologicalOrder.reserve(mNodes.size());
+		for (NodeID node = 0; node < mNodes.size(); node++)
+		{
+			remaining[node] = mNodes[node].predecessorCount;
+			if (remaining[node] == 0)
+			{
+				mTopologicalOrder.emplace_back(node);
+			}
+		}
+
+		for (size_t i = 0; i < mTopologicalOrder.size(); i++)
+		{
+			for (NodeID successor : mNodes[mTopologicalOrder[i]].successors)
+			{
+				if (--remaining[successor] == 0)
+				{
+					mTopologicalOrder.emplace_back(successor);
+				}
+			}
+		}
+
+		Assert(mTopologicalOrder.size() == mNodes.size(), "TaskGraph contains a cycle!");
+
+		mRemainingPredecessors = std::make_unique<std::atomic<unsigned int>[]>(mNodes.size());
+		mSorted = true;
+	}
+
+
+	void TaskGraph::RunNode(ThreadPool& pool, NodeID node)
+	{
+		ZoneScoped;
+
+		while (true)
+		{
+			Node& current = mNodes[node];
+
+			current.timing.start = Clock::now() - mRunStart;
+			if (!mFailed.load(std::memory_order_relaxed))
+			{
+				try
+				{
+					std::invoke(current.work);
+				}
+				catch (...)
+				{
+					std::unique_lock lock(mExceptionMutex);
+					if (!mException) mException = std::current_exception();
+					mFailed = true;
+				}
+			}
+			current.timing.end = Clock::now() - mRunStart;
+
+
+			// Continue with one ready successor on this thread, and hand any others to the pool.
+			Optional<NodeID> next;
+			for (NodeID successor : current.successors)
+			{
+				if (mRemainingPredecessors[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					if (next) Dispatch(pool, next.Value());
+					next = successor;
+				}
+			}
+
+
+			// The last node cannot have made any successor ready. Once it counts down the latch, Run may return, so
+			// nothing of this graph is touched afterwards.
+			if (mRemainingNodes.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				mDone->count_down();
+				return;
+			}
+
+			if (!next) return;
+			node = next.Value();
+		}
+	}
+
+
+	void TaskGraph::Dispatch(ThreadPool& pool, NodeID node)
+	{
+		if (pool.ThreadCount() == 0)
+		{
+			RunNode(pool, node);
+			return;
+		}
+
+		pool.Post([this, &pool, node] { RunNode(pool, node); });
+	}
+}
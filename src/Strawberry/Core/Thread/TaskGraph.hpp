@@ -0,0 +1,109 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Thread/ThreadPool.hpp"
+// Standard Library
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+namespace Strawberry::Core
+{
+	/// A directed acyclic graph of tasks, which can be run on a ThreadPool any number of times.
+	///
+	/// Nodes and edges are declared once. Each call to Run schedules every node whose predecessors have all
+	/// finished, as soon as the last of them finishes, so no pool thread ever blocks waiting on another node.
+	/// The start and end time of every node is recorded, so that the critical path of the last run can be found.
+	class TaskGraph
+	{
+	public:
+		using NodeID   = unsigned int;
+		using Clock    = std::chrono::steady_clock;
+		using Duration = Clock::duration;
+
+
+		/// When a node ran, relative to the start of the run.
+		struct NodeTiming
+		{
+			Duration start{};
+			Duration end{};
+
+			[[nodiscard]] Duration Elapsed() const noexcept { return end - start; }
+		};
+
+
+		TaskGraph() = default;
+		TaskGraph(const TaskGraph&) = delete;
+		TaskGraph(TaskGraph&&) = delete;
+		TaskGraph& operator=(const TaskGraph&) = delete;
+		TaskGraph& operator=(TaskGraph&&) = delete;
+
+
+		/// Adds a node which runs work, and returns its ID.
+		NodeID AddNode(std::string name, std::function<void()> work);
+		/// Declares that node after may only start once node before has finished.
+		void AddEdge(NodeID before, NodeID after);
+
+
+		[[nodiscard]] size_t NodeCount() const noexcept { return mNodes.size(); }
+		[[nodiscard]] const std::string& GetName(NodeID node) const;
+		/// Returns when the given node ran during the last run.
+		[[nodiscard]] const NodeTiming& GetTiming(NodeID node) const;
+		/// Returns the time taken by the last run.
+		[[nodiscard]] Duration GetElapsed() const noexcept { return mElapsed; }
+
+
+		/// Returns the chain of dependent nodes with the greatest total running time during the last run, in order.
+		[[nodiscard]] std::vector<NodeID> CriticalPath() const;
+
+
+		/// Runs every node on the given pool, and returns once all of them have finished.
+		///
+		/// If any node throws, nodes which have not yet started are skipped and the first exception is rethrown.
+		void Run(ThreadPool& pool);
+
+
+	private:
+		struct Node
+		{
+			std::string           name;
+			std::function<void()> work;
+			std::vector<NodeID>   successors;
+			unsigned int          predecessorCount = 0;
+			NodeTiming            timing;
+		};
+
+
+		/// Computes a topological order of the nodes, asserting that the graph has no cycles.
+		void Sort();
+		/// Runs node, and then any successors which it made ready.
+		void RunNode(ThreadPool& pool, NodeID node);
+		/// Runs node on the pool, or on the calling thread if the pool has no threads.
+		void Dispatch(ThreadPool& pool, NodeID node);
+
+
+		std::vector<Node>   mNodes;
+		std::vector<NodeID> mTopologicalOrder;
+		bool                mSorted = true;
+
+
+		/// State of the current run.
+		std::unique_ptr<std::atomic<unsigned int>[]> mRemainingPredecessors;
+		std::atomic<size_t>                          mRemainingNodes = 0;
+		/// Counted down by the last node to finish. It belongs to Run, which may return and let this graph be
+		/// destroyed as soon as it is.
+		std::latch*                                  mDone           = nullptr;
+		std::atomic_bool                             mRunning        = false;
+		std::atomic_bool                             mFailed         = false;
+		std::mutex                                   mExceptionMutex;
+		std::exception_ptr                           mException;
+		Clock::time_point                            mRunStart;
+		Duration                                     mElapsed{};
+	};
+}
@@ -3,15 +3,34 @@
 
 namespace Strawberry::Core
 {
-	ThreadPool::ThreadPool(const int threadCount)
+	/// The work stealing pool which owns the current thread, if any.
+	static thread_local ThreadPool* sCurrentPool = nullptr;
+	/// The index of the current thread within sCurrentPool.
+	static thread_local unsigned int sCurrentIndex = 0;
+
+
+	ThreadPool::ThreadPool(const int threadCount, Scheduling scheduling)
 		: mThreadCount(std::clamp<int>(threadCount >= 0 ? threadCount : std::thread::hardware_concurrency() + threadCount, 0, std::thread::hardware_concurrency()))
-		, mWorkers(std::make_unique<Worker[]>(mThreadCount))
-	{}
+		, mScheduling(scheduling)
+	{
+		if (mScheduling == Scheduling::RoundRobin)
+		{
+			mWorkers = std::make_unique<Worker[]>(mThreadCount);
+		}
+		else
+		{
+			mDeques = std::make_unique<LockFree::WorkStealingDeque<PackagedTask*>[]>(mThreadCount);
+			mThreads.reserve(mThreadCount);
+			for (unsigned int i = 0; i < mThreadCount; i++)
+			{
+				mThreads.emplace_back([this, i] { RunStealingThread(i); });
+			}
+		}
+	}
 
 
-	ThreadPool::ThreadPool(float percentageOfThreads)
-		: mThreadCount(percentageOfThreads * std::thread::hardware_concurrency())
-		, mWorkers(std::make_unique<Worker[]>(mThreadCount))
+	ThreadPool::ThreadPool(float percentageOfThreads, Scheduling scheduling)
+		: ThreadPool(static_cast<int>(percentageOfThreads * std::thread::hardware_concurrency()), scheduling)
 	{}
 
 
@@ -27,9 +46,158 @@ namespace Strawberry::Core
 	{
 		ZoneScoped;
 
+		if (mScheduling == Scheduling::RoundRobin)
+		{
+			for (int i = 0; i < mThreadCount; i++)
+			{
+				mWorkers[i].Join();
+			}
+			return;
+		}
+
+
+		mRunningFlag = false;
+		mWorkEpoch.fetch_add(1);
+		mWorkEpoch.notify_all();
+
+		for (auto& thread : mThreads)
+		{
+			if (thread.joinable()) thread.join();
+		}
+
+		// Like Worker, any jobs which were never started are abandoned.
 		for (int i = 0; i < mThreadCount; i++)
 		{
-			mWorkers[i].Join();
+			while (auto job = mDeques[i].Pop())
+			{
+				Recycler<PackagedTask>::Delete(job.Unwrap());
+			}
+		}
+
+		std::unique_lock lock(mInjectionMutex);
+		for (auto job : mInjectionQueue)
+		{
+			Recycler<PackagedTask>::Delete(job);
+		}
+		mInjectionQueue.clear();
+	}
+
+
+	void ThreadPool::Schedule(std::span<PackagedTask* const> jobs)
+	{
+		ZoneScoped;
+
+		if (jobs.empty()) return;
+
+		// With no threads to run them, tasks are run as they are queued, so that waiting on one cannot hang.
+		if (mThreadCount == 0)
+		{
+			for (auto job : jobs)
+			{
+				Worker::Invoke(*job);
+				Recycler<PackagedTask>::Delete(job);
+			}
+			return;
+		}
+
+		if (sCurrentPool == this)
+		{
+			// Tasks queued from within a task stay local, where their data is most likely to be cached.
+			for (auto job : jobs)
+			{
+				mDeques[sCurrentIndex].Push(job);
+			}
+		}
+		else
+		{
+			std::unique_lock lock(mInjectionMutex);
+			mInjectionQueue.insert(mInjectionQueue.end(), jobs.begin(), jobs.end());
+		}
+
+		NotifyWork(jobs.size());
+	}
+
+
+	void ThreadPool::RunStealingThread(unsigned int index)
+	{
+		ZoneScoped;
+
+		sCurrentPool  = this;
+		sCurrentIndex = index;
+
+		while (mRunningFlag)
+		{
+			if (PackagedTask* job = FindJob(index))
+			{
+				Worker::Invoke(*job);
+				Recycler<PackagedTask>::Delete(job);
+				continue;
+			}
+
+			// Read the epoch before checking for work a final time, so that a job published
+			// after the check will have changed the epoch and prevent us from sleeping.
+			auto epoch = mWorkEpoch.load();
+			if (!mRunningFlag) break;
+			if (PackagedTask* job = FindJob(index))
+			{
+				Worker::Invoke(*job);
+				Recycler<PackagedTask>::Delete(job);
+				continue;
+			}
+
+			mSleepingCount.fetch_add(1);
+			mWorkEpoch.wait(epoch);
+			mSleepingCount.fetch_sub(1);
+		}
+
+		sCurrentPool = nullptr;
+	}
+
+
+	ThreadPool::PackagedTask* ThreadPool::FindJob(unsigned int index)
+	{
+		if (auto job = mDeques[index].Pop())
+		{
+			return job.Unwrap();
+		}
+
+
+		{
+			std::unique_lock lock(mInjectionMutex);
+			if (!mInjectionQueue.empty())
+			{
+				PackagedTask* job = mInjectionQueue.front();
+				mInjectionQueue.pop_front();
+				return job;
+			}
+		}
+
+
+		for (unsigned int offset = 1; offset < mThreadCount; offset++)
+		{
+			if (auto job = mDeques[(index + offset) % mThreadCount].Steal())
+			{
+				return job.Unwrap();
+			}
+		}
+
+		return nullptr;
+	}
+
+
+	void ThreadPool::NotifyWork(size_t jobCount)
+	{
+		mWorkEpoch.fetch_add(1);
+		if (mSleepingCount.load() > 0)
+		{
+			if (jobCount == 1)
+			{
+				mWorkEpoch.notify_one();
+			}
+			else
+			{
+				mWorkEpoch.notify_all();
+			}
 		}
 	}
 }
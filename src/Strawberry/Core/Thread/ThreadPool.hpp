@@ -1,11 +1,16 @@
 #pragma once
 #include "Strawberry/Core/Math/Vector.hpp"
 #include "Strawberry/Core/Thread/Worker.hpp"
+#include "Strawberry/Core/Sync/WorkStealingDeque.hpp"
+#include "Strawberry/Core/Util/Recycler.hpp"
+#include <exception>
 #include <functional>
 #include <thread>
 #include <vector>
 #include <latch>
-#include <future>
+#include <deque>
+#include <span>
+#include <memory>
 
 #include "Strawberry/Core/Math/Math.hpp"
 #include "Strawberry/Core/Sync/Mutex.hpp"
@@ -15,8 +20,21 @@ namespace Strawberry::Core
 	class ThreadPool
 	{
 	public:
-		ThreadPool(int threadCount = std::thread::hardware_concurrency());
-		ThreadPool(float percentageOfThreads);
+		/// How tasks are distributed between the threads of the pool.
+		enum class Scheduling
+		{
+			/// Each task is handed to the next Worker in turn, and stays in that Worker's queue until it is run.
+			RoundRobin,
+			/// Each thread owns a lock free deque. Idle threads steal from busy ones, and tasks queued from
+			/// within a task are pushed to the local deque of the calling thread.
+			WorkStealing,
+		};
+
+
+		/// Creates a pool of threadCount threads, or if it is negative, of that many fewer than the hardware has. A pool
+		/// with no threads runs each task on the calling thread as it is queued.
+		ThreadPool(int threadCount = std::thread::hardware_concurrency(), Scheduling scheduling = Scheduling::RoundRobin);
+		ThreadPool(float percentageOfThreads, Scheduling scheduling = Scheduling::RoundRobin);
 
 
 		ThreadPool(const ThreadPool&) = delete;
@@ -31,6 +49,10 @@ namespace Strawberry::Core
 		void Join();
 
 
+		[[nodiscard]] size_t ThreadCount() const noexcept { return mThreadCount; }
+		[[nodiscard]] Scheduling GetScheduling() const noexcept { return mScheduling; }
+
+
 		using Job = std::function<void()>;
 
 
@@ -39,7 +61,33 @@ namespace Strawberry::Core
 		{
 			ZoneScoped;
 
-			return mWorkers[GetNextThreadIndex()].Queue(std::forward<F>(task));
+			if (mScheduling == Scheduling::RoundRobin && mThreadCount > 0)
+			{
+				return mWorkers[GetNextThreadIndex()].Queue(std::forward<F>(task));
+			}
+
+			auto [future, packagedTask] = Worker::PackageTask(std::forward<F>(task));
+			PackagedTask* job = Recycler<PackagedTask>::New(std::move(packagedTask));
+			Schedule(std::span(&job, 1));
+			return std::move(future);
+		}
+
+
+		/// Queues a task whose result is not needed, without creating a PendingTask. Exceptions thrown by the task are
+		/// dropped.
+		template <typename F> requires (std::invocable<std::decay_t<F>&>)
+		void Post(F&& task)
+		{
+			ZoneScoped;
+
+			if (mScheduling == Scheduling::RoundRobin && mThreadCount > 0)
+			{
+				mWorkers[GetNextThreadIndex()].Post(std::forward<F>(task));
+				return;
+			}
+
+			PackagedTask* job = Recycler<PackagedTask>::New(std::forward<F>(task));
+			Schedule(std::span(&job, 1));
 		}
 
 
@@ -48,15 +96,34 @@ namespace Strawberry::Core
 		{
 			ZoneScoped;
 
-			unsigned long tasksEach = Math::CeilDiv(tasks.size(), mThreadCount);
-
-			std::vector<std::future<Result>> futures;
+			PendingTaskList<Result> futures;
 			if constexpr (std::ranges::sized_range<Range>)
 			{
 				futures.reserve(tasks.size());
 			}
 
 
+			if (mScheduling == Scheduling::WorkStealing || mThreadCount == 0)
+			{
+				std::vector<PackagedTask*> jobs;
+				if constexpr (std::ranges::sized_range<Range>)
+				{
+					jobs.reserve(tasks.size());
+				}
+
+				for (auto&& task : tasks)
+				{
+					auto [future, packagedTask] = Worker::PackageTask(std::forward<decltype(task)>(task));
+					jobs.emplace_back(Recycler<PackagedTask>::New(std::move(packagedTask)));
+					futures.emplace_back(std::move(future));
+				}
+
+				Schedule(jobs);
+				return futures;
+			}
+
+
+			unsigned long tasksEach = Math::CeilDiv(tasks.size(), mThreadCount);
 			for (auto iter = tasks.begin(); iter != tasks.end(); std::advance(iter, tasksEach))
 			{
 				auto threadIndex = GetNextThreadIndex();
@@ -79,13 +146,13 @@ namespace Strawberry::Core
 
 
 		template <std::unsigned_integral T, size_t D, typename F, typename R = std::invoke_result_t<F, Math::Vector<T, D>>>
-		[[nodiscard]] QueueResult<std::vector<std::pair<Math::Vector<T, D>, std::future<R>>>> QueueTasks(Math::Vector<T, D> input, F&& function)
+		[[nodiscard]] QueueResult<std::vector<std::pair<Math::Vector<T, D>, PendingTask<R>>>> QueueTasks(Math::Vector<T, D> input, F&& function)
 		{
 			ZoneScoped;
 
 			const size_t inputCount = input.Fold(std::multiplies());
 
-			std::vector<std::pair<Math::Vector<T, D>, std::future<R>>> futures;
+			std::vector<std::pair<Math::Vector<T, D>, PendingTask<R>>> futures;
 			futures.reserve(inputCount);
 
 			std::vector<Math::Vector<T, D>> inputs = input.Rectangle();
@@ -111,15 +178,232 @@ namespace Strawberry::Core
 			return futures;
 		}
 
+
+		/// Invokes function on every element of range, and returns once all of them have been processed.
+		///
+		/// The range is split into chunks of grainSize elements, which are claimed in turn by the calling thread
+		/// and by helpers posted to the pool, so no task or PendingTask is created per element. A grainSize of 0
+		/// picks a grain which gives every thread several chunks, so uneven work still balances.
+		template <std::ranges::random_access_range Range, typename F>
+			requires (std::ranges::sized_range<Range> && std::invocable<F&, std::ranges::range_reference_t<Range>>)
+		void ParallelFor(Range&& range, F&& function, size_t grainSize = 0)
+		{
+			ZoneScoped;
+
+			auto begin = std::ranges::begin(range);
+			ParallelChunks(std::ranges::size(range), grainSize, [&] (size_t first, size_t last)
+			{
+				for (size_t i = first; i < last; i++)
+				{
+					std::invoke(function, begin[i]);
+				}
+			});
+		}
+
+
+		/// Invokes function on every position within the given 2D extent. Positions are visited with x varying fastest.
+		template <std::unsigned_integral T, typename F> requires (std::invocable<F&, const Math::Vector<T, 2>&>)
+		void ParallelFor2D(Math::Vector<T, 2> extent, F&& function, size_t grainSize = 0)
+		{
+			ParallelForExtent(extent, function, grainSize);
+		}
+
+
+		/// Invokes function on every position within the given 3D extent. Positions are visited with x varying fastest.
+		template <std::unsigned_integral T, typename F> requires (std::invocable<F&, const Math::Vector<T, 3>&>)
+		void ParallelFor3D(Math::Vector<T, 3> extent, F&& function, size_t grainSize = 0)
+		{
+			ParallelForExtent(extent, function, grainSize);
+		}
+
+
+		/// Combines every element of range with operation, starting from init.
+		///
+		/// Chunks are reduced in parallel and their results are then combined in order,
+		/// so operation must be associative, but need not be commutative.
+		template <std::ranges::random_access_range Range, typename T, typename Op>
+			requires (std::ranges::sized_range<Range> && std::convertible_to<std::ranges::range_reference_t<Range>, T> && std::invocable<Op&, T, T>)
+		T ParallelReduce(Range&& range, T init, Op&& operation, size_t grainSize = 0)
+		{
+			ZoneScoped;
+
+			const size_t count = std::ranges::size(range);
+			if (count == 0)
+			{
+				return init;
+			}
+
+			auto begin = std::ranges::begin(range);
+			const size_t grain = ChooseGrainSize(count, grainSize);
+			std::vector<Optional<T>> partials(Math::CeilDiv(count, grain));
+			ParallelChunks(count, grain, [&] (size_t first, size_t last)
+			{
+				T partial = static_cast<T>(begin[first]);
+				for (size_t i = first + 1; i < last; i++)
+				{
+					partial = std::invoke(operation, std::move(partial), static_cast<T>(begin[i]));
+				}
+				partials[first / grain].Emplace(std::move(partial));
+			});
+
+			for (auto& partial : partials)
+			{
+				init = std::invoke(operation, std::move(init), partial.Unwrap());
+			}
+			return init;
+		}
+
 	private:
+		using PackagedTask = Worker::PackagedTask;
+
+
 		unsigned int GetNextThreadIndex()
 		{
 			return mNextQueueIndex.fetch_add(1, std::memory_order_relaxed) % mThreadCount;
 		}
 
 
+		/// Returns grainSize, or if it is 0, a grain which splits count into several chunks per thread.
+		size_t ChooseGrainSize(size_t count, size_t grainSize) const noexcept
+		{
+			if (grainSize > 0) return grainSize;
+
+			static constexpr size_t CHUNKS_PER_THREAD = 4;
+			return std::max<size_t>(1, Math::CeilDiv(count, CHUNKS_PER_THREAD * (mThreadCount + 1)));
+		}
+
+
+		/// Calls chunkFunction(first, last) for consecutive chunks covering [0, count), returning once all have completed.
+		///
+		/// The calling thread claims chunks alongside the helpers, so this never waits on a helper which has not started.
+		/// Helpers which start after every chunk has been claimed return immediately. If a chunk throws, the chunks
+		/// which have not started yet are skipped, and the first exception is rethrown once the rest have finished.
+		template <typename F>
+		void ParallelChunks(size_t count, size_t grainSize, F&& chunkFunction)
+		{
+			ZoneScoped;
+
+			if (count == 0) return;
+
+			const size_t grain      = ChooseGrainSize(count, grainSize);
+			const size_t chunkCount = Math::CeilDiv(count, grain);
+			if (chunkCount == 1 || mThreadCount == 0)
+			{
+				// Callers may index per chunk state by first / grain, so the chunks are kept even when run in order.
+				for (size_t first = 0; first < count; first += grain)
+				{
+					std::invoke(chunkFunction, first, std::min(count, first + grain));
+				}
+				return;
+			}
+
+
+			struct State
+			{
+				explicit State(size_t chunkCount)
+					: remainingChunks(static_cast<std::ptrdiff_t>(chunkCount))
+				{}
+
+				std::atomic<size_t> nextChunk = 0;
+				std::latch          remainingChunks;
+				/// Set by the first chunk to throw, whose exception is rethrown once every chunk has finished.
+				std::atomic_bool    failed = false;
+				std::exception_ptr  exception;
+			};
+
+
+			// Every chunk counts down the latch, even if it throws or is skipped after another threw, so chunkFunction
+			// is never used by a helper after this returns.
+			auto state = std::make_shared<State>(chunkCount);
+			auto runChunks = [state, count, grain, chunkCount, &chunkFunction]
+			{
+				for (size_t chunk = state->nextChunk.fetch_add(1, std::memory_order_relaxed);
+					 chunk < chunkCount;
+					 chunk = state->nextChunk.fetch_add(1, std::memory_order_relaxed))
+				{
+					if (!state->failed.load(std::memory_order_relaxed))
+					{
+						try
+						{
+							std::invoke(chunkFunction, chunk * grain, std::min(count, (chunk + 1) * grain));
+						}
+						catch (...)
+						{
+							if (!state->failed.exchange(true)) state->exception = std::current_exception();
+						}
+					}
+					state->remainingChunks.count_down();
+				}
+			};
+
+			const size_t helperCount = std::min(mThreadCount, chunkCount - 1);
+			for (size_t i = 0; i < helperCount; i++)
+			{
+				// Completion is tracked by the latch, so the helpers are posted without a PendingTask.
+				Post(runChunks);
+			}
+
+			runChunks();
+			state->remainingChunks.wait();
+
+			if (state->exception)
+			{
+				std::rethrow_exception(state->exception);
+			}
+		}
+
+
+		template <std::unsigned_integral T, size_t D, typename F>
+		void ParallelForExtent(Math::Vector<T, D> extent, F& function, size_t grainSize)
+		{
+			ZoneScoped;
+
+			const size_t count = extent.Fold(std::multiplies());
+			ParallelChunks(count, grainSize, [&] (size_t first, size_t last)
+			{
+				Math::Vector<T, D> position = extent.UnflattenR(static_cast<T>(first));
+				for (size_t i = first; i < last; i++)
+				{
+					std::invoke(function, static_cast<const Math::Vector<T, D>&>(position));
+
+					// Step to the next position in FlattenR order, carrying into higher dimensions.
+					for (size_t d = 0; d < D; d++)
+					{
+						if (++position[d] < extent[d]) break;
+						position[d] = 0;
+					}
+				}
+			});
+		}
+
+
+		/// Hands ownership of the given jobs to the work stealing scheduler.
+		void Schedule(std::span<PackagedTask* const> jobs);
+		/// Main loop of a thread in a work stealing pool.
+		void RunStealingThread(unsigned int index);
+		/// Looks for a job in the local deque, then the injection queue, and then the other threads' deques.
+		PackagedTask* FindJob(unsigned int index);
+		/// Wakes sleeping threads after new work has been published.
+		void NotifyWork(size_t jobCount);
+
+
 		const size_t mThreadCount;
+		const Scheduling mScheduling;
 		std::atomic<unsigned int> mNextQueueIndex = 0;
 		std::unique_ptr<Worker[]> mWorkers;
+
+
+		/// Whether threads in a work stealing pool should keep running.
+		std::atomic_bool mRunningFlag = true;
+		/// One deque per thread in a work stealing pool.
+		std::unique_ptr<LockFree::WorkStealingDeque<PackagedTask*>[]> mDeques;
+		/// Jobs queued from threads outside of a work stealing pool.
+		std::mutex mInjectionMutex;
+		std::deque<PackagedTask*> mInjectionQueue;
+		/// Incremented whenever work is published, so that sleeping threads can wait on it.
+		std::atomic<unsigned int> mWorkEpoch = 0;
+		/// The number of threads currently waiting on mWorkEpoch.
+		std::atomic<unsigned int> mSleepingCount = 0;
+		std::vector<std::thread> mThreads;
 	};
 }
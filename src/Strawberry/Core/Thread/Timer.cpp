@@ -0,0 +1,85 @@
+#include "Timer.hpp"
+
+
+namespace Strawberry::Core
+{
+	Timer::Timer(ThreadPool& pool)
+		: mPool(pool)
+		, mThread([this] { Run(); })
+	{}
+
+
+	Timer::~Timer()
+	{
+		ZoneScoped;
+
+		std::unique_lock lock(mMutex);
+		mRunning = false;
+		mCV.notify_one();
+		lock.unlock();
+
+		mThread.join();
+
+		while (!mEntries.empty())
+		{
+			Resume(mEntries.top().handle);
+			mEntries.pop();
+		}
+	}
+
+
+	void Timer::Schedule(Clock::time_point deadline, std::coroutine_handle<> handle)
+	{
+		ZoneScoped;
+
+		std::unique_lock lock(mMutex);
+		const bool earliest = mEntries.empty() || deadline < mEntries.top().deadline;
+		mEntries.push(Entry{deadline, handle});
+		if (earliest)
+		{
+			mCV.notify_one();
+		}
+	}
+
+
+	void Timer::Run()
+	{
+		ZoneScoped;
+
+		std::unique_lock lock(mMutex);
+		while (mRunning)
+		{
+			if (mEntries.empty())
+			{
+				mCV.wait(lock);
+				continue;
+			}
+
+			// Copied, since the queue may reallocate while we wait.
+			const Clock::time_point deadline = mEntries.top().deadline;
+			if (deadline > Clock::now())
+			{
+				mCV.wait_until(lock, deadline);
+				continue;
+			}
+
+			auto handle = mEntries.top().handle;
+			mEntries.pop();
+			lock.unlock();
+			Resume(handle);
+			lock.lock();
+		}
+	}
+
+
+	void Timer::Resume(std::coroutine_handle<> handle)
+	{
+		if (mPool.ThreadCount() == 0)
+		{
+			handle.resume();
+			return;
+		}
+
+		mPool.Post([handle] { handle.resume(); });
+	}
+}
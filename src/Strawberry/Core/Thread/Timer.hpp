@@ -0,0 +1,84 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Thread/ThreadPool.hpp"
+// Standard Library
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+
+namespace Strawberry::Core
+{
+	/// Lets coroutines sleep without blocking a thread.
+	///
+	/// A single background thread waits for the earliest deadline, and posts each expired coroutine to the ThreadPool,
+	/// so no user code ever runs on the timer's own thread. Coroutines still sleeping when the Timer is destroyed
+	/// are resumed early.
+	class Timer
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+
+		explicit Timer(ThreadPool& pool);
+		Timer(const Timer&) = delete;
+		Timer(Timer&&) = delete;
+		Timer& operator=(const Timer&) = delete;
+		Timer& operator=(Timer&&) = delete;
+		~Timer();
+
+
+		/// Returns an awaitable which resumes the awaiting coroutine on the pool once deadline has passed.
+		auto SleepUntil(Clock::time_point deadline) noexcept
+		{
+			struct Awaiter
+			{
+				Timer&            timer;
+				Clock::time_point deadline;
+
+				bool await_ready() const noexcept { return deadline <= Clock::now(); }
+				void await_suspend(std::coroutine_handle<> handle) { timer.Schedule(deadline, handle); }
+				void await_resume() const noexcept {}
+			};
+
+			return Awaiter{*this, deadline};
+		}
+
+
+		/// Returns an awaitable which resumes the awaiting coroutine on the pool after duration has elapsed.
+		auto SleepFor(Clock::duration duration) noexcept
+		{
+			return SleepUntil(Clock::now() + duration);
+		}
+
+
+	private:
+		struct Entry
+		{
+			Clock::time_point       deadline;
+			std::coroutine_handle<> handle;
+
+			bool operator>(const Entry& other) const noexcept { return deadline > other.deadline; }
+		};
+
+
+		void Schedule(Clock::time_point deadline, std::coroutine_handle<> handle);
+		void Run();
+		void Resume(std::coroutine_handle<> handle);
+
+
+		ThreadPool& mPool;
+
+		std::mutex                                                     mMutex;
+		std::condition_variable                                        mCV;
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<>> mEntries;
+		bool                                                           mRunning = true;
+
+		// Declared last so that the queue is constructed before the thread starts using it.
+		std::thread mThread;
+	};
+}
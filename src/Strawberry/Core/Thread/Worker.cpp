@@ -22,16 +22,19 @@ namespace Strawberry::Core
 		ZoneScoped;
 
 		mRunningFlag = false;
-
-		std::unique_lock lock(mTaskQueueMutex);
-		mTaskQueue.clear();
+		mWakeEpoch.fetch_add(1);
+		mWakeEpoch.notify_one();
 
 		if (mThread.joinable())
 		{
-			mTaskQueueCV.notify_one();
-			lock.unlock();
 			mThread.join();
 		}
+
+		// Any tasks which were never started are abandoned.
+		while (mTaskQueue.Pop()) {}
+		std::unique_lock lock(mOverflowMutex);
+		mOverflow.clear();
+		mOverflowCount = 0;
 	}
 
 
@@ -39,28 +42,74 @@ namespace Strawberry::Core
 	{
 		ZoneScoped;
 
-		while (true)
+		while (mRunningFlag)
 		{
-			std::unique_lock lock(mTaskQueueMutex);
-			mTaskQueueCV.wait(lock, [&] { return !mRunningFlag || !mTaskQueue.empty(); });
-			std::deque<PackagedTask> tasks = std::move(mTaskQueue);
-			lock.unlock();
-
-			for (auto&& task : tasks)
+			if (auto task = mTaskQueue.Pop())
 			{
-				if (!mRunningFlag) return;
-				std::invoke(task);
+				Invoke(task.Value());
+				continue;
 			}
 
-			if (tasks.empty())
+			if (mOverflowCount.load(std::memory_order_acquire) > 0)
 			{
-				if (!mRunningFlag)
-				{
-					return;
-				}
+				RunOverflow();
+				continue;
+			}
 
-				std::this_thread::yield();
+
+			// Announce that we are about to sleep, and then check for work one last time. Paired with the fence
+			// in Enqueue, either the producer sees that we are sleeping, or we see its task.
+			const uint32_t epoch = mWakeEpoch.load(std::memory_order_acquire);
+			mSleeping.store(true, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			if (mRunningFlag && mTaskQueue.IsEmpty() && mOverflowCount.load(std::memory_order_relaxed) == 0)
+			{
+				mWakeEpoch.wait(epoch, std::memory_order_acquire);
 			}
+
+			mSleeping.store(false, std::memory_order_relaxed);
+		}
+	}
+
+
+	void Worker::Enqueue(PackagedTask&& task)
+	{
+		ZoneScoped;
+
+		// Once tasks have overflowed, later ones follow them until they are taken, so that tasks are run in the order
+		// they were queued.
+		if (mOverflowCount.load(std::memory_order_acquire) > 0 || !mTaskQueue.Push(std::move(task)))
+		{
+			std::unique_lock lock(mOverflowMutex);
+			mOverflow.emplace_back(std::move(task));
+			mOverflowCount.fetch_add(1, std::memory_order_release);
+		}
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (mSleeping.load(std::memory_order_relaxed))
+		{
+			mWakeEpoch.fetch_add(1, std::memory_order_release);
+			mWakeEpoch.notify_one();
+		}
+	}
+
+
+	void Worker::RunOverflow()
+	{
+		ZoneScoped;
+
+		std::unique_lock lock(mOverflowMutex);
+		std::vector<PackagedTask> tasks = std::move(mOverflow);
+		mOverflow.clear();
+		mOverflowCount.fetch_sub(tasks.size(), std::memory_order_relaxed);
+		lock.unlock();
+
+		// Once Join has been called, the tasks left are abandoned along with those in the queue.
+		for (auto& task : tasks)
+		{
+			if (!mRunningFlag) return;
+			Invoke(task);
 		}
 	}
 }
@@ -1,27 +1,21 @@
 #pragma once
 // Strawberry Core
 #include "Strawberry/Core/Sync/Mutex.hpp"
+#include "Strawberry/Core/Sync/ProducerConsumerQueue.hpp"
+#include "Strawberry/Core/Thread/InlineTask.hpp"
+#include "Strawberry/Core/Thread/PendingTask.hpp"
 #include "Strawberry/Core/Types/Result.hpp"
 #include "Strawberry/Core/Types/Variant.hpp"
 // Standard Library
 #include <atomic>
-#include <deque>
 #include <functional>
-#include <future>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 
 namespace Strawberry::Core
 {
-	template<typename T = void>
-	using Task = std::function<T()>;
-
-	template <typename T>
-	using PendingTask = std::future<T>;
-
-	template <typename T>
-	using PendingTaskList = std::vector<PendingTask<T>>;
-
 	class QueueError
 	{
 	public:
@@ -40,6 +34,8 @@ namespace Strawberry::Core
 
 	class Worker
 	{
+		friend class ThreadPool;
+
 	public:
 		Worker();
 		Worker(const Worker&) = delete;
@@ -55,13 +51,19 @@ namespace Strawberry::Core
 			ZoneScoped;
 
 			auto [future, packagedTask] = PackageTask(std::forward<F>(task));
+			Enqueue(std::move(packagedTask));
+			return std::move(future);
+		}
 
-			std::unique_lock lock(mTaskQueueMutex);
-			mTaskQueue.emplace_back(std::move(packagedTask));
-			mTaskQueueCV.notify_one();
-			lock.unlock();
 
-			return std::move(future);
+		/// Queues a task whose result is not needed. Small tasks are queued without any allocation. Exceptions thrown by
+		/// the task are dropped.
+		template <typename F> requires (std::invocable<std::decay_t<F>&>)
+		void Post(F&& task)
+		{
+			ZoneScoped;
+
+			Enqueue(PackagedTask(std::forward<F>(task)));
 		}
 
 
@@ -69,7 +71,7 @@ namespace Strawberry::Core
 		QueueResult<PendingTaskList<T>> Queue(Range&& tasks) {
 			ZoneScoped;
 
-			std::vector<std::future<T>> futures;
+			PendingTaskList<T> futures;
 			if constexpr (std::ranges::sized_range<Range>)
 			{
 				auto size = tasks.size();
@@ -77,26 +79,16 @@ namespace Strawberry::Core
 			}
 
 
-			std::unique_lock lock(mTaskQueueMutex, std::defer_lock);
-			while (true)
+			if (!mRunningFlag)
 			{
-				if (lock.try_lock())
-				{
-					for (Task<T>&& task : tasks)
-					{
-						auto [future, packagedTask] = PackageTask(std::move(task));
-						mTaskQueue.emplace_back(std::move(packagedTask));
-						futures.emplace_back(std::move(future));
-					}
-					mTaskQueueCV.notify_one();
-					lock.unlock();
-					break;
-				}
-
-				if (!mRunningFlag)
-				{
-					return QueueError::Interupted{};
-				}
+				return QueueError::Interupted{};
+			}
+
+			for (auto&& task : tasks)
+			{
+				auto [future, packagedTask] = PackageTask(std::forward<decltype(task)>(task));
+				Enqueue(std::move(packagedTask));
+				futures.emplace_back(std::move(future));
 			}
 
 			return futures;
@@ -108,38 +100,64 @@ namespace Strawberry::Core
 
 
 	private:
-		using PackagedTask = std::packaged_task<void()>;
-		using TaskQueue = std::deque<PackagedTask>;
+		using PackagedTask = InlineTask;
+
+
+		/// The number of tasks which can be queued before further tasks spill into the overflow list.
+		static constexpr size_t QUEUE_CAPACITY = 1024;
+		using TaskQueue = LockFree::MPMCQueue<PackagedTask, QUEUE_CAPACITY>;
 
 
+		/// Wraps task so that running it completes the returned PendingTask.
+		///
+		/// The result state is recycled, and the wrapper is stored inline in the PackagedTask when the task is small,
+		/// so in steady state this does not allocate.
 		template <typename F, typename T = std::invoke_result_t<F>>
-		static std::pair<std::future<T>, PackagedTask> PackageTask(F&& task)
-		{	ZoneScoped;
-			std::promise<T> promise;
-			auto future = promise.get_future();
+		static std::pair<PendingTask<T>, PackagedTask> PackageTask(F&& task)
+		{
+			ZoneScoped;
+
+			auto* state = PendingTaskState<T>::Create();
+			return std::make_pair(
+				PendingTask<T>(state),
+				PackagedTask(CompletingTask<std::decay_t<F>, T>(state, std::forward<F>(task))));
+		}
 
-			PackagedTask packagedTask([promise = std::move(promise), task = std::forward<F>(task)] mutable
+
+		/// Runs task. Queued tasks keep their exceptions in their PendingTask, so only posted tasks throw here, and as
+		/// nothing waits on those, their exceptions are dropped, as they would be with a discarded PendingTask.
+		static void Invoke(PackagedTask& task) noexcept
+		{
+			try
 			{
-				if constexpr (std::is_void_v<T>)
-				{
-					std::invoke(task);
-					promise.set_value();
-				}
-				else
-				{
-					promise.set_value(std::invoke(task));
-				}
-			});
-
-			return std::make_pair(std::move(future), std::move(packagedTask));
+				std::invoke(task);
+			}
+			catch (...) {}
 		}
 
 
+		/// Adds a task to the queue, or to the overflow list if the queue is full or the list is not empty, and wakes
+		/// the thread if needed.
+		///
+		/// A full queue never blocks, since that would deadlock a task which queues more work onto its own Worker.
+		void Enqueue(PackagedTask&& task);
+		/// Runs every task in the overflow list, stopping without running the rest if the Worker is joined.
+		void RunOverflow();
+
+
 		std::atomic_bool mRunningFlag;
-		std::thread mThread;
 
-		std::mutex mTaskQueueMutex;
-		std::condition_variable mTaskQueueCV;
 		TaskQueue mTaskQueue;
+
+		std::mutex mOverflowMutex;
+		std::vector<PackagedTask> mOverflow;
+		std::atomic<size_t> mOverflowCount = 0;
+
+		/// Incremented to wake the thread while it is sleeping.
+		std::atomic<uint32_t> mWakeEpoch = 0;
+		std::atomic_bool mSleeping = false;
+
+		// Declared last so that the queue is constructed before the thread starts using it.
+		std::thread mThread;
 	};
 }
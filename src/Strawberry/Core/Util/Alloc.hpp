@@ -1,14 +1,22 @@
 #pragma once
-
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <algorithm>
 #ifdef STRAWBERRY_TARGET_WINDOWS
 	#include <malloc.h>
 #else
 	#include <cstdlib>
 #endif
+#include <cstddef>
 
 
 namespace Strawberry::Core
 {
+	/// The assumed size of a cache line, used to keep independently written atomics from sharing lines.
+	static constexpr size_t CACHE_LINE_SIZE = 64;
+
+
 #ifdef STRAWBERRY_TARGET_WINDOWS
 	inline void* AlignedAlloc(size_t alignment, size_t size) noexcept
 	{
@@ -1,7 +1,14 @@
 #pragma once
+#include <bit>
 #include <concepts>
 #include <cstdint>
+#include <functional>
+#include <iterator>
 #include <map>
+#include <set>
+#include <utility>
+#include <vector>
+#include "Strawberry/Core/Assert.hpp"
 #include "Strawberry/Core/Types/Optional.hpp"
 
 namespace Strawberry::Core
@@ -10,6 +17,12 @@ namespace Strawberry::Core
 	{
 		size_t position;
 		size_t extent;
+
+
+		[[nodiscard]] size_t End() const noexcept { return position + extent; }
+
+
+		bool operator==(const AllocatorSegment&) const = default;
 	};
 
 
@@ -33,18 +46,73 @@ namespace Strawberry::Core
 	};
 
 
+	/// A snapshot of how much of an allocator's resource is in use, and how fragmented the rest of it is.
+	struct AllocatorStats
+	{
+		/// The number of units of the resource which are managed by the allocator.
+		size_t capacity         = 0;
+		/// The number of units reserved by live allocations, including any rounding up done by the allocator.
+		size_t allocated        = 0;
+		/// The number of units which live allocations asked for.
+		size_t requested        = 0;
+		size_t allocationCount  = 0;
+		size_t freeBlockCount   = 0;
+		size_t largestFreeBlock = 0;
+
+
+		[[nodiscard]] size_t Free() const noexcept { return capacity - allocated; }
+
+
+		/// The fraction of free space which cannot be used for an allocation as large as all of it.
+		[[nodiscard]] double ExternalFragmentation() const noexcept
+		{
+			return Free() == 0 ? 0.0 : 1.0 - static_cast<double>(largestFreeBlock) / static_cast<double>(Free());
+		}
+
+
+		/// The fraction of reserved space which was not asked for.
+		[[nodiscard]] double InternalFragmentation() const noexcept
+		{
+			return allocated == 0 ? 0.0 : 1.0 - static_cast<double>(requested) / static_cast<double>(allocated);
+		}
+	};
+
+
+	/// Describes the resource which an allocator divides up, and the segments which it hands out.
+	///
+	/// AllocateFN creates the segment for a range of the resource, and may fail. DeallocateFN releases a segment before
+	/// its range is reused. SegmentRangeFN recovers the range which a segment was created for.
 	template <typename Config>
 	concept AllocatorConfig = requires
 	{
 		typename Config::ResourceType;
 		typename Config::SegmentType;
 
-		{ std::invoke(Config::AllocateFN, std::declval<const typename Config::Resource&>(), std::declval<const AllocatorConfig&>()) } -> std::convertible_to<Optional<typename Config::SegmentType>>;
-		{ std::invoke(Config::DeallocateFN, std::declval<const typename Config::ResourceType&>(), std::declval<const typename Config::SegmentType&>()) };
-		{ std::invoke(Config::ResourceSizeFN, std::declval<const typename Config::ResourceType>()) } -> std::convertible_to<size_t>;
+		{ std::invoke(Config::AllocateFN, std::declval<typename Config::ResourceType&>(), std::declval<const AllocatorSegment&>()) } -> std::convertible_to<Optional<typename Config::SegmentType>>;
+		{ std::invoke(Config::DeallocateFN, std::declval<typename Config::ResourceType&>(), std::declval<typename Config::SegmentType&&>()) };
+		{ std::invoke(Config::ResourceSizeFN, std::declval<const typename Config::ResourceType&>()) } -> std::convertible_to<size_t>;
+		{ std::invoke(Config::SegmentRangeFN, std::declval<const typename Config::SegmentType&>()) } -> std::convertible_to<AllocatorSegment>;
+	};
+
+
+	/// Config for allocators which simply hand out ranges of an abstract resource, which is described by its size.
+	struct RangeAllocatorConfig
+	{
+		using ResourceType = size_t;
+		using SegmentType  = AllocatorSegment;
+
+		static constexpr auto AllocateFN     = [] (size_t&, const AllocatorSegment& segment) -> Optional<AllocatorSegment> { return segment; };
+		static constexpr auto DeallocateFN   = [] (size_t&, AllocatorSegment&&) {};
+		static constexpr auto ResourceSizeFN = [] (const size_t& size) { return size; };
+		static constexpr auto SegmentRangeFN = [] (const AllocatorSegment& segment) { return segment; };
 	};
 
 
+	/// Best fit allocator with coalescing.
+	///
+	/// Free blocks are indexed both by position, to find the neighbours of a freed block, and by size, to find the
+	/// smallest block which can hold a request. Allocating and freeing are O(log n) in the number of free blocks. Any
+	/// padding needed for alignment stays free. Not thread safe.
 	template <AllocatorConfig _Config>
 	class FreelistAllocator
 	{
@@ -52,28 +120,98 @@ namespace Strawberry::Core
 		using Config = _Config;
 
 
-		FreelistAllocator(Config::Resource&& resource)
+		FreelistAllocator(Config::ResourceType&& resource)
 			: mResource(std::move(resource))
+			, mCapacity(Config::ResourceSizeFN(mResource))
 		{
-			mFreeLists.emplace(0, Config::ResourceSizeFN(mResource));
+			if (mCapacity > 0) InsertFreeBlock(0, mCapacity);
 		}
 
 
 		Optional<typename Config::SegmentType> Allocate(const AllocationRequest& request)
 		{
-			for (const auto& [pos, size] : mFreeLists)
+			ZoneScoped;
+
+			Assert(request.count > 0);
+			Assert(request.alignment > 0);
+
+			// Blocks in order of size from the smallest which could fit, so the first which fits once aligned is the best.
+			for (auto block = mFreeBySize.lower_bound({request.count, 0}); block != mFreeBySize.end(); ++block)
 			{
-				auto aligned = NextAlignedAddress(pos, request.alignment);
+				const auto [extent, position] = *block;
+				const size_t aligned = NextAlignedAddress(position, request.alignment);
+				if (aligned + request.count > position + extent) continue;
+
+				AllocatorSegment range{aligned, request.count};
+				auto segment = Config::AllocateFN(mResource, range);
+				if (!segment) return NullOpt;
+
+				// The nodes of the block are reused for what is left of it, so that most allocations never touch the heap.
+				FreeBlockNodes nodes{mFreeByPosition.extract(position), mFreeBySize.extract(block)};
+				if (aligned > position) InsertFreeBlock(position, aligned - position, std::move(nodes));
+				if (range.End() < position + extent) InsertFreeBlock(range.End(), position + extent - range.End(), std::move(nodes));
+
+				mAllocated += request.count;
+				mAllocationCount++;
+				return segment;
 			}
+
+			return NullOpt;
 		}
 
 
 		void Free(Config::SegmentType&& segment)
 		{
+			ZoneScoped;
+
+			AllocatorSegment range = Config::SegmentRangeFN(segment);
 			Config::DeallocateFN(mResource, std::move(segment));
+
+			mAllocated -= range.extent;
+			mAllocationCount--;
+
+			// Merge with the free blocks either side, if they touch.
+			FreeBlockNodes nodes;
+			auto next = mFreeByPosition.lower_bound(range.position);
+			Assert(next == mFreeByPosition.end() || next->first >= range.End(), "Freed a segment which overlaps a free block!");
+			if (next != mFreeByPosition.end() && next->first == range.End())
+			{
+				range.extent += next->second;
+				nodes = ExtractFreeBlock(next++);
+			}
+
+			if (next != mFreeByPosition.begin())
+			{
+				if (auto previous = std::prev(next); previous->first + previous->second == range.position)
+				{
+					range.position = previous->first;
+					range.extent  += previous->second;
+					auto previousNodes = ExtractFreeBlock(previous);
+					if (!nodes.position) nodes = std::move(previousNodes);
+				}
+			}
+
+			InsertFreeBlock(range.position, range.extent, std::move(nodes));
+		}
+
+
+		[[nodiscard]] AllocatorStats GetStats() const noexcept
+		{
+			return AllocatorStats{
+				.capacity         = mCapacity,
+				.allocated        = mAllocated,
+				.requested        = mAllocated,
+				.allocationCount  = mAllocationCount,
+				.freeBlockCount   = mFreeByPosition.size(),
+				.largestFreeBlock = mFreeBySize.empty() ? 0 : mFreeBySize.rbegin()->first,
+			};
 		}
 
 
+		[[nodiscard]]       Config::ResourceType& GetResource()       noexcept { return mResource; }
+		[[nodiscard]] const Config::ResourceType& GetResource() const noexcept { return mResource; }
+
+
 	private:
 		static size_t NextAlignedAddress(size_t address, size_t alignment)
 		{
@@ -82,13 +220,64 @@ namespace Strawberry::Core
 			return address + offset;
 		}
 
+
+		using PositionMap = std::map<size_t, size_t>;
+		using SizeSet     = std::set<std::pair<size_t, size_t>>;
+
+
+		/// The tree nodes of a free block which has been removed, which may be reused to insert another.
+		struct FreeBlockNodes
+		{
+			PositionMap::node_type position;
+			SizeSet::node_type     size;
+		};
+
+
+		FreeBlockNodes ExtractFreeBlock(PositionMap::iterator block)
+		{
+			auto size = mFreeBySize.extract({block->second, block->first});
+			return {mFreeByPosition.extract(block), std::move(size)};
+		}
+
+
+		void InsertFreeBlock(size_t position, size_t extent, FreeBlockNodes&& nodes = {})
+		{
+			if (nodes.position)
+			{
+				nodes.position.key()    = position;
+				nodes.position.mapped() = extent;
+				nodes.size.value()      = {extent, position};
+				mFreeByPosition.insert(std::move(nodes.position));
+				mFreeBySize.insert(std::move(nodes.size));
+			}
+			else
+			{
+				mFreeByPosition.emplace(position, extent);
+				mFreeBySize.emplace(extent, position);
+			}
+		}
+
+
 		Config::ResourceType mResource;
+		size_t               mCapacity;
+		size_t               mAllocated       = 0;
+		size_t               mAllocationCount = 0;
 
 		// Mapping of positions to lengths, representing free segments in the resource;
-		std::map<size_t, size_t> mFreeLists;
+		PositionMap mFreeByPosition;
+		// The same free segments, as (length, position), ordered by length.
+		SizeSet     mFreeBySize;
 	};
 
 
+	/// Power of two buddy allocator.
+	///
+	/// The largest power of two prefix of the resource is treated as a binary tree of blocks, each half the size of
+	/// its parent, down to the minimum block size. Requests are rounded up to a block size, and blocks are split until
+	/// one of that size is free. Blocks are aligned to their size, so any power of two alignment up to the block size
+	/// comes for free. One bitmap records which blocks have been split, so that freeing a segment can find its block
+	/// from its position, and another records which blocks are free, so that a freed block can tell in O(1) whether
+	/// its buddy is free to merge with. Allocating and freeing are O(log n). Not thread safe.
 	template <AllocatorConfig _Config>
 	class BuddyAllocator
 	{
@@ -96,18 +285,186 @@ namespace Strawberry::Core
 		using Config = _Config;
 
 
-		Config::SegmentType Allocate(const AllocationRequest& request)
+		static constexpr size_t DEFAULT_MINIMUM_BLOCK_SIZE = 64;
+
+
+		BuddyAllocator(Config::ResourceType&& resource, size_t minimumBlockSize = DEFAULT_MINIMUM_BLOCK_SIZE)
+			: mResource(std::move(resource))
+			, mCapacity(std::bit_floor(static_cast<size_t>(Config::ResourceSizeFN(mResource))))
+			, mMinimumBlockSize(std::bit_ceil(std::max<size_t>(minimumBlockSize, 1)))
+		{
+			if (mCapacity < mMinimumBlockSize)
+			{
+				mCapacity = 0;
+				return;
+			}
+
+			mDepthCount = static_cast<unsigned int>(std::countr_zero(mCapacity / mMinimumBlockSize)) + 1;
+			const size_t nodeCount = (size_t(1) << mDepthCount) - 1;
+			mSplit.assign((nodeCount + 63) / 64, 0);
+			mFree.assign((nodeCount + 63) / 64, 0);
+			mFreeLists.resize(mDepthCount);
+
+			MarkFree(0, 0);
+		}
+
+
+		Optional<typename Config::SegmentType> Allocate(const AllocationRequest& request)
 		{
+			ZoneScoped;
+
+			Assert(request.count > 0);
+			Assert(std::has_single_bit(request.alignment), "BuddyAllocator only supports power of two alignments!");
+
+			const size_t blockSize = std::bit_ceil(std::max({request.count, request.alignment, mMinimumBlockSize}));
+			if (mCapacity == 0 || blockSize > mCapacity) return NullOpt;
+			const unsigned int targetDepth = std::countr_zero(mCapacity / blockSize);
+
+
+			// Find the smallest free block which is large enough.
+			unsigned int depth = targetDepth + 1;
+			while (depth-- > 0 && mFreeLists[depth].empty()) {}
+			if (depth > targetDepth) return NullOpt;
+
+			size_t node = *mFreeLists[depth].begin();
+			MarkUsed(depth, node);
 
+			// Split it until it is the right size, leaving the upper halves free.
+			for (; depth < targetDepth; depth++)
+			{
+				SetBit(mSplit, node);
+				MarkFree(depth + 1, RightChild(node));
+				node = LeftChild(node);
+			}
+
+
+			AllocatorSegment range{PositionOf(depth, node), request.count};
+			auto segment = Config::AllocateFN(mResource, range);
+			if (!segment)
+			{
+				Release(depth, node);
+				return NullOpt;
+			}
+
+			mAllocated += blockSize;
+			mRequested += request.count;
+			mAllocationCount++;
+			return segment;
 		}
 
 
 		void Free(Config::SegmentType&& segment)
 		{
+			ZoneScoped;
+
+			const AllocatorSegment range = Config::SegmentRangeFN(segment);
+			Config::DeallocateFN(mResource, std::move(segment));
+
+			// Follow split blocks down from the root to the block which was allocated at this position.
+			unsigned int depth = 0;
+			size_t       node  = 0;
+			while (GetBit(mSplit, node))
+			{
+				node = range.position < PositionOf(depth + 1, RightChild(node)) ? LeftChild(node) : RightChild(node);
+				depth++;
+			}
+			AssertEQ(PositionOf(depth, node), range.position);
+			Assert(!GetBit(mFree, node), "Freed a segment which is not allocated!");
 
+			mAllocated -= BlockSize(depth);
+			mRequested -= range.extent;
+			mAllocationCount--;
+			Release(depth, node);
 		}
 
+
+		[[nodiscard]] AllocatorStats GetStats() const noexcept
+		{
+			size_t freeBlockCount   = 0;
+			size_t largestFreeBlock = 0;
+			for (unsigned int depth = 0; depth < mDepthCount; depth++)
+			{
+				freeBlockCount += mFreeLists[depth].size();
+				if (largestFreeBlock == 0 && !mFreeLists[depth].empty()) largestFreeBlock = BlockSize(depth);
+			}
+
+			return AllocatorStats{
+				.capacity         = mCapacity,
+				.allocated        = mAllocated,
+				.requested        = mRequested,
+				.allocationCount  = mAllocationCount,
+				.freeBlockCount   = freeBlockCount,
+				.largestFreeBlock = largestFreeBlock,
+			};
+		}
+
+
+		[[nodiscard]]       Config::ResourceType& GetResource()       noexcept { return mResource; }
+		[[nodiscard]] const Config::ResourceType& GetResource() const noexcept { return mResource; }
+
+
 	private:
+		// Blocks are numbered as an implicit binary heap, with the whole resource as node 0.
+		static size_t LeftChild(size_t node) noexcept { return 2 * node + 1; }
+		static size_t RightChild(size_t node) noexcept { return 2 * node + 2; }
+		static size_t Parent(size_t node) noexcept { return (node - 1) / 2; }
+		static size_t Buddy(size_t node) noexcept { return node % 2 == 1 ? node + 1 : node - 1; }
+
+
+		[[nodiscard]] size_t BlockSize(unsigned int depth) const noexcept { return mCapacity >> depth; }
+
+
+		[[nodiscard]] size_t PositionOf(unsigned int depth, size_t node) const noexcept
+		{
+			const size_t firstAtDepth = (size_t(1) << depth) - 1;
+			return (node - firstAtDepth) * BlockSize(depth);
+		}
+
+
+		/// Returns a block to the free lists, merging it with its buddy for as long as the buddy is free too.
+		void Release(unsigned int depth, size_t node)
+		{
+			while (depth > 0 && GetBit(mFree, Buddy(node)))
+			{
+				MarkUsed(depth, Buddy(node));
+				node = Parent(node);
+				depth--;
+				ClearBit(mSplit, node);
+			}
+			MarkFree(depth, node);
+		}
+
+
+		void MarkFree(unsigned int depth, size_t node)
+		{
+			SetBit(mFree, node);
+			mFreeLists[depth].emplace(node);
+		}
+
+
+		void MarkUsed(unsigned int depth, size_t node)
+		{
+			ClearBit(mFree, node);
+			mFreeLists[depth].erase(node);
+		}
+
+
+		static bool GetBit(const std::vector<uint64_t>& bits, size_t i) noexcept { return (bits[i / 64] >> (i % 64)) & 1; }
+		static void SetBit(std::vector<uint64_t>& bits, size_t i) noexcept { bits[i / 64] |= uint64_t(1) << (i % 64); }
+		static void ClearBit(std::vector<uint64_t>& bits, size_t i) noexcept { bits[i / 64] &= ~(uint64_t(1) << (i % 64)); }
+
+
 		Config::ResourceType mResource;
+		size_t               mCapacity;
+		size_t               mMinimumBlockSize;
+		unsigned int         mDepthCount      = 0;
+		size_t               mAllocated       = 0;
+		size_t               mRequested       = 0;
+		size_t               mAllocationCount = 0;
+
+		std::vector<uint64_t> mSplit;
+		std::vector<uint64_t> mFree;
+		// The free blocks at each depth, ordered so that the lowest addressed is used first.
+		std::vector<std::set<size_t>> mFreeLists;
 	};
 }
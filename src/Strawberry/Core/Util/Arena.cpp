@@ -0,0 +1,84 @@
+#include "Arena.hpp"
+// Standard Library
+#include <algorithm>
+
+
+namespace Strawberry::Core
+{
+	/// Header at the start of each chunk, which is followed by its memory.
+	struct alignas(std::max_align_t) Arena::Chunk
+	{
+		std::byte* Begin() noexcept { return reinterpret_cast<std::byte*>(this + 1); }
+		std::byte* End() noexcept { return Begin() + size; }
+
+
+		Chunk* next;
+		/// The number of bytes after the header.
+		size_t size;
+	};
+
+
+	void Arena::Rewind(Marker marker) noexcept
+	{
+		while (mChunks != marker.chunk)
+		{
+			Assert(mChunks != nullptr, "Rewound an Arena to a Marker from a different Arena!");
+			Chunk* chunk = std::exchange(mChunks, mChunks->next);
+			chunk->next  = std::exchange(mSpare, chunk);
+		}
+
+		mCursor = marker.cursor;
+		mEnd    = mChunks ? mChunks->End() : nullptr;
+	}
+
+
+	void Arena::Release() noexcept
+	{
+		Reset();
+		while (mSpare)
+		{
+			Chunk* chunk = std::exchange(mSpare, mSpare->next);
+			mUpstream->deallocate(chunk, sizeof(Chunk) + chunk->size, alignof(Chunk));
+		}
+		mCapacity = 0;
+	}
+
+
+	Arena& Arena::ThreadLocal() noexcept
+	{
+		thread_local Arena arena;
+		return arena;
+	}
+
+
+	void* Arena::AllocateFromNewChunk(size_t size, size_t alignment)
+	{
+		// Enough for the allocation however the start of a chunk is aligned.
+		const size_t needed = size + alignment;
+
+		Chunk* chunk = nullptr;
+		for (Chunk** link = &mSpare; *link; link = &(*link)->next)
+		{
+			if ((*link)->size >= needed)
+			{
+				chunk = std::exchange(*link, (*link)->next);
+				break;
+			}
+		}
+
+		if (!chunk)
+		{
+			// Chunks grow geometrically, so that an arena which is never reset needs O(log n) of them.
+			const size_t bytes = std::max(mNextChunkSize, std::bit_ceil(sizeof(Chunk) + needed));
+			chunk = static_cast<Chunk*>(mUpstream->allocate(bytes, alignof(Chunk)));
+			chunk->size = bytes - sizeof(Chunk);
+			mCapacity += bytes;
+			mNextChunkSize = 2 * bytes;
+		}
+
+		chunk->next = std::exchange(mChunks, chunk);
+		mCursor     = chunk->Begin();
+		mEnd        = chunk->End();
+		return Allocate(size, alignment);
+	}
+}
@@ -0,0 +1,174 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+
+namespace Strawberry::Core
+{
+	/// Monotonic allocator, which hands out memory by bumping a pointer through large chunks.
+	///
+	/// Individual allocations are never freed. Instead, all of the memory allocated since a Marker is reclaimed at
+	/// once by rewinding to it, or all of it by Reset. Rewound chunks are kept for reuse, so an arena which is reset
+	/// every frame soon stops allocating from upstream at all. Destructors of objects created in an arena are not run.
+	///
+	/// Arenas are std::pmr::memory_resources, so they can back standard containers and anything else which takes a
+	/// polymorphic_allocator. Not thread safe; each thread may use its own through ThreadLocal.
+	class Arena
+		: public std::pmr::memory_resource
+	{
+	public:
+		static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+
+		/// A position in an arena, which it can be rewound to.
+		struct Marker
+		{
+			void*      chunk  = nullptr;
+			std::byte* cursor = nullptr;
+		};
+
+
+		/// Rewinds an arena to where it was when the scope was created, when the scope is destroyed.
+		class Scope
+		{
+		public:
+			explicit Scope(Arena& arena) noexcept
+				: mArena(arena)
+				, mMarker(arena.GetMarker())
+			{}
+
+			~Scope() { mArena.Rewind(mMarker); }
+
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+
+
+		private:
+			Arena& mArena;
+			Marker mMarker;
+		};
+
+
+		explicit Arena(size_t chunkSize = DEFAULT_CHUNK_SIZE, std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+			: mUpstream(upstream)
+			, mNextChunkSize(std::max<size_t>(chunkSize, 256))
+		{}
+
+
+		~Arena() override
+		{
+			Release();
+		}
+
+
+		Arena(const Arena&) = delete;
+		Arena& operator=(const Arena&) = delete;
+
+
+		/// Returns size bytes aligned to alignment, which must be a power of two.
+		[[nodiscard]] void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+		{
+			const uintptr_t address = (reinterpret_cast<uintptr_t>(mCursor) + alignment - 1) & ~(alignment - 1);
+			if (address + size > reinterpret_cast<uintptr_t>(mEnd) || mCursor == nullptr) [[unlikely]]
+			{
+				return AllocateFromNewChunk(size, alignment);
+			}
+
+			mCursor = reinterpret_cast<std::byte*>(address + size);
+			return reinterpret_cast<void*>(address);
+		}
+
+
+		/// Constructs a T in the arena. Its destructor will never be called.
+		template <typename T, typename... Args>
+		[[nodiscard]] T* New(Args&&... args)
+		{
+			return std::construct_at(static_cast<T*>(Allocate(sizeof(T), alignof(T))), std::forward<Args>(args)...);
+		}
+
+
+		/// Returns an array of count value initialised Ts in the arena.
+		template <typename T> requires (std::is_trivially_destructible_v<T>)
+		[[nodiscard]] std::span<T> NewArray(size_t count)
+		{
+			T* array = static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+			std::uninitialized_value_construct_n(array, count);
+			return {array, count};
+		}
+
+
+		[[nodiscard]] Marker GetMarker() const noexcept
+		{
+			return {mChunks, mCursor};
+		}
+
+
+		/// Frees everything allocated since marker was taken. Chunks which are no longer used are kept for reuse.
+		void Rewind(Marker marker) noexcept;
+
+
+		/// Frees everything allocated in the arena, but keeps its memory for reuse.
+		void Reset() noexcept
+		{
+			Rewind({});
+		}
+
+
+		/// Frees everything allocated in the arena, and returns its memory upstream.
+		void Release() noexcept;
+
+
+		/// Returns the number of bytes held from upstream, whether or not they are in use.
+		[[nodiscard]] size_t Capacity() const noexcept
+		{
+			return mCapacity;
+		}
+
+
+		/// Returns an arena for the calling thread, for scratch memory which does not outlive a Scope.
+		static Arena& ThreadLocal() noexcept;
+
+
+	protected:
+		void* do_allocate(size_t bytes, size_t alignment) override
+		{
+			return Allocate(bytes, alignment);
+		}
+
+
+		void do_deallocate(void*, size_t, size_t) override {}
+
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+
+
+	private:
+		struct Chunk;
+
+
+		void* AllocateFromNewChunk(size_t size, size_t alignment);
+
+
+		std::pmr::memory_resource* mUpstream;
+		size_t                     mNextChunkSize;
+		size_t                     mCapacity = 0;
+		/// The chunks in use, newest first.
+		Chunk*                     mChunks   = nullptr;
+		/// Chunks which have been rewound past, kept for reuse.
+		Chunk*                     mSpare    = nullptr;
+		std::byte*                 mCursor   = nullptr;
+		std::byte*                 mEnd      = nullptr;
+	};
+}
@@ -0,0 +1,114 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+
+namespace Strawberry::Core
+{
+	/// Priority queue stored as an implicit heap in which each node has Arity children.
+	///
+	/// A wider heap is shallower than a binary one, so Push does fewer swaps, and the children that Pop compares are
+	/// adjacent in memory. Top is the least element under Compare. Clearing keeps the storage, so a heap which is reused
+	/// does not allocate once it has grown.
+	template <typename T, unsigned int Arity = 4, typename Compare = std::less<T>>
+		requires (Arity >= 2)
+	class DAryHeap
+	{
+	public:
+		explicit DAryHeap(Compare compare = Compare())
+			: mCompare(std::move(compare))
+		{}
+
+
+		template <typename... Args>
+		void Emplace(Args&&... args)
+		{
+			mValues.emplace_back(std::forward<Args>(args)...);
+			SiftUp(mValues.size() - 1);
+		}
+
+
+		void Push(T value)
+		{
+			Emplace(std::move(value));
+		}
+
+
+		[[nodiscard]] const T& Top() const noexcept
+		{
+			Assert(!IsEmpty(), "Called Top on an empty DAryHeap!");
+			return mValues.front();
+		}
+
+
+		T Pop()
+		{
+			Assert(!IsEmpty(), "Called Pop on an empty DAryHeap!");
+			T top = std::move(mValues.front());
+			if (mValues.size() > 1)
+			{
+				mValues.front() = std::move(mValues.back());
+				mValues.pop_back();
+				SiftDown(0);
+			}
+			else
+			{
+				mValues.pop_back();
+			}
+			return top;
+		}
+
+
+		[[nodiscard]] size_t Size() const noexcept { return mValues.size(); }
+		[[nodiscard]] bool IsEmpty() const noexcept { return mValues.empty(); }
+		void Clear() noexcept { mValues.clear(); }
+		void Reserve(size_t capacity) { mValues.reserve(capacity); }
+
+
+	private:
+		void SiftUp(size_t index)
+		{
+			T value = std::move(mValues[index]);
+			while (index > 0)
+			{
+				const size_t parent = (index - 1) / Arity;
+				if (!mCompare(value, mValues[parent])) break;
+				mValues[index] = std::move(mValues[parent]);
+				index = parent;
+			}
+			mValues[index] = std::move(value);
+		}
+
+
+		void SiftDown(size_t index)
+		{
+			T value = std::move(mValues[index]);
+			while (true)
+			{
+				const size_t first = Arity * index + 1;
+				if (first >= mValues.size()) break;
+
+				const size_t last = std::min(first + Arity, mValues.size());
+				size_t least = first;
+				for (size_t child = first + 1; child < last; child++)
+				{
+					if (mCompare(mValues[child], mValues[least])) least = child;
+				}
+
+				if (!mCompare(mValues[least], value)) break;
+				mValues[index] = std::move(mValues[least]);
+				index = least;
+			}
+			mValues[index] = std::move(value);
+		}
+
+
+		std::vector<T>                mValues;
+		[[no_unique_address]] Compare mCompare;
+	};
+}
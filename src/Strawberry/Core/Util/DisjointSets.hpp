@@ -0,0 +1,176 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <atomic>
+#include <concepts>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+
+namespace Strawberry::Core
+{
+	/// Union find over the integers [0, Size()).
+	///
+	/// Union is by size, and Find halves paths as it goes, so any sequence of operations runs in near linear time.
+	template <std::unsigned_integral T = unsigned int>
+	class DisjointSets
+	{
+	public:
+		explicit DisjointSets(size_t count = 0)
+		{
+			Reset(count);
+		}
+
+
+		/// Puts every element in [0, count) in a set of its own, keeping the storage.
+		void Reset(size_t count)
+		{
+			mParents.resize(count);
+			mSizes.assign(count, 1);
+			std::iota(mParents.begin(), mParents.end(), T(0));
+			mSetCount = count;
+		}
+
+
+		/// Returns the representative of the set containing element.
+		[[nodiscard]] T Find(T element) noexcept
+		{
+			Assert(element < mParents.size());
+			while (mParents[element] != element)
+			{
+				mParents[element] = mParents[mParents[element]];
+				element = mParents[element];
+			}
+			return element;
+		}
+
+
+		/// Merges the sets containing a and b. Returns false if they were already the same set.
+		bool Union(T a, T b) noexcept
+		{
+			a = Find(a);
+			b = Find(b);
+			if (a == b) return false;
+
+			if (mSizes[a] < mSizes[b]) std::swap(a, b);
+			mParents[b] = a;
+			mSizes[a] += mSizes[b];
+			mSetCount--;
+			return true;
+		}
+
+
+		[[nodiscard]] bool IsSameSet(T a, T b) noexcept
+		{
+			return Find(a) == Find(b);
+		}
+
+
+		/// Returns the number of elements in the set containing element.
+		[[nodiscard]] size_t SetSize(T element) noexcept
+		{
+			return mSizes[Find(element)];
+		}
+
+
+		[[nodiscard]] size_t Size() const noexcept { return mParents.size(); }
+		[[nodiscard]] size_t SetCount() const noexcept { return mSetCount; }
+
+
+	private:
+		std::vector<T>      mParents;
+		/// The size of each set, which is only kept up to date for representatives.
+		std::vector<size_t> mSizes;
+		size_t              mSetCount = 0;
+	};
+
+
+	/// Union find which any number of threads may use at once, without locks.
+	///
+	/// Sets are always linked by pointing the root with the greater index at the one with the lesser, which keeps the
+	/// forest acyclic however the threads interleave, and makes the root of each set its least element. Find halves
+	/// paths with compare and swap, which can only shorten them, so a failed swap is harmless.
+	template <std::unsigned_integral T = unsigned int>
+	class ConcurrentDisjointSets
+	{
+	public:
+		explicit ConcurrentDisjointSets(size_t count = 0)
+		{
+			Reset(count);
+		}
+
+
+		/// Puts every element in [0, count) in a set of its own. Must not be called while other threads use the sets.
+		void Reset(size_t count)
+		{
+			if (count > mCapacity)
+			{
+				mParents  = std::make_unique<std::atomic<T>[]>(count);
+				mCapacity = count;
+			}
+			mSize = count;
+			for (size_t i = 0; i < count; i++)
+			{
+				mParents[i].store(static_cast<T>(i), std::memory_order::relaxed);
+			}
+		}
+
+
+		/// Returns the current representative of the set containing element, which is its least element once no
+		/// Unions are in progress.
+		[[nodiscard]] T Find(T element) noexcept
+		{
+			Assert(element < mSize);
+			T parent = mParents[element].load(std::memory_order::relaxed);
+			while (parent != element)
+			{
+				T grandparent = mParents[parent].load(std::memory_order::relaxed);
+				if (grandparent != parent)
+				{
+					mParents[element].compare_exchange_weak(parent, grandparent, std::memory_order::relaxed);
+				}
+				element = parent;
+				parent  = mParents[element].load(std::memory_order::relaxed);
+			}
+			return element;
+		}
+
+
+		/// Merges the sets containing a and b. Returns false if they were already the same set.
+		bool Union(T a, T b) noexcept
+		{
+			while (true)
+			{
+				a = Find(a);
+				b = Find(b);
+				if (a == b) return false;
+				if (a < b) std::swap(a, b);
+
+				// a is only linked if it is still a root, otherwise it has been merged meanwhile, so look again.
+				T expected = a;
+				if (mParents[a].compare_exchange_strong(expected, b, std::memory_order::relaxed))
+				{
+					return true;
+				}
+			}
+		}
+
+
+		[[nodiscard]] bool IsSameSet(T a, T b) noexcept
+		{
+			return Find(a) == Find(b);
+		}
+
+
+		[[nodiscard]] size_t Size() const noexcept { return mSize; }
+
+
+	private:
+		std::unique_ptr<std::atomic<T>[]> mParents;
+		size_t                            mCapacity = 0;
+		size_t                            mSize     = 0;
+	};
+}
@@ -3,17 +3,140 @@
 //======================================================================================================================
 //  Includes
 //----------------------------------------------------------------------------------------------------------------------
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+#include "Strawberry/Core/Util/Alloc.hpp"
+// Standard Library
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <compare>
 #include <concepts>
-#include <set>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
 
 //======================================================================================================================
 //  Class Declaration
 //----------------------------------------------------------------------------------------------------------------------
 namespace Strawberry::Core
 {
-	template<std::integral T = size_t>
-	class IDPool
+	/// Policies for the order in which an IDPool reuses freed IDs.
+	namespace IDPoolPolicy
+	{
+		/// Always hands out the lowest free ID, which keeps IDs dense. Freed IDs are kept in a hierarchical bitmap, so
+		/// allocating and freeing are O(log64 n).
+		struct Lowest {};
+
+
+		/// Hands out the most recently freed ID, which is O(1), and usually still in cache.
+		struct Stack {};
+	}
+
+
+	template <typename Policy>
+	concept IDPoolPolicyType = std::same_as<Policy, IDPoolPolicy::Lowest> || std::same_as<Policy, IDPoolPolicy::Stack>;
+
+
+	template<std::integral T = size_t, IDPoolPolicyType Policy = IDPoolPolicy::Lowest>
+	class IDPool;
+
+
+	template<std::integral T>
+	class IDPool<T, IDPoolPolicy::Lowest>
+	{
+	public:
+		T Allocate()
+		{
+			if (mLevels.empty() || mLevels.back()[0] == 0)
+			{
+				return mGreatestID++;
+			}
+
+			// Follow the lowest set bit down from the top level to the leaf.
+			size_t index = 0;
+			for (size_t level = mLevels.size(); level-- > 0;)
+			{
+				index = index * 64 + std::countr_zero(mLevels[level][index]);
+			}
+
+			ClearBit(index);
+			return static_cast<T>(index);
+		}
+
+
+		void Free(T id)
+		{
+			Assert(std::cmp_greater_equal(id, 0) && id < mGreatestID, "Freed an ID which was never allocated!");
+			auto index = static_cast<size_t>(id);
+
+			if (index >= 64 * (mLevels.empty() ? 0 : mLevels[0].size()))
+			{
+				Grow(index + 1);
+			}
+			Assert(!(mLevels[0][index / 64] & Bit(index)), "Freed an ID twice!");
+
+			// Set the bit in each level, until one is reached which already shows that the word below has a free ID.
+			for (auto& level : mLevels)
+			{
+				const bool wasEmpty = level[index / 64] == 0;
+				level[index / 64] |= Bit(index);
+				if (!wasEmpty) break;
+				index /= 64;
+			}
+		}
+
+
+	private:
+		static constexpr uint64_t Bit(size_t index) noexcept { return uint64_t(1) << (index % 64); }
+
+
+		void ClearBit(size_t index)
+		{
+			// Clear the bit in each level, until one is reached whose word still has other free IDs.
+			for (auto& level : mLevels)
+			{
+				level[index / 64] &= ~Bit(index);
+				if (level[index / 64] != 0) break;
+				index /= 64;
+			}
+		}
+
+
+		/// Grows the bitmap to hold at least count IDs, doubling it so that growing is amortised O(1).
+		void Grow(size_t count)
+		{
+			size_t words = std::bit_ceil((count + 63) / 64);
+			if (mLevels.empty()) mLevels.emplace_back();
+			words = std::max(words, 2 * mLevels[0].size());
+			mLevels[0].resize(words, 0);
+
+			// Rebuild every level above the leaves, since the number of levels may have changed.
+			mLevels.resize(1);
+			while (mLevels.back().size() > 1)
+			{
+				const auto& below = mLevels.back();
+				std::vector<uint64_t> level((below.size() + 63) / 64, 0);
+				for (size_t i = 0; i < below.size(); i++)
+				{
+					if (below[i] != 0) level[i / 64] |= Bit(i);
+				}
+				mLevels.emplace_back(std::move(level));
+			}
+		}
+
+
+		T mGreatestID = 0;
+		/// Bitmaps of free IDs, from the leaves, with a bit per ID, up to a single word. Each bit above the leaves is
+		/// set when the corresponding word in the level below is non zero.
+		std::vector<std::vector<uint64_t>> mLevels;
+	};
+
+
+	template<std::integral T>
+	class IDPool<T, IDPoolPolicy::Stack>
 	{
 	public:
 		T Allocate()
@@ -22,22 +145,176 @@ namespace Strawberry::Core
 			{
 				return mGreatestID++;
 			}
-			else
+
+			T id = mFreeIDs.back();
+			mFreeIDs.pop_back();
+			return id;
+		}
+
+
+		void Free(T id)
+		{
+			Assert(std::cmp_greater_equal(id, 0) && id < mGreatestID, "Freed an ID which was never allocated!");
+			mFreeIDs.emplace_back(id);
+		}
+
+
+	private:
+		T              mGreatestID = 0;
+		std::vector<T> mFreeIDs;
+	};
+
+
+	/// An ID paired with the number of times it had been freed before, so that a handle to a freed ID can be told
+	/// apart from a handle to a newer owner of the same ID.
+	template <std::unsigned_integral T = uint32_t>
+	struct GenerationalID
+	{
+		T index      = std::numeric_limits<T>::max();
+		T generation = 0;
+
+
+		auto operator<=>(const GenerationalID&) const = default;
+	};
+
+
+	/// IDPool which hands out GenerationalIDs.
+	template <std::unsigned_integral T = uint32_t, IDPoolPolicyType Policy = IDPoolPolicy::Lowest>
+	class GenerationalIDPool
+	{
+	public:
+		using ID = GenerationalID<T>;
+
+
+		ID Allocate()
+		{
+			const T index = mIndices.Allocate();
+			if (index >= mGenerations.size())
 			{
-				auto minimum = *std::min_element(mFreeIDs.begin(), mFreeIDs.end());
-				mFreeIDs.erase(minimum);
-				return minimum;
+				mGenerations.resize(index + 1, 0);
 			}
+			return ID{index, mGenerations[index]};
+		}
+
+
+		/// Frees id, which must be alive.
+		void Free(ID id)
+		{
+			Assert(IsAlive(id), "Freed a stale GenerationalID!");
+			mGenerations[id.index]++;
+			mIndices.Free(id.index);
+		}
+
+
+		/// Returns whether id has been allocated and not yet freed.
+		[[nodiscard]] bool IsAlive(ID id) const noexcept
+		{
+			return id.index < mGenerations.size() && mGenerations[id.index] == id.generation;
+		}
+
+
+	private:
+		IDPool<T, Policy> mIndices;
+		/// The current generation of each index. Incremented when the index is freed.
+		std::vector<T>    mGenerations;
+	};
+
+
+	/// Lock free IDPool, for any number of threads allocating and freeing at once.
+	///
+	/// Freed IDs form a Treiber stack, linked through an array indexed by ID, so no memory is allocated per ID once the
+	/// array has grown to hold it. The head of the stack is tagged with a counter, so that an ID which is popped and
+	/// pushed again while another thread is popping cannot corrupt the stack. IDs are reused most recently freed first.
+	template <std::unsigned_integral T = uint32_t> requires (sizeof(T) <= sizeof(uint32_t))
+	class ConcurrentIDPool
+	{
+	public:
+		ConcurrentIDPool() = default;
+		ConcurrentIDPool(const ConcurrentIDPool&) = delete;
+		ConcurrentIDPool& operator=(const ConcurrentIDPool&) = delete;
+
+
+		~ConcurrentIDPool()
+		{
+			for (auto& segment : mSegments)
+			{
+				delete[] segment.load(std::memory_order::relaxed);
+			}
+		}
+
+
+		T Allocate()
+		{
+			uint64_t head = mHead.load(std::memory_order::acquire);
+			while (IndexOf(head) != EMPTY)
+			{
+				// The link may be stale if the ID has been popped since head was read, but then the tag has changed.
+				const T next = Link(IndexOf(head)).load(std::memory_order::relaxed);
+				if (mHead.compare_exchange_weak(head, Pack(next, TagOf(head) + 1), std::memory_order::acquire, std::memory_order::acquire))
+				{
+					return IndexOf(head);
+				}
+			}
+
+			const T id = mGreatestID.fetch_add(1, std::memory_order::relaxed);
+			Assert(id != EMPTY, "ConcurrentIDPool ran out of IDs!");
+			return id;
 		}
 
 
 		void Free(T id)
 		{
-			mFreeIDs.emplace(id);
+			Assert(id < mGreatestID.load(std::memory_order::relaxed), "Freed an ID which was never allocated!");
+
+			std::atomic<T>& link = Link(id);
+			uint64_t head = mHead.load(std::memory_order::relaxed);
+			do
+			{
+				link.store(IndexOf(head), std::memory_order::relaxed);
+			}
+			while (!mHead.compare_exchange_weak(head, Pack(id, TagOf(head) + 1), std::memory_order::release, std::memory_order::relaxed));
 		}
 
+
 	private:
-		T           mGreatestID = 0;
-		std::set<T> mFreeIDs;
+		static constexpr T        EMPTY              = std::numeric_limits<T>::max();
+		/// The number of links in the first segment. Each segment after it is twice the size of the one before.
+		static constexpr size_t   FIRST_SEGMENT_SIZE = 64;
+		static constexpr size_t   SEGMENT_COUNT      = 32;
+
+
+		static constexpr uint64_t Pack(T index, uint32_t tag) noexcept { return (uint64_t(tag) << 32) | index; }
+		static constexpr T        IndexOf(uint64_t head) noexcept { return static_cast<T>(head & std::numeric_limits<T>::max()); }
+		static constexpr uint32_t TagOf(uint64_t head) noexcept { return static_cast<uint32_t>(head >> 32); }
+
+
+		/// Returns the link for id, allocating the segment it is in if nobody has yet.
+		std::atomic<T>& Link(size_t id)
+		{
+			const size_t segment = std::bit_width(id / FIRST_SEGMENT_SIZE + 1) - 1;
+			const size_t offset  = id - FIRST_SEGMENT_SIZE * ((size_t(1) << segment) - 1);
+
+			std::atomic<T>* links = mSegments[segment].load(std::memory_order::acquire);
+			if (!links) [[unlikely]]
+			{
+				auto* created = new std::atomic<T>[FIRST_SEGMENT_SIZE << segment];
+				if (mSegments[segment].compare_exchange_strong(links, created, std::memory_order::acq_rel, std::memory_order::acquire))
+				{
+					links = created;
+				}
+				else
+				{
+					delete[] created;
+				}
+			}
+
+			return links[offset];
+		}
+
+
+		alignas(CACHE_LINE_SIZE) std::atomic<uint64_t>                      mHead       = Pack(EMPTY, 0);
+		alignas(CACHE_LINE_SIZE) std::atomic<T>                             mGreatestID = 0;
+		/// Segments of the array of links, which are never moved once allocated, so that they can be read without locks.
+		std::array<std::atomic<std::atomic<T>*>, SEGMENT_COUNT> mSegments   = {};
 	};
 } // namespace Strawberry::Core
@@ -112,18 +112,13 @@ namespace Strawberry::Core
 		template <typename ShadingFunction>
 		void Shade(ThreadPool& threadPool, ShadingFunction shader)
 		{
-			auto tasks = threadPool.QueueTasks(Size(), [&] (const auto& p) {
+			threadPool.ParallelFor2D(Size(), [&] (const Math::Vec2u& p) {
 				ImageShadingContext context {
 					.position = p,
 				};
 
-				Write(p[0], p[1], std::invoke(shader, context));
-			}).Unwrap();
-
-			for (auto& task : tasks)
-			{
-				task.second.wait();
-			}
+				Write(p, std::invoke(shader, context));
+			});
 		}
 
 
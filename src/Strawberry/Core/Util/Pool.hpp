@@ -0,0 +1,214 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+
+namespace Strawberry::Core
+{
+	/// Memory resource which hands out blocks of a single size.
+	///
+	/// Blocks are carved out of slabs allocated from upstream, which grow geometrically up to a limit. Freed blocks are
+	/// kept on an intrusive free list, so allocating and freeing are a handful of instructions, and the memory is only
+	/// returned upstream when the pool is destroyed. As a memory_resource, requests which do not fit in a block are
+	/// passed upstream, so a pool can back node based containers such as std::pmr::map. Not thread safe.
+	class BlockPool
+		: public std::pmr::memory_resource
+	{
+	public:
+		static constexpr size_t DEFAULT_BLOCKS_PER_SLAB = 64;
+		static constexpr size_t MAXIMUM_SLAB_SIZE       = 1024 * 1024;
+
+
+		BlockPool(size_t blockSize, size_t blockAlignment,
+		          size_t blocksPerSlab = DEFAULT_BLOCKS_PER_SLAB,
+		          std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+			: mBlockAlignment(std::max(blockAlignment, alignof(FreeBlock)))
+			, mBlockSize(NextAligned(std::max(blockSize, sizeof(FreeBlock)), mBlockAlignment))
+			, mNextSlabSize(std::max<size_t>(blocksPerSlab, 1) * mBlockSize)
+			, mUpstream(upstream)
+		{}
+
+
+		~BlockPool() override
+		{
+			while (mSlabs)
+			{
+				Slab* slab = std::exchange(mSlabs, mSlabs->next);
+				mUpstream->deallocate(slab, slab->size, std::max(mBlockAlignment, alignof(Slab)));
+			}
+		}
+
+
+		BlockPool(const BlockPool&) = delete;
+		BlockPool& operator=(const BlockPool&) = delete;
+
+
+		[[nodiscard]] void* Allocate()
+		{
+			if (mFree) [[likely]]
+			{
+				return std::exchange(mFree, mFree->next);
+			}
+
+			if (mCursor == mEnd) [[unlikely]]
+			{
+				AllocateSlab();
+			}
+
+			return std::exchange(mCursor, mCursor + mBlockSize);
+		}
+
+
+		/// Returns a block from Allocate to the pool.
+		void Free(void* block) noexcept
+		{
+			mFree = std::construct_at(static_cast<FreeBlock*>(block), mFree);
+		}
+
+
+		[[nodiscard]] size_t BlockSize() const noexcept
+		{
+			return mBlockSize;
+		}
+
+
+		[[nodiscard]] size_t BlockAlignment() const noexcept
+		{
+			return mBlockAlignment;
+		}
+
+
+		/// Returns the number of bytes held from upstream, whether or not they are in use.
+		[[nodiscard]] size_t Capacity() const noexcept
+		{
+			return mCapacity;
+		}
+
+
+	protected:
+		void* do_allocate(size_t bytes, size_t alignment) override
+		{
+			if (Fits(bytes, alignment)) return Allocate();
+			return mUpstream->allocate(bytes, alignment);
+		}
+
+
+		void do_deallocate(void* pointer, size_t bytes, size_t alignment) override
+		{
+			if (Fits(bytes, alignment)) Free(pointer);
+			else mUpstream->deallocate(pointer, bytes, alignment);
+		}
+
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+
+
+	private:
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+
+		struct Slab
+		{
+			Slab*  next;
+			size_t size;
+		};
+
+
+		static size_t NextAligned(size_t value, size_t alignment) noexcept
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+
+
+		[[nodiscard]] bool Fits(size_t bytes, size_t alignment) const noexcept
+		{
+			return bytes <= mBlockSize && alignment <= mBlockAlignment;
+		}
+
+
+		void AllocateSlab()
+		{
+			// Blocks start after the slab header, at the first multiple of the block alignment.
+			const size_t headerSize = NextAligned(sizeof(Slab), mBlockAlignment);
+			const size_t size       = headerSize + mNextSlabSize;
+			auto*        memory     = static_cast<std::byte*>(mUpstream->allocate(size, std::max(mBlockAlignment, alignof(Slab))));
+
+			mSlabs    = std::construct_at(reinterpret_cast<Slab*>(memory), mSlabs, size);
+			mCursor   = memory + headerSize;
+			mEnd      = mCursor + mNextSlabSize;
+			mCapacity += size;
+
+			if (2 * mNextSlabSize <= MAXIMUM_SLAB_SIZE) mNextSlabSize *= 2;
+		}
+
+
+		const size_t               mBlockAlignment;
+		const size_t               mBlockSize;
+		size_t                     mNextSlabSize;
+		std::pmr::memory_resource* mUpstream;
+		size_t                     mCapacity = 0;
+		Slab*                      mSlabs    = nullptr;
+		FreeBlock*                 mFree     = nullptr;
+		/// The part of the newest slab which has never been handed out.
+		std::byte*                 mCursor   = nullptr;
+		std::byte*                 mEnd      = nullptr;
+	};
+
+
+	/// Fixed size allocator for objects of type T.
+	///
+	/// Unlike Recycler, a pool is an object of its own, which releases all of its memory when it is destroyed, and
+	/// which must only be used by one thread at a time. Objects must be freed to the pool which created them.
+	template <typename T>
+	class Pool
+		: public BlockPool
+	{
+	public:
+		explicit Pool(size_t blocksPerSlab = DEFAULT_BLOCKS_PER_SLAB, std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+			: BlockPool(sizeof(T), alignof(T), blocksPerSlab, upstream)
+		{}
+
+
+		template <typename... Args>
+		[[nodiscard]] T* New(Args&&... args)
+		{
+			void* block = Allocate();
+			try
+			{
+				return std::construct_at(static_cast<T*>(block), std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				Free(block);
+				throw;
+			}
+		}
+
+
+		void Delete(T* object) noexcept
+		{
+			std::destroy_at(object);
+			Free(object);
+		}
+
+
+		/// Returns a pool for the calling thread. Objects from it must be deleted on the same thread.
+		static Pool& ThreadLocal() noexcept
+		{
+			thread_local Pool pool;
+			return pool;
+		}
+	};
+}
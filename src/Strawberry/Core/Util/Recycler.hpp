@@ -0,0 +1,181 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Sync/Spinlock.hpp"
+// Standard Library
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+
+namespace Strawberry::Core
+{
+	/// Allocator for objects of type T which recycles freed memory instead of returning it to the heap.
+	///
+	/// Each thread keeps a small cache of free blocks. When a cache overflows, a batch of blocks is handed to a
+	/// shared list, from which threads with empty caches refill. Memory freed on one thread can therefore be reused
+	/// by another, which suits objects that are created by a producer and destroyed by a consumer.
+	template <typename T>
+	class Recycler
+	{
+	public:
+		/// Constructs a T in recycled memory if there is any, and in freshly allocated memory otherwise.
+		template <typename... Args>
+		static T* New(Args&&... args)
+		{
+			Block* block = Acquire();
+			return std::construct_at(reinterpret_cast<T*>(block->storage), std::forward<Args>(args)...);
+		}
+
+
+		/// Destroys an object returned by New, and keeps its memory for reuse.
+		static void Delete(T* object) noexcept
+		{
+			std::destroy_at(object);
+			Release(reinterpret_cast<Block*>(object));
+		}
+
+
+	private:
+		/// The number of blocks moved between a thread's cache and the shared list at once.
+		static constexpr size_t BATCH_SIZE = 32;
+
+
+		union Block
+		{
+			Block* next;
+			alignas(T) std::byte storage[sizeof(T)];
+		};
+
+
+		/// An intrusive singly linked list of free blocks.
+		struct FreeList
+		{
+			/// Removes up to count blocks from the front of this list and returns them as a new list.
+			FreeList Split(size_t count) noexcept
+			{
+				FreeList result;
+				while (head && result.size < count)
+				{
+					Block* block = std::exchange(head, head->next);
+					size--;
+					result.Push(block);
+				}
+				return result;
+			}
+
+
+			void Push(Block* block) noexcept
+			{
+				block->next = head;
+				head = block;
+				size++;
+			}
+
+
+			Block* Pop() noexcept
+			{
+				size--;
+				return std::exchange(head, head->next);
+			}
+
+
+			void Splice(FreeList&& other) noexcept
+			{
+				while (other.head)
+				{
+					Push(other.Pop());
+				}
+			}
+
+
+			void Free() noexcept
+			{
+				while (head)
+				{
+					delete Pop();
+				}
+			}
+
+
+			Block* head = nullptr;
+			size_t size = 0;
+		};
+
+
+		/// Blocks which have overflowed out of thread caches.
+		struct SharedList
+		{
+			~SharedList() { list.Free(); }
+
+			Spinlock lock;
+			FreeList list;
+		};
+
+
+		/// The calling thread's cache, which is returned to the shared list when the thread exits.
+		struct LocalCache
+		{
+			~LocalCache()
+			{
+				SharedList& shared = GetShared();
+				std::scoped_lock lock(shared.lock);
+				shared.list.Splice(std::move(list));
+			}
+
+			FreeList list;
+		};
+
+
+		static SharedList& GetShared() noexcept
+		{
+			static SharedList shared;
+			return shared;
+		}
+
+
+		static LocalCache& GetLocal() noexcept
+		{
+			thread_local LocalCache cache;
+			return cache;
+		}
+
+
+		static Block* Acquire()
+		{
+			LocalCache& cache = GetLocal();
+
+			if (!cache.list.head) [[unlikely]]
+			{
+				{
+					SharedList& shared = GetShared();
+					std::scoped_lock lock(shared.lock);
+					cache.list = shared.list.Split(BATCH_SIZE);
+				}
+
+				if (!cache.list.head)
+				{
+					return new Block;
+				}
+			}
+
+			return cache.list.Pop();
+		}
+
+
+		static void Release(Block* block) noexcept
+		{
+			LocalCache& cache = GetLocal();
+
+			cache.list.Push(block);
+			if (cache.list.size > 2 * BATCH_SIZE) [[unlikely]]
+			{
+				FreeList batch = cache.list.Split(BATCH_SIZE);
+				SharedList& shared = GetShared();
+				std::scoped_lock lock(shared.lock);
+				shared.list.Splice(std::move(batch));
+			}
+		}
+	};
+}
@@ -0,0 +1,204 @@
+#pragma once
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+#include "Strawberry/Core/Types/Optional.hpp"
+#include "Strawberry/Core/Util/IDPool.hpp"
+// Standard Library
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+
+namespace Strawberry::Core
+{
+	/// Container which keeps its values densely packed in one array, and refers to them by generational handles.
+	///
+	/// A handle names a slot, and each slot records where its value currently is in the packed array. Erasing moves the
+	/// last value into the hole, and updates its slot, so insertion, erasure and lookup are O(1), and iterating visits
+	/// contiguous memory. A slot's generation is bumped whenever it is filled or emptied, so it is odd while the slot is
+	/// in use, and a handle to an erased value never matches the generation of the slot again, even once it is reused.
+	///
+	/// Pointers and references to values are invalidated by insertion and erasure. Handles are not.
+	template <typename T, typename Allocator = std::allocator<T>>
+	class SlotMap
+	{
+	public:
+		using Handle = GenerationalID<uint32_t>;
+
+
+		SlotMap() = default;
+
+
+		explicit SlotMap(const Allocator& allocator)
+			: mValues(allocator)
+			, mSlotOfValue(allocator)
+			, mSlots(allocator)
+		{}
+
+
+		template <typename... Args>
+		Handle Emplace(Args&&... args)
+		{
+			mValues.emplace_back(std::forward<Args>(args)...);
+
+			uint32_t index = mFreeSlot;
+			if (index != NONE)
+			{
+				mFreeSlot = mSlots[index].value;
+			}
+			else
+			{
+				index = static_cast<uint32_t>(mSlots.size());
+				mSlots.emplace_back();
+			}
+
+			Slot& slot = mSlots[index];
+			slot.value = static_cast<uint32_t>(mValues.size() - 1);
+			slot.generation++;
+			mSlotOfValue.emplace_back(index);
+			return Handle{index, slot.generation};
+		}
+
+
+		Handle Insert(T value)
+		{
+			return Emplace(std::move(value));
+		}
+
+
+		/// Removes the value for handle. Returns whether there was one.
+		bool Erase(Handle handle)
+		{
+			if (!Contains(handle)) return false;
+
+			Slot& slot = mSlots[handle.index];
+			const uint32_t last = static_cast<uint32_t>(mValues.size() - 1);
+			if (slot.value != last)
+			{
+				mValues[slot.value]      = std::move(mValues[last]);
+				mSlotOfValue[slot.value] = mSlotOfValue[last];
+				mSlots[mSlotOfValue[slot.value]].value = slot.value;
+			}
+			mValues.pop_back();
+			mSlotOfValue.pop_back();
+
+			slot.generation++;
+			slot.value = std::exchange(mFreeSlot, handle.index);
+			return true;
+		}
+
+
+		[[nodiscard]] bool Contains(Handle handle) const noexcept
+		{
+			return handle.index < mSlots.size() && mSlots[handle.index].generation == handle.generation;
+		}
+
+
+		[[nodiscard]] T* Find(Handle handle) noexcept
+		{
+			return Contains(handle) ? &mValues[mSlots[handle.index].value] : nullptr;
+		}
+
+
+		[[nodiscard]] const T* Find(Handle handle) const noexcept
+		{
+			return Contains(handle) ? &mValues[mSlots[handle.index].value] : nullptr;
+		}
+
+
+		[[nodiscard]] T& operator[](Handle handle) noexcept
+		{
+			Assert(Contains(handle), "Accessed a SlotMap with a stale handle!");
+			return mValues[mSlots[handle.index].value];
+		}
+
+
+		[[nodiscard]] const T& operator[](Handle handle) const noexcept
+		{
+			Assert(Contains(handle), "Accessed a SlotMap with a stale handle!");
+			return mValues[mSlots[handle.index].value];
+		}
+
+
+		/// Returns the handle for the value in slot index, if the slot is in use.
+		[[nodiscard]] Optional<Handle> HandleOf(uint32_t index) const noexcept
+		{
+			if (index < mSlots.size() && mSlots[index].generation % 2 == 1)
+			{
+				return Handle{index, mSlots[index].generation};
+			}
+			return NullOpt;
+		}
+
+
+		/// Returns the handle for the value at position i of the packed array.
+		[[nodiscard]] Handle HandleAt(size_t i) const noexcept
+		{
+			const uint32_t index = mSlotOfValue[i];
+			return Handle{index, mSlots[index].generation};
+		}
+
+
+		[[nodiscard]] size_t Size() const noexcept { return mValues.size(); }
+		[[nodiscard]] bool IsEmpty() const noexcept { return mValues.empty(); }
+
+
+		void Reserve(size_t capacity)
+		{
+			mValues.reserve(capacity);
+			mSlotOfValue.reserve(capacity);
+			mSlots.reserve(capacity);
+		}
+
+
+		/// Erases every value. Every handle becomes stale, but slots are kept for reuse.
+		void Clear()
+		{
+			for (uint32_t index : mSlotOfValue)
+			{
+				mSlots[index].generation++;
+				mSlots[index].value = std::exchange(mFreeSlot, index);
+			}
+			mValues.clear();
+			mSlotOfValue.clear();
+		}
+
+
+		/// The packed values, in no particular order.
+		[[nodiscard]] std::span<T> Values() noexcept { return mValues; }
+		[[nodiscard]] std::span<const T> Values() const noexcept { return mValues; }
+
+
+		auto begin() noexcept { return mValues.begin(); }
+		auto end() noexcept { return mValues.end(); }
+		auto begin() const noexcept { return mValues.begin(); }
+		auto end() const noexcept { return mValues.end(); }
+
+
+	private:
+		template <typename U>
+		using Rebind = std::allocator_traits<Allocator>::template rebind_alloc<U>;
+
+
+		static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+
+		struct Slot
+		{
+			/// The position of this slot's value in the packed array while it is in use, and the next free slot otherwise.
+			uint32_t value      = NONE;
+			uint32_t generation = 0;
+		};
+
+
+		std::vector<T, Rebind<T>>               mValues;
+		/// The slot of each packed value, for updating it when the value moves.
+		std::vector<uint32_t, Rebind<uint32_t>> mSlotOfValue;
+		std::vector<Slot, Rebind<Slot>>         mSlots;
+		/// The most recently freed slot, which heads a list linked through the free slots.
+		uint32_t                                mFreeSlot = NONE;
+	};
+}
@@ -48,5 +48,19 @@ int main()
 	auto intersection2 = aabb.Intersection(aabb3);
 	Assert(!intersection2.HasValue());
 
+
+	// A triangle poking out of the maximum x side is cut where its edges cross it.
+	std::vector<Vector<double, 2>> clipped;
+	aabb.ClipToSide({{5, 2}, {15, 5}, {5, 8}}, clipped, 1);
+	AssertEQ(clipped.size(), 4);
+	AssertEQ(clipped[0], Vector<double, 2>(5, 2));
+	AssertEQ(clipped[1][0], 10.0);
+	AssertEQ(clipped[2][0], 10.0);
+	AssertEQ(clipped[3], Vector<double, 2>(5, 8));
+
+	// Vertices on the side are kept once, without crossings being made at them.
+	aabb.ClipToSide({{5, 2}, {10, 2}, {15, 5}, {10, 8}, {5, 8}}, clipped, 1);
+	AssertEQ(clipped, (std::vector<Vector<double, 2>>{{5, 2}, {10, 2}, {10, 8}, {5, 8}}));
+
 	return 0;
 }
@@ -0,0 +1,147 @@
+#include "Strawberry/Core/Util/Allocator.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+
+
+/// Checks that none of the live segments overlap, and that they all lie within capacity.
+void CheckDisjoint(std::vector<AllocatorSegment> segments, size_t capacity)
+{
+	std::ranges::sort(segments, {}, &AllocatorSegment::position);
+	for (size_t i = 0; i < segments.size(); i++)
+	{
+		Assert(segments[i].End() <= capacity);
+		if (i > 0) Assert(segments[i - 1].End() <= segments[i].position);
+	}
+}
+
+
+/// Allocates and frees random segments until the allocator is empty again, which should leave one free block.
+template <typename Allocator>
+void RandomAllocations(Allocator& allocator, size_t maximumCount, size_t maximumAlignment)
+{
+	std::minstd_rand              random(1);
+	std::vector<AllocatorSegment> live;
+
+	for (int i = 0; i < 10'000; i++)
+	{
+		if (live.empty() || random() % 3 != 0)
+		{
+			const size_t alignment = size_t(1) << (random() % (std::countr_zero(maximumAlignment) + 1));
+			auto segment = allocator.Allocate(AllocationRequest{1 + random() % maximumCount}.WithAlignment(alignment));
+			if (segment)
+			{
+				AssertEQ(segment->position % alignment, 0);
+				live.emplace_back(*segment);
+			}
+		}
+		else
+		{
+			std::swap(live[random() % live.size()], live.back());
+			allocator.Free(AllocatorSegment(live.back()));
+			live.pop_back();
+		}
+
+		AssertEQ(allocator.GetStats().allocationCount, live.size());
+		if (i % 100 == 0) CheckDisjoint(live, allocator.GetStats().capacity);
+	}
+
+	for (auto& segment : live) allocator.Free(std::move(segment));
+
+	auto stats = allocator.GetStats();
+	AssertEQ(stats.allocated, 0);
+	AssertEQ(stats.freeBlockCount, 1);
+	AssertEQ(stats.largestFreeBlock, stats.capacity);
+}
+
+
+void Test_Freelist()
+{
+	FreelistAllocator<RangeAllocatorConfig> allocator(1000);
+
+	// Best fit picks the smallest hole which fits.
+	auto a = allocator.Allocate(AllocationRequest{100});
+	auto b = allocator.Allocate(AllocationRequest{50});
+	auto c = allocator.Allocate(AllocationRequest{200});
+	auto d = allocator.Allocate(AllocationRequest{30});
+	AssertEQ(a->position, 0);
+	AssertEQ(b->position, 100);
+	AssertEQ(c->position, 150);
+	AssertEQ(d->position, 350);
+
+	allocator.Free(std::move(*a));
+	allocator.Free(std::move(*c));
+	auto e = allocator.Allocate(AllocationRequest{80});
+	AssertEQ(e->position, 0);
+
+	// Alignment padding is left free.
+	auto f = allocator.Allocate(AllocationRequest{10}.WithAlignment(64));
+	AssertEQ(f->position, 192);
+	AssertEQ(allocator.GetStats().freeBlockCount, 4);
+
+	// Freeing coalesces with both neighbours.
+	allocator.Free(std::move(*b));
+	allocator.Free(std::move(*e));
+	allocator.Free(std::move(*f));
+	AssertEQ(allocator.GetStats().freeBlockCount, 2);
+	allocator.Free(std::move(*d));
+	AssertEQ(allocator.GetStats().freeBlockCount, 1);
+	AssertEQ(allocator.GetStats().largestFreeBlock, 1000);
+
+	Assert(!allocator.Allocate(AllocationRequest{1001}));
+
+	RandomAllocations(allocator, 50, 16);
+}
+
+
+void Test_Buddy()
+{
+	// Only the power of two prefix is managed.
+	BuddyAllocator<RangeAllocatorConfig> allocator(1100, 16);
+	AssertEQ(allocator.GetStats().capacity, 1024);
+
+	auto a = allocator.Allocate(AllocationRequest{10});
+	auto b = allocator.Allocate(AllocationRequest{100});
+	auto c = allocator.Allocate(AllocationRequest{16});
+	AssertEQ(a->position, 0);
+	AssertEQ(b->position, 128);
+	AssertEQ(c->position, 16);
+
+	auto stats = allocator.GetStats();
+	AssertEQ(stats.allocated, 16 + 128 + 16);
+	AssertEQ(stats.requested, 10 + 100 + 16);
+	AssertEQ(stats.largestFreeBlock, 512);
+	Assert(stats.InternalFragmentation() > 0.0);
+
+	// Alignment rounds the block size up.
+	auto d = allocator.Allocate(AllocationRequest{8}.WithAlignment(256));
+	AssertEQ(d->position, 256);
+
+	Assert(!allocator.Allocate(AllocationRequest{1024}));
+
+	allocator.Free(std::move(*b));
+	allocator.Free(std::move(*a));
+	allocator.Free(std::move(*d));
+	allocator.Free(std::move(*c));
+	AssertEQ(allocator.GetStats().freeBlockCount, 1);
+	AssertEQ(allocator.Allocate(AllocationRequest{1024})->position, 0);
+}
+
+
+void Test_BuddyRandom()
+{
+	BuddyAllocator<RangeAllocatorConfig> allocator(size_t(1) << 16, 8);
+	RandomAllocations(allocator, 300, 64);
+}
+
+
+int main()
+{
+	Test_Freelist();
+	Test_Buddy();
+	Test_BuddyRandom();
+}
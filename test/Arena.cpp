@@ -0,0 +1,140 @@
+#include "Strawberry/Core/Util/Arena.hpp"
+#include "Strawberry/Core/Util/Pool.hpp"
+#include "Strawberry/Core/Math/Graph/Graph.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include <cstdint>
+#include <map>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+
+
+void Test_Arena()
+{
+	Arena arena(1024);
+
+	// Allocations are aligned, and do not overlap.
+	auto* a = static_cast<std::byte*>(arena.Allocate(3, 1));
+	auto* b = static_cast<std::byte*>(arena.Allocate(8, 64));
+	AssertEQ(reinterpret_cast<uintptr_t>(b) % 64, 0);
+	Assert(b >= a + 3);
+
+	// Allocations larger than a chunk get a chunk of their own.
+	auto* big = static_cast<std::byte*>(arena.Allocate(10'000, 16));
+	AssertEQ(reinterpret_cast<uintptr_t>(big) % 16, 0);
+	big[9'999] = std::byte{1};
+
+	auto span = arena.NewArray<int>(100);
+	for (int x : span) AssertEQ(x, 0);
+
+	// Rewinding frees what was allocated since the marker, and the memory is reused.
+	const size_t capacity = arena.Capacity();
+	{
+		Arena::Scope scope(arena);
+		for (int i = 0; i < 1000; i++) [[maybe_unused]] int* x = arena.New<int>(i);
+	}
+	const size_t afterFirstScope = arena.Capacity();
+	Assert(afterFirstScope >= capacity);
+	for (int round = 0; round < 10; round++)
+	{
+		Arena::Scope scope(arena);
+		for (int i = 0; i < 1000; i++) AssertEQ(*arena.New<int>(i), i);
+	}
+	AssertEQ(arena.Capacity(), afterFirstScope);
+
+	// Reset keeps the memory, Release returns it.
+	arena.Reset();
+	AssertEQ(arena.Capacity(), afterFirstScope);
+	arena.Release();
+	AssertEQ(arena.Capacity(), 0);
+}
+
+
+void Test_ArenaResource()
+{
+	Arena arena;
+	std::pmr::vector<int> vector(&arena);
+	std::pmr::map<int, int> map(&arena);
+	for (int i = 0; i < 10'000; i++)
+	{
+		vector.emplace_back(i);
+		map.emplace(i, -i);
+	}
+	AssertEQ(vector[5'000], 5'000);
+	AssertEQ(map.at(5'000), -5'000);
+
+	// Each thread has its own arena.
+	Arena* mainArena = &Arena::ThreadLocal();
+	Arena* otherArena = nullptr;
+	std::thread([&] { otherArena = &Arena::ThreadLocal(); }).join();
+	AssertNEQ(mainArena, otherArena);
+}
+
+
+struct Counted
+{
+	explicit Counted(int value) : value(value) { count++; }
+	~Counted() { count--; }
+
+	int value;
+	inline static int count = 0;
+};
+
+
+void Test_Pool()
+{
+	Pool<Counted> pool(4);
+
+	std::vector<Counted*> objects;
+	for (int i = 0; i < 100; i++) objects.emplace_back(pool.New(i));
+	AssertEQ(Counted::count, 100);
+	for (int i = 0; i < 100; i++) AssertEQ(objects[i]->value, i);
+
+	const size_t capacity = pool.Capacity();
+	for (auto* object : objects) pool.Delete(object);
+	AssertEQ(Counted::count, 0);
+
+	// Freed blocks are reused before any more memory is allocated.
+	for (int i = 0; i < 100; i++) objects[i] = pool.New(i);
+	AssertEQ(pool.Capacity(), capacity);
+	for (auto* object : objects) pool.Delete(object);
+
+	// Nodes of the right size come from the pool, and others are passed upstream.
+	BlockPool nodePool(64, alignof(std::max_align_t));
+	std::pmr::map<int, int> map(&nodePool);
+	for (int i = 0; i < 1000; i++) map.emplace(i, i);
+	map.clear();
+	const size_t nodeCapacity = nodePool.Capacity();
+	for (int i = 0; i < 1000; i++) map.emplace(i, i);
+	AssertEQ(nodePool.Capacity(), nodeCapacity);
+
+	std::pmr::vector<int> vector(1000, 0, &nodePool);
+	AssertEQ(nodePool.Capacity(), nodeCapacity);
+}
+
+
+void Test_GraphAllocator()
+{
+	Arena arena;
+	Math::Graph<int, Math::GraphTypeUndirected, std::pmr::polymorphic_allocator<int>> graph(&arena);
+
+	for (int i = 0; i < 100; i++) graph.AddNode(i);
+	for (unsigned int i = 1; i < 100; i++) graph.AddEdge({i - 1, i});
+
+	Assert(arena.Capacity() > 0);
+	AssertEQ(graph.GetAllocator().resource(), &arena);
+	Assert(graph.IsConnected(10, 11));
+	AssertEQ(graph.GetNeighbours(10), std::set<unsigned int>{9, 11});
+}
+
+
+int main()
+{
+	Test_Arena();
+	Test_ArenaResource();
+	Test_Pool();
+	Test_GraphAllocator();
+}
@@ -0,0 +1,94 @@
+// Strawberry Core
+#include "Strawberry/Core/Math/Graph/CSRGraph.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include <random>
+#include <set>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+using namespace Math;
+
+
+int main()
+{
+	{
+		UndirectedGraph<int> graph;
+		for (int i = 0; i < 5; i++) graph.AddNode(10 * i);
+		graph.AddEdge({0, 1});
+		graph.AddEdge({0, 2});
+		graph.AddEdge({3, 1});
+		graph.AddEdge({3, 4});
+		graph.RemoveNode(2);
+
+		CSRGraph frozen(graph);
+		AssertEQ(frozen.NodeCount(), 4);
+		AssertEQ(frozen.EdgeCount(), 3);
+		AssertEQ(frozen.EdgeCount(), graph.EdgeCount());
+
+		// Node 2 was removed, so the nodes after it are renumbered.
+		AssertEQ(frozen.OriginalID(2), 3);
+		AssertEQ(frozen.FindNode(4).Value(), 3);
+		Assert(!frozen.FindNode(2).HasValue());
+		AssertEQ(frozen.GetValue(3), 40);
+
+		AssertEQ((frozen.GetNeighbours(1) | std::ranges::to<std::vector>()), (std::vector<unsigned int>{0, 2}));
+		AssertEQ(frozen.Degree(2), 2);
+		Assert(frozen.IsConnected(2, 1));
+		Assert(frozen.IsConnected(1, 2));
+		Assert(!frozen.IsConnected(0, 2));
+		Assert(!frozen.GetEdge(0, 3).HasValue());
+
+		unsigned int edges = 0;
+		for (auto edge : frozen.Edges())
+		{
+			Assert(graph.IsConnected(frozen.OriginalID(edge.A()), frozen.OriginalID(edge.B())));
+			edges++;
+		}
+		AssertEQ(edges, 3);
+	}
+
+	{
+		WeightedGraph<DirectedGraph<int>> graph;
+		for (int i = 0; i < 4; i++) graph.AddNode(i);
+		graph.AddEdge({0, 1, 5});
+		graph.AddEdge({0, 3, 7});
+		graph.AddEdge({2, 1, 9});
+
+		CSRGraph frozen(graph);
+		AssertEQ(frozen.EdgeCount(), 3);
+		AssertEQ(frozen.OutDegree(0), 2);
+		AssertEQ(frozen.InDegree(1), 2);
+		AssertEQ(frozen.InDegree(0), 0);
+		AssertEQ((frozen.GetWeights(0) | std::ranges::to<std::vector>()), (std::vector<unsigned int>{5, 7}));
+		AssertEQ((frozen.GetIncomingNeighbours(1) | std::ranges::to<std::vector>()), (std::vector<unsigned int>{0, 2}));
+		Assert(frozen.IsConnected(2, 1));
+		Assert(!frozen.IsConnected(1, 2));
+		AssertEQ(frozen.GetEdge(2, 1)->Weight(), 9);
+	}
+
+	{
+		// Compare against the graph it was frozen from.
+		std::minstd_rand            random(1);
+		DirectedGraph<unsigned int> graph;
+		for (unsigned int i = 0; i < 200; i++) graph.AddNode(i);
+		for (unsigned int i = 0; i < 1'000; i++)
+		{
+			unsigned int a = random() % 200, b = random() % 200;
+			if (a != b) graph.AddEdge({a, b});
+		}
+
+		CSRGraph frozen(graph);
+		AssertEQ(frozen.EdgeCount(), graph.EdgeCount());
+		for (unsigned int node = 0; node < 200; node++)
+		{
+			AssertEQ((frozen.GetNeighbours(node) | std::ranges::to<std::set>()), graph.GetOutgoingNeighbours(node));
+			for (auto neighbour : frozen.GetIncomingNeighbours(node))
+			{
+				Assert(graph.IsConnected(neighbour, node));
+			}
+		}
+	}
+
+	return 0;
+}
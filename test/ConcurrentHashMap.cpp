@@ -0,0 +1,199 @@
+#include "Strawberry/Core/Sync/ConcurrentHashMap.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include <atomic>
+#include <latch>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+
+
+void Test_SingleThreaded()
+{
+	ConcurrentHashMap<std::string, int> map(4);
+	AssertEQ(map.ShardCount(), 4);
+	Assert(map.IsEmpty());
+	Assert(!map.Find("a"));
+
+	Assert(map.Insert("a", 1));
+	Assert(!map.Insert("a", 2));
+	AssertEQ(map.Find("a").Unwrap(), 1);
+
+	Assert(!map.InsertOrAssign("a", 3));
+	Assert(map.InsertOrAssign("b", 4));
+	AssertEQ(map.Find("a").Unwrap(), 3);
+	Assert(map.Update("b", [] (int& value) { value *= 10; }));
+	Assert(!map.Update("c", [] (int& value) { value *= 10; }));
+	AssertEQ(map.Find("b").Unwrap(), 40);
+	AssertEQ(map.Size(), 2);
+
+	Assert(map.Erase("a"));
+	Assert(!map.Erase("a"));
+	Assert(!map.Contains("a"));
+	Assert(map.Contains("b"));
+
+	map.Clear();
+	Assert(map.IsEmpty());
+}
+
+
+void Test_GrowthAndErasure()
+{
+	static constexpr int COUNT = 100'000;
+
+	ConcurrentHashMap<int, int> map;
+	for (int i = 0; i < COUNT; i++)
+	{
+		Assert(map.Insert(i, i * 2));
+	}
+	AssertEQ(map.Size(), COUNT);
+
+	// Erase every other key, so that probes have to pass through deleted slots.
+	for (int i = 0; i < COUNT; i += 2)
+	{
+		Assert(map.Erase(i));
+	}
+	for (int i = 0; i < COUNT; i++)
+	{
+		AssertEQ(map.Contains(i), i % 2 == 1);
+	}
+
+	// Reinserting reuses the deleted slots.
+	for (int i = 0; i < COUNT; i += 2)
+	{
+		Assert(map.Insert(i, i * 2));
+	}
+	for (int i = 0; i < COUNT; i++)
+	{
+		AssertEQ(map.Find(i).Unwrap(), i * 2);
+	}
+}
+
+
+void Test_Concurrent()
+{
+	static constexpr int THREADS = 4;
+	static constexpr int KEYS    = 20'000;
+
+	ConcurrentHashMap<int, int> map;
+
+	// Each thread owns a range of keys, which it inserts, updates and erases while reading the others' keys.
+	std::vector<std::thread> threads;
+	for (int t = 0; t < THREADS; t++)
+	{
+		threads.emplace_back([&, t]
+		{
+			for (int i = t * KEYS; i < (t + 1) * KEYS; i++)
+			{
+				Assert(map.Insert(i, i));
+				if (auto other = map.Find((i + KEYS) % (THREADS * KEYS)))
+				{
+					AssertEQ(other.Unwrap() % KEYS, ((i + KEYS) % (THREADS * KEYS)) % KEYS);
+				}
+			}
+
+			for (int i = t * KEYS; i < (t + 1) * KEYS; i += 2)
+			{
+				Assert(map.Erase(i));
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	AssertEQ(map.Size(), THREADS * KEYS / 2);
+	for (int i = 0; i < THREADS * KEYS; i++)
+	{
+		AssertEQ(map.Contains(i), i % 2 == 1);
+	}
+}
+
+
+void Test_GetOrCompute()
+{
+	static constexpr int THREADS = 8;
+	static constexpr int KEYS    = 1'000;
+
+	ConcurrentHashMap<int, int> map;
+	std::vector<std::atomic<int>> computeCounts(KEYS);
+
+	// Every thread asks for every key, but each key is only computed once.
+	std::latch start(THREADS);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < THREADS; t++)
+	{
+		threads.emplace_back([&]
+		{
+			start.arrive_and_wait();
+			for (int i = 0; i < KEYS; i++)
+			{
+				int value = map.GetOrCompute(i, [&] (int key)
+				{
+					computeCounts[key]++;
+					std::this_thread::yield();
+					return key * key;
+				});
+				AssertEQ(value, i * i);
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	for (int i = 0; i < KEYS; i++)
+	{
+		AssertEQ(computeCounts[i].load(), 1);
+	}
+
+
+	// Computations may use the map themselves.
+	int fib = map.GetOrCompute(-1, [&] (int)
+	{
+		return map.GetOrCompute(-2, [] (int) { return 1; }) + 1;
+	});
+	AssertEQ(fib, 2);
+	AssertEQ(map.Find(-2).Unwrap(), 1);
+
+
+	// Failed computations are not inserted, and are retried.
+	bool caught = false;
+	try
+	{
+		map.GetOrCompute(-3, [] (int) -> int { throw std::runtime_error("failed"); });
+	}
+	catch (const std::runtime_error&)
+	{
+		caught = true;
+	}
+	Assert(caught);
+	Assert(!map.Contains(-3));
+	AssertEQ(map.GetOrCompute(-3, [] (int) { return 3; }), 3);
+
+
+	// A value inserted while computing wins, and is what every caller sees.
+	int raced = map.GetOrCompute(-4, [&] (int)
+	{
+		Assert(map.Insert(-4, 40));
+		return 4;
+	});
+	AssertEQ(raced, 40);
+	AssertEQ(map.Find(-4).Unwrap(), 40);
+}
+
+
+int main()
+{
+	Test_SingleThreaded();
+	Test_GrowthAndErasure();
+	Test_Concurrent();
+	Test_GetOrCompute();
+}
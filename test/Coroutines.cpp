@@ -0,0 +1,134 @@
+#include "Strawberry/Core/Thread/Task.hpp"
+#include "Strawberry/Core/Thread/Timer.hpp"
+#include "Strawberry/Core/Sync/AsyncQueue.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include <stdexcept>
+
+
+using namespace Strawberry::Core;
+
+
+Task<int> Square(int x)
+{
+	co_return x * x;
+}
+
+
+Task<int> SumOfSquares(int n)
+{
+	int sum = 0;
+	for (int i = 0; i < n; i++)
+	{
+		sum += co_await Square(i);
+	}
+	co_return sum;
+}
+
+
+void Test_AwaitTasks()
+{
+	AssertEQ(SyncWait(SumOfSquares(10)), 285);
+}
+
+
+void Test_ThreadHop()
+{
+	ThreadPool pool(4);
+
+	auto hop = [&] () -> Task<std::thread::id>
+	{
+		co_await pool;
+		co_return std::this_thread::get_id();
+	};
+
+	AssertNEQ(SyncWait(hop()), std::this_thread::get_id());
+
+	// Each wait's state is on this stack, which the next wait reuses as soon as the last one returns.
+	for (int i = 0; i < 1000; i++)
+	{
+		AssertNEQ(SyncWait(hop()), std::this_thread::get_id());
+	}
+}
+
+
+void Test_Exceptions()
+{
+	ThreadPool pool(2, ThreadPool::Scheduling::WorkStealing);
+
+	auto failing = [&] () -> Task<>
+	{
+		co_await pool;
+		throw std::runtime_error("coroutine failed");
+	};
+
+	bool caught = false;
+	try
+	{
+		SyncWait(failing());
+	}
+	catch (const std::runtime_error&)
+	{
+		caught = true;
+	}
+	Assert(caught);
+}
+
+
+void Test_Queue()
+{
+	static constexpr int COUNT = 1'000;
+
+	ThreadPool pool(4, ThreadPool::Scheduling::WorkStealing);
+	AsyncQueue<int> queue;
+
+	// The consumer suspends while the queue is empty, and is resumed by the producer's pushes.
+	auto consumer = [&] () -> Task<long long>
+	{
+		co_await pool;
+		long long sum = 0;
+		for (int i = 0; i < COUNT; i++)
+		{
+			sum += co_await queue.Pop();
+		}
+		co_return sum;
+	};
+
+	std::thread producer([&]
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			queue.Push(i);
+		}
+	});
+
+	AssertEQ(SyncWait(consumer()), static_cast<long long>(COUNT) * (COUNT - 1) / 2);
+	producer.join();
+}
+
+
+void Test_Timer()
+{
+	using namespace std::chrono_literals;
+
+	ThreadPool pool(2);
+	Timer timer(pool);
+
+	auto sleeper = [&] (std::chrono::milliseconds duration) -> Task<Timer::Clock::duration>
+	{
+		auto start = Timer::Clock::now();
+		co_await timer.SleepFor(duration);
+		co_return Timer::Clock::now() - start;
+	};
+
+	Assert(SyncWait(sleeper(20ms)) >= 20ms);
+}
+
+
+int main()
+{
+	Test_AwaitTasks();
+	Test_ThreadHop();
+	Test_Exceptions();
+	Test_Queue();
+	Test_Timer();
+}
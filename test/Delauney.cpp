@@ -3,7 +3,10 @@
 #include "Strawberry/Core/Math/Graph/Delauney.hpp"
 #include "Strawberry/Core/Util/Image.hpp"
 #include "canvas_ity.hpp"
+#include <algorithm>
 #include <random>
+#include <set>
+#include <vector>
 
 
 using namespace Strawberry::Core;
@@ -24,6 +27,161 @@ struct GraphColoring
 	float mNodeColor[4];
 };
 
+using Triangulation = Delaunay<Vector<double, 2>>;
+
+
+static std::vector<Vector<double, 2>> RandomPoints(unsigned int count, unsigned int seed)
+{
+	std::mt19937                           random(seed);
+	std::uniform_real_distribution<double> distribution(0.0, 1000.0);
+
+	std::vector<Vector<double, 2>> points;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		points.emplace_back(distribution(random), distribution(random));
+	}
+	return points;
+}
+
+
+static std::vector<Vector<double, 2>> GridPoints(unsigned int size)
+{
+	std::vector<Vector<double, 2>> points;
+	for (unsigned int y = 0; y < size; y++)
+	{
+		for (unsigned int x = 0; x < size; x++)
+		{
+			points.emplace_back(50.0 + 60.0 * x, 50.0 + 60.0 * y);
+		}
+	}
+	return points;
+}
+
+
+/// Returns the number of points on the boundary of their convex hull, including those in the middle of its edges.
+static size_t HullPointCount(const std::vector<Vector<double, 2>>& points)
+{
+	std::vector<Vector<double, 2>> sorted = points;
+	std::ranges::sort(sorted, [] (const auto& a, const auto& b) { return std::pair(a[0], a[1]) < std::pair(b[0], b[1]); });
+
+	// Andrew's monotone chain, keeping only the corners.
+	std::vector<Vector<double, 2>> hull;
+	for (int pass = 0; pass < 2; pass++)
+	{
+		const size_t start = hull.size();
+		for (const auto& point : sorted)
+		{
+			while (hull.size() >= start + 2 && Orient2D(hull[hull.size() - 2], hull.back(), point) <= 0) hull.pop_back();
+			hull.emplace_back(point);
+		}
+		hull.pop_back();
+		std::ranges::reverse(sorted);
+	}
+
+	return std::ranges::count_if(points, [&] (const Vector<double, 2>& point)
+	{
+		for (size_t i = 0; i < hull.size(); i++)
+		{
+			const auto& a = hull[i];
+			const auto& b = hull[(i + 1) % hull.size()];
+			if (Orient2D(a, b, point) == 0 && (point - a).Dot(point - b) <= 0) return true;
+		}
+		return false;
+	});
+}
+
+
+/// Checks that delaunay is a Delaunay triangulation of points. No point may lie inside the circumcircle of a face, and
+/// the faces must cover the convex hull of the points, so that there are 2n - h - 2 of them, for n points of which h
+/// are on the boundary of the hull.
+static void CheckTriangulation(const std::vector<Vector<double, 2>>& points, const Triangulation& delaunay)
+{
+	const auto& graph = delaunay.GetGraph();
+	for (const auto& face : delaunay.Faces())
+	{
+		Vector<double, 2> a = graph.GetValue(face.Node(0)), b = graph.GetValue(face.Node(1)), c = graph.GetValue(face.Node(2));
+		if (Orient2D(a, b, c) < 0) std::swap(b, c);
+		for (const auto& point : points)
+		{
+			Assert(!(InCircle(a, b, c, point) > 0), "A point lies inside the circumcircle of a face!");
+		}
+	}
+
+	AssertEQ(delaunay.FaceCount(), 2 * points.size() - HullPointCount(points) - 2);
+}
+
+
+void Test_RandomPoints()
+{
+	for (unsigned int seed = 0; seed < 8; seed++)
+	{
+		const auto points = RandomPoints(256, seed);
+		CheckTriangulation(points, Triangulation::Builder(BOUNDS).WithNodes(points).Build());
+	}
+}
+
+
+void Test_GridPoints()
+{
+	// Every square of the grid is cocircular, so its diagonal is chosen by the IDs of its corners.
+	const auto points = GridPoints(16);
+	CheckTriangulation(points, Triangulation::Builder(BOUNDS).WithNodes(points).Build());
+}
+
+
+void Test_BruteForce()
+{
+	// In general position, the faces are exactly the triangles whose circumcircles hold no other point.
+	for (unsigned int seed = 0; seed < 8; seed++)
+	{
+		const auto points = RandomPoints(20, seed);
+
+		std::set<Triangulation::Face> expected;
+		for (unsigned int i = 0; i < points.size(); i++)
+		{
+			for (unsigned int j = i + 1; j < points.size(); j++)
+			{
+				for (unsigned int k = j + 1; k < points.size(); k++)
+				{
+					const double orientation = Orient2D(points[i], points[j], points[k]);
+					const auto& b = orientation > 0 ? points[j] : points[k];
+					const auto& c = orientation > 0 ? points[k] : points[j];
+					if (std::ranges::none_of(points, [&] (const auto& point) { return InCircle(points[i], b, c, point) > 0; }))
+					{
+						// Nodes are numbered after the three supporting nodes.
+						expected.emplace(i + 3, j + 3, k + 3);
+					}
+				}
+			}
+		}
+
+		const auto delaunay = Triangulation::Builder(BOUNDS).WithNodes(points).Build();
+		CheckTriangulation(points, delaunay);
+		Assert(delaunay.Faces() == expected);
+	}
+}
+
+
+void Test_BuildParallelGrid()
+{
+	// Cocircular points along the seams between strips must be triangulated the way Build does it, whatever the order
+	// the points were added in.
+	auto points = GridPoints(16);
+	std::ranges::shuffle(points, std::mt19937(7));
+
+	const auto builder  = Triangulation::Builder(BOUNDS).WithNodes(points);
+	const auto delaunay = builder.Build();
+	CheckTriangulation(points, delaunay);
+
+	ThreadPool pool;
+	for (unsigned int partitionCount : {1, 2, 3, 8})
+	{
+		const auto parallel = builder.BuildParallel(pool, partitionCount);
+		Assert(parallel.Faces() == delaunay.Faces());
+	}
+}
+
+
 static PointSet<double, 2> GeneratePointSet()
 {
 	static size_t POINT_COUNT = 128;
@@ -69,6 +227,11 @@ static void DrawGraph(canvas_ity::canvas& canvas, const auto& graph, GraphColori
 
 int main()
 {
+	Test_RandomPoints();
+	Test_GridPoints();
+	Test_BruteForce();
+	Test_BuildParallelGrid();
+
 	GraphColoring mainColoring { .mEdgeColor{1.0f, 1.0f, 1.0f, 1.0f}, .mNodeColor{1.0f, 0.0f, 0.0f, 1.0f} };
 
 	PointSet<double, 2> pointSet = GeneratePointSet();
@@ -80,6 +243,16 @@ int main()
 	}
 
 	auto delaunay = builder.Build();
+
+	// Triangulating in strips gives the same triangulation, for any number of strips.
+	ThreadPool pool;
+	for (unsigned int partitionCount : {1, 2, 3, 8})
+	{
+		auto parallel = builder.BuildParallel(pool, partitionCount);
+		Assert(parallel.Faces() == delaunay.Faces());
+		Assert(parallel.GetGraph().Edges() == delaunay.GetGraph().Edges());
+	}
+
 	auto span = MAX - MIN;
 
 	canvas_ity::canvas context(span[0], span[1]);
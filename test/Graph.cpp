@@ -1,6 +1,8 @@
 // Strawberry Core
 #include "Strawberry/Core/Math/Graph/Graph.hpp"
 #include "Strawberry/Core/Assert.hpp"
+#include <stdexcept>
+#include <vector>
 
 
 using namespace Strawberry::Core;
@@ -39,6 +41,27 @@ int main()
 		Assert(graphA.IsConnected(2, 3));
 
 		graphA.RemoveNode(0);
+		Assert(!graphA.ContainsNode(0));
+		AssertEQ(graphA.GetNeighbours(1), std::set<unsigned int>{2, 3});
+		AssertEQ(graphA.GetNeighbours(2), std::set<unsigned int>{1, 3});
+		AssertEQ(graphA.EdgeCount(), 3);
+	}
+
+
+	{
+		// Adding edges together gives the same graph as adding them one at a time, including to existing edges.
+		UndirectedGraph<int> graphC;
+		for (int i = 0; i < 5; i++) graphC.AddNode(i);
+		graphC.AddEdge({4, 0});
+
+		std::vector<UndirectedGraph<int>::Edge> edges{{3, 1}, {0, 1}, {1, 2}, {4, 3}, {0, 1}};
+		graphC.AddEdges(edges);
+
+		AssertEQ(graphC.EdgeCount(), 5);
+		AssertEQ(graphC.GetNeighbours(0), std::set<unsigned int>{1, 4});
+		AssertEQ(graphC.GetNeighbours(1), std::set<unsigned int>{0, 2, 3});
+		AssertEQ(graphC.GetNeighbours(3), std::set<unsigned int>{1, 4});
+		AssertEQ(graphC.GetNeighbours(4), std::set<unsigned int>{0, 3});
 	}
 
 
@@ -72,5 +95,40 @@ int main()
 		AssertEQ(weightedGraph.GetEdge(0, 1).Weight(), 5);
 	}
 
+	{
+		DenseGraph<UndirectedGraph<int>> denseGraph;
+		auto a = denseGraph.AddNode(10);
+		auto b = denseGraph.AddNode(11);
+		auto c = denseGraph.AddNode(12);
+		denseGraph.AddEdge({a, b});
+		denseGraph.AddEdge({b, c});
+
+		denseGraph.RemoveNode(a);
+		AssertEQ(denseGraph.NodeCount(), 2);
+		AssertEQ(denseGraph.GetValue(c), 12);
+		Assert(denseGraph.ContainsValue(11));
+		Assert(!denseGraph.ContainsValue(10));
+
+		// The ID of the removed node is reused.
+		AssertEQ(denseGraph.AddNode(13), a);
+		AssertEQ(denseGraph.GetValue(a), 13);
+		Assert(!denseGraph.IsConnected(a, b));
+		Assert(denseGraph.IsConnected(b, c));
+
+		for (auto [id, value] : denseGraph.Nodes()) AssertEQ(value, denseGraph.GetValue(id));
+
+		// Missing nodes throw, as they do without dense storage.
+		bool caught = false;
+		try
+		{
+			denseGraph.GetValue(100);
+		}
+		catch (const std::out_of_range&)
+		{
+			caught = true;
+		}
+		Assert(caught);
+	}
+
 	return 0;
 }
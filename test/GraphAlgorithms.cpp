@@ -0,0 +1,212 @@
+// Strawberry Core
+#include "Strawberry/Core/Math/Graph/Algorithms.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include <cmath>
+#include <random>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+using namespace Math;
+
+
+using WeightedUndirected = WeightedGraph<UndirectedGraph<int>>;
+
+
+WeightedUndirected RandomGraph(unsigned int nodeCount, unsigned int edgeCount, unsigned int seed)
+{
+	std::minstd_rand   random(seed);
+	WeightedUndirected graph;
+	for (unsigned int i = 0; i < nodeCount; i++) graph.AddNode(static_cast<int>(i));
+	for (unsigned int i = 0; i < edgeCount; i++)
+	{
+		unsigned int a = random() % nodeCount, b = random() % nodeCount;
+		if (a != b) graph.AddEdge({a, b, 1 + static_cast<unsigned int>(random() % 20)});
+	}
+	return graph;
+}
+
+
+/// Shortest distances by Bellman-Ford, to check the searches against.
+std::vector<double> BellmanFord(const WeightedUndirected& graph, unsigned int source)
+{
+	std::vector<double> distances(graph.NodeCount(), INFINITY);
+	distances[source] = 0.0;
+	for (unsigned int i = 0; i < graph.NodeCount(); i++)
+	{
+		for (auto edge : graph.Edges())
+		{
+			distances[edge.B()] = std::min(distances[edge.B()], distances[edge.A()] + edge.Weight());
+			distances[edge.A()] = std::min(distances[edge.A()], distances[edge.B()] + edge.Weight());
+		}
+	}
+	return distances;
+}
+
+
+void Test_BreadthFirst()
+{
+	UndirectedGraph<int> graph;
+	for (int i = 0; i < 6; i++) graph.AddNode(i);
+	graph.AddEdge({0, 1});
+	graph.AddEdge({1, 2});
+	graph.AddEdge({0, 3});
+	graph.AddEdge({3, 2});
+	graph.AddEdge({4, 5});
+
+	GraphWorkspace<> workspace;
+	auto order = BreadthFirst(graph, 0u, workspace);
+	AssertEQ(order.size(), 4);
+	AssertEQ(order[0], 0);
+	AssertEQ(workspace.GetDistance(2), 2);
+	Assert(!workspace.IsReached(4));
+	Assert(!workspace.GetParent(0).HasValue());
+	AssertEQ(workspace.GetPath(2).size(), 3);
+
+	// Reusing the workspace forgets the last search.
+	BreadthFirst(graph, 4u, workspace);
+	Assert(!workspace.IsReached(0));
+	AssertEQ(workspace.GetPath(5), (std::vector<unsigned int>{4, 5}));
+}
+
+
+void Test_Dijkstra()
+{
+	auto graph  = RandomGraph(200, 600, 1);
+	auto frozen = CSRGraph(graph);
+
+	GraphWorkspace<> workspace;
+	for (unsigned int source : {0u, 17u, 199u})
+	{
+		auto expected = BellmanFord(graph, source);
+
+		Dijkstra(graph, source, workspace);
+		for (unsigned int node = 0; node < 200; node++)
+		{
+			AssertEQ(workspace.IsReached(node), expected[node] != INFINITY);
+			if (workspace.IsReached(node)) AssertEQ(workspace.GetDistance(node), expected[node]);
+		}
+
+		Dijkstra(frozen, source, workspace);
+		for (unsigned int node = 0; node < 200; node++)
+		{
+			if (workspace.IsReached(node)) AssertEQ(workspace.GetDistance(node), expected[node]);
+		}
+
+		// The path is made of edges whose weights add up to the distance.
+		auto path = workspace.GetPath(150);
+		double length = 0.0;
+		for (size_t i = 1; i < path.size(); i++) length += graph.GetEdge(path[i - 1], path[i]).Weight();
+		if (!path.empty()) AssertEQ(length, expected[150]);
+	}
+}
+
+
+void Test_AStar()
+{
+	// A grid with a wall down the middle, which has a gap at the top.
+	constexpr unsigned int SIZE = 20;
+	auto isWall = [] (unsigned int x, unsigned int y) { return x == SIZE / 2 && y < SIZE - 1; };
+
+	UndirectedVectorGraph<Vector<double, 2>> graph;
+	for (unsigned int y = 0; y < SIZE; y++)
+	{
+		for (unsigned int x = 0; x < SIZE; x++) graph.AddNode(Vector<double, 2>(double(x), double(y)));
+	}
+	for (unsigned int y = 0; y < SIZE; y++)
+	{
+		for (unsigned int x = 0; x < SIZE; x++)
+		{
+			if (isWall(x, y)) continue;
+			if (x + 1 < SIZE && !isWall(x + 1, y)) graph.AddEdge({y * SIZE + x, y * SIZE + x + 1});
+			if (y + 1 < SIZE && !isWall(x, y + 1)) graph.AddEdge({y * SIZE + x, (y + 1) * SIZE + x});
+		}
+	}
+
+	const unsigned int source = 0, target = SIZE - 1;
+	GraphWorkspace<> workspace;
+	Dijkstra(graph, source, workspace, EuclideanCost(graph));
+	const double expected = workspace.GetDistance(target);
+	const size_t dijkstraSettled = workspace.Order().size();
+
+	Assert(AStar(graph, source, target, EuclideanHeuristic(graph, target), workspace, EuclideanCost(graph)));
+	AssertEQ(workspace.GetDistance(target), expected);
+	AssertEQ(workspace.GetPath(target).front(), source);
+	AssertEQ(workspace.GetPath(target).back(), target);
+	Assert(workspace.Order().size() <= dijkstraSettled);
+
+	// Unreachable targets are reported.
+	graph.AddNode(Vector<double, 2>(-5, -5));
+	Assert(!AStar(graph, source, SIZE * SIZE, EuclideanHeuristic(graph, SIZE * SIZE), workspace, EuclideanCost(graph)));
+}
+
+
+void Test_ConnectedComponents()
+{
+	UndirectedGraph<int> graph;
+	for (int i = 0; i < 7; i++) graph.AddNode(i);
+	graph.AddEdge({0, 4});
+	graph.AddEdge({4, 2});
+	graph.AddEdge({1, 5});
+	graph.RemoveNode(3);
+
+	GraphWorkspace<>          workspace;
+	std::vector<unsigned int> labels;
+	AssertEQ(ConnectedComponents(graph, workspace, labels), 3);
+	AssertEQ(labels, (std::vector<unsigned int>{0, 1, 0, workspace.NONE, 0, 1, 2}));
+
+	DirectedGraph<int> directed;
+	for (int i = 0; i < 3; i++) directed.AddNode(i);
+	directed.AddEdge({2, 0});
+	AssertEQ(ConnectedComponents(directed, workspace, labels), 2);
+	AssertEQ(labels, (std::vector<unsigned int>{0, 1, 0}));
+}
+
+
+void Test_MinimumSpanningTree()
+{
+	auto graph = RandomGraph(100, 400, 2);
+
+	// Prim's algorithm, in O(n^2), for comparison.
+	std::vector<double>       distance(100, INFINITY);
+	std::vector<bool>         inTree(100, false);
+	GraphWorkspace<>          workspace;
+	std::vector<unsigned int> labels;
+	AssertEQ(ConnectedComponents(graph, workspace, labels), 1);
+	double expected = 0.0;
+	distance[0] = 0.0;
+	for (unsigned int i = 0; i < 100; i++)
+	{
+		unsigned int next = 0;
+		while (inTree[next]) next++;
+		for (unsigned int node = 0; node < 100; node++)
+		{
+			if (!inTree[node] && distance[node] < distance[next]) next = node;
+		}
+		inTree[next] = true;
+		expected += distance[next];
+		for (auto neighbour : graph.Neighbours(next))
+		{
+			distance[neighbour] = std::min<double>(distance[neighbour], graph.GetEdge(next, neighbour).Weight());
+		}
+	}
+
+	for (auto tree : {MinimumSpanningTree(graph, workspace), MinimumSpanningTree(CSRGraph(graph), workspace)})
+	{
+		AssertEQ(tree.size(), 99);
+		double total = 0.0;
+		for (auto edge : tree) total += edge.Weight();
+		AssertEQ(total, expected);
+	}
+}
+
+
+int main()
+{
+	Test_BreadthFirst();
+	Test_Dijkstra();
+	Test_AStar();
+	Test_ConnectedComponents();
+	Test_MinimumSpanningTree();
+	return 0;
+}
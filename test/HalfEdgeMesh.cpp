@@ -0,0 +1,147 @@
+// Strawberry Core
+#include "Strawberry/Core/Math/Graph/HalfEdgeMesh.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include <array>
+#include <set>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+using namespace Math;
+
+
+using Mesh = HalfEdgeMesh<int>;
+
+
+/// A grid of size by size squares, each split into two triangles.
+Mesh Grid(unsigned int size)
+{
+	auto vertex = [size] (unsigned int x, unsigned int y) { return y * (size + 1) + x; };
+
+	std::vector<std::array<unsigned int, 3>> faces;
+	for (unsigned int y = 0; y < size; y++)
+	{
+		for (unsigned int x = 0; x < size; x++)
+		{
+			faces.push_back({vertex(x, y), vertex(x + 1, y), vertex(x + 1, y + 1)});
+			faces.push_back({vertex(x, y), vertex(x + 1, y + 1), vertex(x, y + 1)});
+		}
+	}
+	return Mesh(std::vector<int>((size + 1) * (size + 1), 0), faces);
+}
+
+
+/// Checks the links which every mesh must satisfy.
+void CheckInvariants(const Mesh& mesh)
+{
+	for (unsigned int halfEdge = 0; halfEdge < mesh.HalfEdgeCount(); halfEdge++)
+	{
+		AssertNEQ(mesh.Twin(halfEdge), halfEdge);
+		AssertEQ(mesh.Twin(mesh.Twin(halfEdge)), halfEdge);
+		AssertEQ(mesh.Prev(mesh.Next(halfEdge)), halfEdge);
+		AssertEQ(mesh.Origin(mesh.Next(halfEdge)), mesh.Target(halfEdge));
+		AssertEQ(mesh.Face(mesh.Next(halfEdge)), mesh.Face(halfEdge));
+		Assert(!mesh.IsBoundary(halfEdge) || !mesh.IsBoundary(mesh.Twin(halfEdge)));
+	}
+
+	for (unsigned int face = 0; face < mesh.FaceCount(); face++)
+	{
+		mesh.ForEachFaceHalfEdge(face, [&] (unsigned int halfEdge) { AssertEQ(mesh.Face(halfEdge), face); });
+	}
+}
+
+
+void Test_Grid()
+{
+	constexpr unsigned int SIZE = 8;
+	Mesh mesh = Grid(SIZE);
+	CheckInvariants(mesh);
+
+	AssertEQ(mesh.VertexCount(), (SIZE + 1) * (SIZE + 1));
+	AssertEQ(mesh.FaceCount(), 2 * SIZE * SIZE);
+	// Euler's formula, counting the outside as a face.
+	AssertEQ(mesh.VertexCount() - mesh.EdgeCount() + mesh.FaceCount() + 1, 2);
+	AssertEQ(std::ranges::distance(mesh.BoundaryHalfEdges()), 4 * SIZE);
+
+	// The boundary is a single loop.
+	unsigned int first = *mesh.BoundaryHalfEdges().begin();
+	unsigned int length = 0;
+	for (unsigned int halfEdge = first; length == 0 || halfEdge != first; halfEdge = mesh.Next(halfEdge))
+	{
+		Assert(mesh.IsBoundary(halfEdge));
+		length++;
+	}
+	AssertEQ(length, 4 * SIZE);
+
+	// An interior vertex has 6 neighbours, and a corner has 2 or 3.
+	auto neighbours = [&] (unsigned int vertex)
+	{
+		std::set<unsigned int> result;
+		mesh.ForEachNeighbour(vertex, [&] (unsigned int neighbour) { Assert(result.emplace(neighbour).second); });
+		return result;
+	};
+	AssertEQ(neighbours(SIZE + 2), (std::set<unsigned int>{0, 1, SIZE + 1, SIZE + 3, 2 * SIZE + 3, 2 * SIZE + 4}));
+	AssertEQ(neighbours(0), (std::set<unsigned int>{1, SIZE + 1, SIZE + 2}));
+	AssertEQ(neighbours(SIZE), (std::set<unsigned int>{SIZE - 1, 2 * SIZE + 1}));
+
+	// Adjacency agrees with the half edges found between vertices.
+	auto halfEdge = mesh.FindHalfEdge(0, SIZE + 2);
+	Assert(halfEdge.HasValue());
+	AssertEQ(mesh.Target(*halfEdge), SIZE + 2);
+	Assert(!mesh.IsBoundaryEdge(*halfEdge));
+	Assert(!mesh.FindHalfEdge(0, 2).HasValue());
+	Assert(mesh.IsBoundaryEdge(mesh.FindHalfEdge(0, 1).Unwrap()));
+
+	unsigned int adjacent = 0;
+	mesh.ForEachAdjacentFace(mesh.Face(*halfEdge), [&] (unsigned int face)
+	{
+		AssertNEQ(face, mesh.Face(*halfEdge));
+		adjacent++;
+	});
+	AssertEQ(adjacent, 2);
+}
+
+
+void Test_Pinch()
+{
+	// Two triangles which only meet at vertex 2.
+	std::vector<std::array<unsigned int, 3>> faces{{0, 1, 2}, {2, 3, 4}};
+	Mesh mesh(std::vector<int>(5, 0), faces);
+	CheckInvariants(mesh);
+
+	// The boundary is walked one triangle at a time.
+	for (unsigned int halfEdge : mesh.BoundaryHalfEdges())
+	{
+		AssertEQ(mesh.Next(mesh.Next(mesh.Next(halfEdge))), halfEdge);
+	}
+
+	unsigned int count = 0;
+	mesh.ForEachNeighbour(2, [&] (unsigned int) { count++; });
+	AssertEQ(count, 2);
+}
+
+
+void Test_Polygons()
+{
+	// A triangle and a quad, and a vertex which has no edges.
+	std::vector<std::vector<unsigned int>> faces{{0, 1, 2}, {0, 2, 3, 4}};
+	Mesh mesh(std::vector<int>{10, 11, 12, 13, 14, 15}, faces);
+	CheckInvariants(mesh);
+
+	AssertEQ(mesh.EdgeCount(), 6);
+	AssertEQ(mesh.VertexHalfEdge(5), Mesh::NONE);
+	AssertEQ(mesh.GetValue(3), 13);
+
+	std::vector<unsigned int> vertices;
+	mesh.ForEachFaceVertex(1, [&] (unsigned int vertex) { vertices.emplace_back(vertex); });
+	AssertEQ(vertices, (std::vector<unsigned int>{0, 2, 3, 4}));
+}
+
+
+int main()
+{
+	Test_Grid();
+	Test_Pinch();
+	Test_Polygons();
+	return 0;
+}
@@ -0,0 +1,149 @@
+#include "Strawberry/Core/Util/IDPool.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include <algorithm>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+
+
+void Test_Lowest()
+{
+	IDPool<unsigned int> pool;
+	for (unsigned int i = 0; i < 10'000; i++) AssertEQ(pool.Allocate(), i);
+
+	pool.Free(7'000);
+	pool.Free(3);
+	pool.Free(4'095);
+	AssertEQ(pool.Allocate(), 3);
+	AssertEQ(pool.Allocate(), 4'095);
+	AssertEQ(pool.Allocate(), 7'000);
+	AssertEQ(pool.Allocate(), 10'000);
+
+	// Compare against a sorted set of free IDs.
+	std::minstd_rand        random(1);
+	std::set<unsigned int>  free;
+	std::vector<unsigned int> live;
+	for (unsigned int i = 0; i <= 10'000; i++) live.emplace_back(i);
+	for (int i = 0; i < 100'000; i++)
+	{
+		if (random() % 2 == 0 && !live.empty())
+		{
+			std::swap(live[random() % live.size()], live.back());
+			pool.Free(live.back());
+			free.emplace(live.back());
+			live.pop_back();
+		}
+		else
+		{
+			const unsigned int id = pool.Allocate();
+			if (!free.empty())
+			{
+				AssertEQ(id, *free.begin());
+				free.erase(free.begin());
+			}
+			live.emplace_back(id);
+		}
+	}
+}
+
+
+void Test_Stack()
+{
+	IDPool<int, IDPoolPolicy::Stack> pool;
+	for (int i = 0; i < 10; i++) AssertEQ(pool.Allocate(), i);
+	pool.Free(2);
+	pool.Free(8);
+	AssertEQ(pool.Allocate(), 8);
+	AssertEQ(pool.Allocate(), 2);
+	AssertEQ(pool.Allocate(), 10);
+}
+
+
+void Test_Generational()
+{
+	GenerationalIDPool<> pool;
+	auto a = pool.Allocate();
+	auto b = pool.Allocate();
+	Assert(pool.IsAlive(a));
+	Assert(pool.IsAlive(b));
+
+	pool.Free(a);
+	Assert(!pool.IsAlive(a));
+
+	// The index is reused, but the old handle stays stale.
+	auto c = pool.Allocate();
+	AssertEQ(c.index, a.index);
+	AssertNEQ(c, a);
+	Assert(pool.IsAlive(c));
+	Assert(!pool.IsAlive(a));
+	Assert(!pool.IsAlive(GenerationalID<>{}));
+}
+
+
+void Test_Concurrent()
+{
+	static constexpr unsigned int THREADS    = 4;
+	static constexpr unsigned int OPERATIONS = 100'000;
+	static constexpr unsigned int HELD       = 16;
+
+	ConcurrentIDPool<> pool;
+	// Every ID is owned by at most one thread at a time. An ID which is being freed is neither held nor free, so each
+	// thread may cause one more ID than it holds to be created.
+	std::vector<std::atomic_bool> owned(THREADS * (HELD + 1));
+
+	std::vector<std::thread> threads;
+	for (unsigned int t = 0; t < THREADS; t++)
+	{
+		threads.emplace_back([&, t]
+		{
+			std::minstd_rand     random(t);
+			std::vector<uint32_t> held;
+			for (unsigned int i = 0; i < OPERATIONS; i++)
+			{
+				if (held.size() < HELD && (held.empty() || random() % 2 == 0))
+				{
+					const uint32_t id = pool.Allocate();
+					Assert(id < owned.size());
+					Assert(!owned[id].exchange(true));
+					held.emplace_back(id);
+				}
+				else
+				{
+					owned[held.back()].store(false);
+					pool.Free(held.back());
+					held.pop_back();
+				}
+			}
+			for (uint32_t id : held)
+			{
+				owned[id].store(false);
+				pool.Free(id);
+			}
+		});
+	}
+	for (auto& thread : threads) thread.join();
+
+	// Every ID is free again, so reallocating them all needs no new ones.
+	std::set<uint32_t> ids;
+	uint32_t greatest = 0;
+	for (unsigned int i = 0; i < THREADS * HELD; i++)
+	{
+		const uint32_t id = pool.Allocate();
+		Assert(ids.emplace(id).second);
+		greatest = std::max(greatest, id);
+	}
+	Assert(greatest < owned.size());
+}
+
+
+int main()
+{
+	Test_Lowest();
+	Test_Stack();
+	Test_Generational();
+	Test_Concurrent();
+}
@@ -0,0 +1,106 @@
+#include "Strawberry/Core/Math/Geometry/LineSegment.hpp"
+#include "Strawberry/Core/Assert.hpp"
+
+
+using namespace Strawberry::Core;
+using namespace Math;
+
+
+using Segment = LineSegment<double, 2>;
+
+
+void Test_Crossing()
+{
+	auto crossing = Segment({0.0, 0.0}, {2.0, 2.0}).Intersection(Segment({0.0, 2.0}, {2.0, 0.0}));
+	Assert(crossing.HasValue());
+	AssertEQ(crossing->position, Vector{1.0, 1.0});
+	AssertEQ(crossing->segmentDistance[0], 0.5);
+	AssertEQ(crossing->segmentDistance[1], 0.5);
+
+	// Segments which would cross if they were longer.
+	Assert(!Segment({0.0, 0.0}, {1.0, 1.0}).Intersection(Segment({0.0, 4.0}, {4.0, 0.0})).HasValue());
+	Assert(!Segment({0.0, 0.0}, {2.0, 2.0}).Intersection(Segment({3.0, 0.0}, {3.0, 4.0})).HasValue());
+}
+
+
+void Test_Touching()
+{
+	const Segment b({1.0, 0.0}, {1.0, 2.0});
+
+	// The first segment counts from its start to its end.
+	auto atEnd = Segment({0.0, 0.0}, {1.0, 1.0}).Intersection(b);
+	Assert(atEnd.HasValue());
+	AssertEQ(atEnd->position, Vector{1.0, 1.0});
+	AssertEQ(atEnd->segmentDistance[0], 1.0);
+
+	auto atStart = Segment({1.0, 1.0}, {2.0, 2.0}).Intersection(b);
+	Assert(atStart.HasValue());
+	AssertEQ(atStart->position, Vector{1.0, 1.0});
+	AssertEQ(atStart->segmentDistance[0], 0.0);
+
+	// The second counts from its start, but not its end, so a path of segments crosses a line through a joint once.
+	const Segment a({0.0, 0.0}, {2.0, 0.0});
+	auto atSecondStart = a.Intersection(Segment({1.0, 0.0}, {1.0, 1.0}));
+	Assert(atSecondStart.HasValue());
+	AssertEQ(atSecondStart->position, Vector{1.0, 0.0});
+	AssertEQ(atSecondStart->segmentDistance[1], 0.0);
+
+	Assert(!a.Intersection(Segment({1.0, 1.0}, {1.0, 0.0})).HasValue());
+	Assert(!a.Intersection(Segment({1.0, -1.0}, {1.0, 0.0})).HasValue());
+}
+
+
+void Test_Parallel()
+{
+	const Segment a({0.0, 0.0}, {2.0, 0.0});
+	Assert(!a.Intersection(Segment({0.0, 1.0}, {2.0, 1.0})).HasValue());
+
+	// Collinear segments do not meet at a single point, whether they overlap, touch or are apart.
+	Assert(!a.Intersection(Segment({1.0, 0.0}, {3.0, 0.0})).HasValue());
+	Assert(!a.Intersection(Segment({2.0, 0.0}, {3.0, 0.0})).HasValue());
+	Assert(!a.Intersection(Segment({3.0, 0.0}, {4.0, 0.0})).HasValue());
+	Assert(!a.Intersection(Segment({2.0, 0.0}, {0.0, 0.0})).HasValue());
+}
+
+
+void Test_Degenerate()
+{
+	// A segment of zero length is collinear with everything, so never crosses.
+	const Segment point({1.0, 0.0}, {1.0, 0.0});
+	const Segment a({0.0, 0.0}, {2.0, 0.0});
+	Assert(!a.Intersection(point).HasValue());
+	Assert(!point.Intersection(a).HasValue());
+	Assert(!point.Intersection(Segment({1.0, -1.0}, {1.0, 1.0})).HasValue());
+	Assert(!point.Intersection(point).HasValue());
+}
+
+
+void Test_Line()
+{
+	const Line<double, 2> line({0.0, 1.0}, {1.0, 1.0});
+
+	// The line is crossed even beyond its two points.
+	auto crossing = Segment({4.0, 0.0}, {4.0, 4.0}).Intersection(line);
+	Assert(crossing.HasValue());
+	AssertEQ(crossing->position, Vector{4.0, 1.0});
+	AssertEQ(crossing->segmentDistance, 0.25);
+
+	auto touching = Segment({0.0, 0.0}, {0.0, 1.0}).Intersection(line);
+	Assert(touching.HasValue());
+	AssertEQ(touching->segmentDistance, 1.0);
+
+	Assert(!Segment({0.0, 2.0}, {4.0, 3.0}).Intersection(line).HasValue());
+	Assert(!Segment({0.0, 2.0}, {4.0, 2.0}).Intersection(line).HasValue());
+	Assert(!Segment({-1.0, 1.0}, {5.0, 1.0}).Intersection(line).HasValue());
+}
+
+
+int main()
+{
+	Test_Crossing();
+	Test_Touching();
+	Test_Parallel();
+	Test_Degenerate();
+	Test_Line();
+	return 0;
+}
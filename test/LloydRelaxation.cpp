@@ -0,0 +1,95 @@
+#include "Strawberry/Core/Math/Graph/LloydRelaxation.hpp"
+#include "Strawberry/Core/Thread/ThreadPool.hpp"
+#include <random>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+using namespace Math;
+
+
+static constexpr unsigned int POINT_COUNT = 2000;
+static const AABB<double, 2>  BOUNDS(Vector{0.0, 0.0}, Vector{1000.0, 1000.0});
+
+
+std::vector<Vector<double, 2>> GeneratePoints()
+{
+	std::minstd_rand                       random(1);
+	std::uniform_real_distribution<double> distribution(0.0, 1000.0);
+
+	std::vector<Vector<double, 2>> points;
+	for (unsigned int i = 0; i < POINT_COUNT; i++)
+	{
+		points.emplace_back(distribution(random), distribution(random));
+	}
+	return points;
+}
+
+
+/// Repairing the triangulation between iterations gives the same points as triangulating from scratch every time.
+void Test_MatchesRebuilding()
+{
+	static constexpr unsigned int ITERATION_COUNT = 20;
+
+	LloydRelaxation<Vector<double, 2>> relaxation(BOUNDS, GeneratePoints());
+	AssertEQ(relaxation.Relax(ITERATION_COUNT, 0.8), ITERATION_COUNT);
+
+	std::vector<Vector<double, 2>> rebuilt = GeneratePoints();
+	for (unsigned int i = 0; i < ITERATION_COUNT; i++)
+	{
+		LloydRelaxation<Vector<double, 2>> step(BOUNDS, rebuilt);
+		step.Relax(1, 0.8);
+		rebuilt.assign(step.Points().begin(), step.Points().end());
+	}
+
+	AssertEQ(relaxation.Points().size(), POINT_COUNT);
+	for (unsigned int i = 0; i < POINT_COUNT; i++)
+	{
+		Assert(BOUNDS.Contains(relaxation.Points()[i]));
+		Assert((relaxation.Points()[i] - rebuilt[i]).Magnitude() < 1e-6);
+	}
+}
+
+
+/// Relaxing on a thread pool gives exactly the same points.
+void Test_ThreadPool()
+{
+	ThreadPool pool(4);
+
+	LloydRelaxation<Vector<double, 2>> sequential(BOUNDS, GeneratePoints());
+	LloydRelaxation<Vector<double, 2>> parallel(BOUNDS, GeneratePoints());
+	sequential.Relax(10);
+	parallel.Relax(pool, 10);
+
+	for (unsigned int i = 0; i < POINT_COUNT; i++)
+	{
+		AssertEQ(sequential.Points()[i], parallel.Points()[i]);
+	}
+}
+
+
+/// Relaxation stops once the points settle.
+void Test_Convergence()
+{
+	std::vector<Vector<double, 2>> points{{100.0, 100.0}, {900.0, 150.0}, {500.0, 800.0}, {450.0, 500.0}};
+
+	LloydRelaxation<Vector<double, 2>> relaxation(BOUNDS, points);
+	const unsigned int iterations = relaxation.Relax(1000, 1.0, 1e-6);
+	Assert(iterations < 1000);
+	AssertEQ(relaxation.Relax(1, 1.0, 1e-6), 1);
+
+	for (const auto& point : relaxation.Points())
+	{
+		Assert(BOUNDS.Contains(point));
+	}
+}
+
+
+int main()
+{
+	Test_MatchesRebuilding();
+	Test_ThreadPool();
+	Test_Convergence();
+
+	return 0;
+}
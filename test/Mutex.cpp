@@ -0,0 +1,133 @@
+#include "Strawberry/Core/Sync/Mutex.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include <atomic>
+#include <latch>
+#include <thread>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+
+
+void Test_Plain()
+{
+	Mutex<int, MutexPolicy::Plain> mutex(1);
+
+	{
+		auto lock = mutex.Lock();
+		*lock += 1;
+		Assert(!mutex.TryLock());
+	}
+
+	AssertEQ(*mutex.ReadLock(), 2);
+	AssertEQ(*mutex.TryLock().Unwrap(), 2);
+}
+
+
+void Test_Recursive()
+{
+	Mutex<int> mutex(0);
+
+	auto outer = mutex.Lock();
+	auto inner = mutex.Lock();
+	*inner = 5;
+	AssertEQ(*outer, 5);
+}
+
+
+void Test_ConcurrentReaders()
+{
+	static constexpr int READERS = 4;
+
+	const Mutex<int, MutexPolicy::Shared> mutex(7);
+
+	// Every reader holds its lock until all of them have taken one, which only works if they can share it.
+	std::latch allLocked(READERS);
+	std::vector<std::thread> readers;
+	for (int i = 0; i < READERS; i++)
+	{
+		readers.emplace_back([&]
+		{
+			auto lock = mutex.ReadLock();
+			allLocked.arrive_and_wait();
+			AssertEQ(*lock, 7);
+		});
+	}
+
+	for (auto& reader : readers)
+	{
+		reader.join();
+	}
+}
+
+
+void Test_WritersExcludeReaders()
+{
+	Mutex<int, MutexPolicy::Shared> mutex(0);
+	const auto& readOnly = mutex;
+
+	{
+		auto read = mutex.ReadLock();
+		Assert(!mutex.TryLock());
+		Assert(readOnly.TryLock().HasValue());
+	}
+
+	{
+		auto write = mutex.Lock();
+		Assert(!readOnly.TryLock().HasValue());
+	}
+}
+
+
+void Test_Upgrade()
+{
+	static constexpr int THREADS    = 4;
+	static constexpr int INCREMENTS = 10'000;
+
+	Mutex<int, MutexPolicy::Shared> mutex(0);
+	const auto& readOnly = mutex;
+
+	{
+		auto upgradable = mutex.UpgradableLock();
+		// Readers may still come and go while the upgradable lock is held, but writers may not.
+		Assert(readOnly.TryLock().HasValue());
+		Assert(!mutex.TryLock());
+
+		auto write = std::move(upgradable).Upgrade();
+		*write = 1;
+	}
+	AssertEQ(*mutex.ReadLock(), 1);
+
+	// Read-then-write increments are never lost, since no one else can write between the read and the upgrade.
+	std::vector<std::thread> threads;
+	for (int i = 0; i < THREADS; i++)
+	{
+		threads.emplace_back([&]
+		{
+			for (int j = 0; j < INCREMENTS; j++)
+			{
+				auto upgradable = mutex.UpgradableLock();
+				int value = *upgradable;
+				*std::move(upgradable).Upgrade() = value + 1;
+				Assert(*mutex.ReadLock() > 0);
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	AssertEQ(*mutex.ReadLock(), 1 + THREADS * INCREMENTS);
+}
+
+
+int main()
+{
+	Test_Plain();
+	Test_Recursive();
+	Test_ConcurrentReaders();
+	Test_WritersExcludeReaders();
+	Test_Upgrade();
+}
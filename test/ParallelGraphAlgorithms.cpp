@@ -0,0 +1,108 @@
+// Strawberry Core
+#include "Strawberry/Core/Math/Graph/ParallelAlgorithms.hpp"
+#include "Strawberry/Core/Math/Graph/Algorithms.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include <random>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+using namespace Math;
+
+
+/// A random graph made of several dense clusters joined by a few edges, with some nodes left isolated.
+template <GraphConfig Config>
+CSRGraph<int, Config> RandomGraph(unsigned int nodeCount, unsigned int clusterSize, unsigned int seed)
+{
+	std::minstd_rand          random(seed);
+	std::vector<Edge<Config>> edges;
+	for (unsigned int i = 0; i < 8 * nodeCount; i++)
+	{
+		unsigned int a = random() % nodeCount;
+		unsigned int b = a / clusterSize * clusterSize + random() % clusterSize;
+		if (a != b && b < nodeCount) edges.emplace_back(a, b);
+	}
+	for (unsigned int i = 0; i < nodeCount / clusterSize; i++)
+	{
+		unsigned int a = random() % nodeCount, b = random() % nodeCount;
+		if (a != b) edges.emplace_back(a, b);
+	}
+	return CSRGraph<int, Config>(std::vector<int>(nodeCount, 0), edges);
+}
+
+
+template <GraphConfig Config>
+void Test_BreadthFirst(ThreadPool& pool, size_t topDownToBottomUpRatio, size_t bottomUpToTopDownRatio)
+{
+	auto graph = RandomGraph<Config>(50'000, 5'000, 1);
+
+	GraphWorkspace<unsigned int>             workspace;
+	ParallelBreadthFirstSearch<unsigned int> search;
+	search.topDownToBottomUpRatio = topDownToBottomUpRatio;
+	search.bottomUpToTopDownRatio = bottomUpToTopDownRatio;
+	for (unsigned int source : {0u, 12'345u, 49'999u})
+	{
+		BreadthFirst(graph, source, workspace);
+		search.Run(pool, graph, source);
+
+		for (unsigned int node = 0; node < graph.NodeCount(); node++)
+		{
+			AssertEQ(search.IsReached(node), workspace.IsReached(node));
+			if (!search.IsReached(node)) continue;
+
+			AssertEQ(search.GetDepth(node), workspace.GetDistance(node));
+			if (auto parent = search.GetParent(node))
+			{
+				Assert(graph.IsConnected(*parent, node));
+				AssertEQ(search.GetDepth(*parent) + 1, search.GetDepth(node));
+			}
+			else
+			{
+				AssertEQ(node, source);
+			}
+		}
+	}
+}
+
+
+template <GraphConfig Config>
+void Test_BreadthFirst(ThreadPool& pool)
+{
+	// The default switching, only top down, and switching to bottom up whenever possible.
+	Test_BreadthFirst<Config>(pool, 14, 24);
+	Test_BreadthFirst<Config>(pool, 0, 24);
+	Test_BreadthFirst<Config>(pool, 1'000'000, 1);
+
+	// Both directions are used on a graph with such a wide frontier.
+	ParallelBreadthFirstSearch<unsigned int> search;
+	search.Run(pool, RandomGraph<GraphTypeUndirected>(50'000, 5'000, 1), 0);
+	Assert(search.TopDownLevels() > 0);
+	Assert(search.BottomUpLevels() > 0);
+}
+
+
+template <GraphConfig Config>
+void Test_ConnectedComponents(ThreadPool& pool)
+{
+	for (unsigned int seed = 0; seed < 4; seed++)
+	{
+		auto graph = RandomGraph<Config>(40'000, 1'000 + 1'000 * seed, seed);
+
+		GraphWorkspace<>          workspace;
+		std::vector<unsigned int> expected;
+		std::vector<unsigned int> labels;
+		AssertEQ(ParallelConnectedComponents(pool, graph, labels), ConnectedComponents(graph, workspace, expected));
+		AssertEQ(labels, expected);
+	}
+}
+
+
+int main()
+{
+	ThreadPool pool(4);
+	Test_BreadthFirst<GraphTypeUndirected>(pool);
+	Test_BreadthFirst<GraphTypeDirected>(pool);
+	Test_ConnectedComponents<GraphTypeUndirected>(pool);
+	Test_ConnectedComponents<GraphTypeDirected>(pool);
+	return 0;
+}
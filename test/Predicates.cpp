@@ -0,0 +1,81 @@
+#include "Strawberry/Core/Math/Geometry/Predicates.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include <cmath>
+
+
+using namespace Strawberry::Core;
+using namespace Math;
+
+
+int Sign(double x)
+{
+	return (x > 0.0) - (x < 0.0);
+}
+
+
+void Test_Orient2D()
+{
+	Assert(Orient2D(Vector{0.0, 0.0}, Vector{1.0, 0.0}, Vector{0.0, 1.0}) > 0.0);
+	Assert(Orient2D(Vector{0.0, 0.0}, Vector{0.0, 1.0}, Vector{1.0, 0.0}) < 0.0);
+	AssertEQ(Orient2D(Vector{0.0, 0.0}, Vector{1.0, 1.0}, Vector{3.0, 3.0}), 0.0);
+	Assert(Orient2D(Vector{0, 0}, Vector{2, 0}, Vector{1, 1}) > 0.0);
+
+	// Points which are exactly collinear, but whose differences are rounded.
+	const double tiny = std::ldexp(1.0, -50);
+	AssertEQ(Orient2D(Vector{0.1, 0.1}, Vector{0.1 + tiny, 0.1 + tiny}, Vector{0.5, 0.5}), 0.0);
+
+	// Walking a point across the line through two others in steps of one ulp, the sign is exactly Sign(y - 0.5), so
+	// it only changes at y == 0.5, where it passes through zero. Plain floating point gets it wrong many times along
+	// the way.
+	const Vector<double, 2> a{12.0, 12.0}, b{24.0, 24.0};
+	int changes = 0, previous = Sign(Orient2D(a, b, Vector{0.5, std::nextafter(0.5, 0.0)}));
+	double y = std::nextafter(0.5, 0.0);
+	for (int i = 0; i < 256; i++)
+	{
+		y = std::nextafter(y, 1.0);
+		int sign = Sign(Orient2D(a, b, Vector{0.5, y}));
+		if (sign != previous) changes++;
+		previous = sign;
+		AssertEQ(sign, Sign(y - 0.5));
+	}
+	AssertEQ(changes, 2);
+}
+
+
+void Test_InCircle()
+{
+	const Vector<double, 2> a{1.0, 0.0}, b{0.0, 1.0}, c{-1.0, 0.0};
+	Assert(InCircle(a, b, c, Vector{0.0, 0.0}) > 0.0);
+	Assert(InCircle(a, b, c, Vector{2.0, 2.0}) < 0.0);
+	AssertEQ(InCircle(a, b, c, Vector{0.0, -1.0}), 0.0);
+	Assert(InCircle(c, b, a, Vector{0.0, 0.0}) < 0.0);
+
+	// The corners of a square far from the origin are cocircular, but their differences are rounded.
+	const double offset = 1.0e6 + 0.1;
+	const double unit   = 1.0 / 3.0;
+	AssertEQ(InCircle(Vector{offset, offset}, Vector{offset + unit, offset}, Vector{offset + unit, offset + unit}, Vector{offset, offset + unit}), 0.0);
+	Assert(InCircle(Vector{offset, offset}, Vector{offset + unit, offset}, Vector{offset + unit, offset + unit}, Vector{offset, std::nextafter(offset + unit, 0.0)}) > 0.0);
+	Assert(InCircle(Vector{offset, offset}, Vector{offset + unit, offset}, Vector{offset + unit, offset + unit}, Vector{offset, std::nextafter(offset + unit, 2 * offset)}) < 0.0);
+}
+
+
+void Test_Orient3D()
+{
+	const Vector<double, 3> a{0.0, 0.0, 0.0}, b{1.0, 0.0, 0.0}, c{0.0, 1.0, 0.0};
+	Assert(Orient3D(a, b, c, Vector{0.0, 0.0, -1.0}) > 0.0);
+	Assert(Orient3D(a, b, c, Vector{0.0, 0.0, 1.0}) < 0.0);
+	AssertEQ(Orient3D(a, b, c, Vector{5.0, 7.0, 0.0}), 0.0);
+
+	const double tiny = std::ldexp(1.0, -50);
+	AssertEQ(Orient3D(Vector{0.1, 0.1, 0.1}, Vector{0.1 + tiny, 0.1, 0.1}, Vector{0.1, 0.1 + tiny, 0.1}, Vector{0.7, 0.3, 0.1}), 0.0);
+	Assert(Orient3D(Vector{0.1, 0.1, 0.1}, Vector{0.1 + tiny, 0.1, 0.1}, Vector{0.1, 0.1 + tiny, 0.1}, Vector{0.7, 0.3, std::nextafter(0.1, 0.0)}) > 0.0);
+}
+
+
+int main()
+{
+	Test_Orient2D();
+	Test_InCircle();
+	Test_Orient3D();
+	return 0;
+}
@@ -1,9 +1,13 @@
 #include <set>
 
 #include "Strawberry/Core/Sync/ProducerConsumerQueue.hpp"
+#include <numeric>
+#include <stdexcept>
 #include <thread>
+#include <vector>
 
 #include "Strawberry/Core/Sync/Mutex.hpp"
+#include "Strawberry/Core/Sync/Spinlock.hpp"
 #include "Strawberry/Core/Util/Ranges.hpp"
 using namespace Strawberry;
 using namespace Core;
@@ -42,6 +46,60 @@ void Test_LockFreeSWSRQueue()
 }
 
 
+void Test_LockFreeSWSRQueueBatches()
+{
+	static constexpr int LIMIT = 1'000'000;
+
+
+	// Capacities which are not powers of two are still respected exactly.
+	LockFree::SPSCQueue<int, 3> small;
+	Assert(small.Push(1) && small.Push(2) && small.Push(3));
+	Assert(small.IsFull());
+	Assert(!small.Push(4));
+	AssertEQ(small.Pop().Unwrap(), 1);
+	Assert(small.Push(4));
+	AssertEQ(small.Size(), 3);
+
+
+	LockFree::SPSCQueue<int, 100> queue;
+
+
+	std::thread producer([&]()
+	{
+		std::vector<int> batch(37);
+		for (int i = 0; i < LIMIT; i += static_cast<int>(batch.size()))
+		{
+			batch.resize(std::min<size_t>(37, LIMIT - i));
+			std::iota(batch.begin(), batch.end(), i);
+
+			std::span<const int> remaining(batch);
+			while (!remaining.empty())
+			{
+				remaining = remaining.subspan(queue.PushN(remaining));
+			}
+		}
+	});
+
+
+	std::thread consume([&]()
+	{
+		std::vector<int> output(50);
+		for (int i = 0; i < LIMIT;)
+		{
+			size_t count = queue.PopN(output);
+			for (size_t j = 0; j < count; j++)
+			{
+				AssertEQ(output[j], i++);
+			}
+		}
+	});
+
+	producer.join();
+	consume.join();
+	Assert(queue.IsEmpty());
+}
+
+
 void Test_LockFreeMPMCQueue()
 {
 	static constexpr size_t LIMIT = 1'000'000;
@@ -116,8 +174,164 @@ void Test_LockFreeMPMCQueue()
 }
 
 
+/// A value whose construction throws for negative numbers.
+struct ThrowsOnNegative
+{
+	explicit ThrowsOnNegative(int value)
+		: value(value)
+	{
+		if (value < 0) throw std::invalid_argument("Negative value");
+	}
+
+	ThrowsOnNegative(ThrowsOnNegative&&) noexcept = default;
+
+	int value;
+};
+
+
+void Test_MPMCQueueThrowingPush()
+{
+	LockFree::MPMCQueue<ThrowsOnNegative, 4> queue;
+
+	// A push which throws takes up no room, and the values either side of it are still popped in order, lap after lap.
+	for (int lap = 0; lap < 8; lap++)
+	{
+		Assert(queue.Push(2 * lap));
+
+		bool threw = false;
+		try
+		{
+			(void) queue.Push(-1);
+		}
+		catch (const std::invalid_argument&)
+		{
+			threw = true;
+		}
+		Assert(threw);
+
+		Assert(queue.Push(2 * lap + 1));
+		AssertEQ(queue.Pop().Unwrap().value, 2 * lap);
+		AssertEQ(queue.Pop().Unwrap().value, 2 * lap + 1);
+		Assert(!queue.Pop().HasValue());
+	}
+
+	// The queue can still be filled to capacity.
+	for (int i = 0; i < 4; i++)
+	{
+		Assert(queue.Push(i));
+	}
+	Assert(!queue.Push(4));
+	for (int i = 0; i < 4; i++)
+	{
+		AssertEQ(queue.Pop().Unwrap().value, i);
+	}
+}
+
+
+void Test_BlockingMPMCQueue()
+{
+	static constexpr int PER_PRODUCER = 100'000;
+	static constexpr int THREADS      = 4;
+
+
+	// A small capacity, so that producers regularly wait for space and consumers wait for values.
+	LockFree::BlockingMPMCQueue<int, 64> queue;
+	std::atomic<long long> sum = 0;
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < THREADS; i++)
+	{
+		threads.emplace_back([&]
+		{
+			for (int x = 0; x < PER_PRODUCER; x++)
+			{
+				Assert(queue.PushWait(x));
+			}
+		});
+
+		threads.emplace_back([&]
+		{
+			for (int x = 0; x < PER_PRODUCER; x++)
+			{
+				sum.fetch_add(queue.PopWait().Unwrap());
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	AssertEQ(sum.load(), static_cast<long long>(THREADS) * PER_PRODUCER * (PER_PRODUCER - 1) / 2);
+	Assert(queue.IsEmpty());
+
+
+	// Waiting stops once a stop is requested.
+	std::stop_source stop;
+	std::thread waiter([&]
+	{
+		Assert(!queue.PopWait(stop.get_token()).HasValue());
+	});
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	stop.request_stop();
+	waiter.join();
+}
+
+
+void Test_MPSCQueue()
+{
+	static constexpr int PER_PRODUCER = 100'000;
+	static constexpr int PRODUCERS    = 4;
+
+
+	LockFree::MPSCQueue<std::unique_ptr<int>> queue;
+	Assert(queue.IsEmpty());
+
+	std::vector<std::thread> producers;
+	for (int p = 0; p < PRODUCERS; p++)
+	{
+		producers.emplace_back([&, p]
+		{
+			for (int x = 0; x < PER_PRODUCER; x++)
+			{
+				queue.Push(std::make_unique<int>(p * PER_PRODUCER + x));
+			}
+		});
+	}
+
+	// Values from each producer arrive in the order they were pushed.
+	std::vector<int> last(PRODUCERS, -1);
+	for (int received = 0; received < PRODUCERS * PER_PRODUCER;)
+	{
+		if (auto value = queue.Pop())
+		{
+			const int producer = **value / PER_PRODUCER;
+			const int x        = **value % PER_PRODUCER;
+			AssertEQ(x, last[producer] + 1);
+			last[producer] = x;
+			received++;
+		}
+	}
+
+	for (auto& producer : producers)
+	{
+		producer.join();
+	}
+
+	Assert(queue.IsEmpty());
+
+	// Values left in the queue are destroyed with it.
+	queue.Push(std::make_unique<int>(0));
+}
+
+
 int main()
 {
 	Test_LockFreeSWSRQueue();
+	Test_LockFreeSWSRQueueBatches();
 	Test_LockFreeMPMCQueue();
+	Test_MPMCQueueThrowingPush();
+	Test_BlockingMPMCQueue();
+	Test_MPSCQueue();
 }
\ No newline at end of file
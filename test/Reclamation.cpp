@@ -0,0 +1,117 @@
+#include "Strawberry/Core/Sync/Stack.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+using namespace Strawberry::Core::LockFree;
+
+
+/// Counts live instances, and poisons itself when destroyed so that use after reclamation is noticed.
+struct Counted
+{
+	static inline std::atomic<int> sLive = 0;
+
+	explicit Counted(int value)
+		: value(value)
+	{
+		sLive++;
+	}
+
+	Counted(Counted&& other) noexcept
+		: value(other.value)
+	{
+		sLive++;
+	}
+
+	~Counted()
+	{
+		value = -1;
+		sLive--;
+	}
+
+	int value;
+};
+
+
+/// Objects are only deleted once no guard can be reading them.
+template <typename R>
+void Test_Retire()
+{
+	std::atomic<Counted*> shared = new Counted(7);
+
+	{
+		typename R::Guard guard;
+		Counted* object = guard.Protect(shared);
+		shared.store(nullptr);
+		R::Retire(object);
+
+		R::Flush();
+		AssertEQ(object->value, 7);
+		AssertEQ(R::PendingCount(), 1);
+	}
+
+	R::Flush();
+	AssertEQ(R::PendingCount(), 0);
+	AssertEQ(Counted::sLive.load(), 0);
+}
+
+
+template <typename R>
+void Test_Stack()
+{
+	static constexpr int THREADS    = 4;
+	static constexpr int OPERATIONS = 100'000;
+
+	{
+		Stack<Counted, R> stack;
+		Assert(stack.IsEmpty());
+		Assert(!stack.Pop());
+
+		// Every thread pushes and pops alternately, so that nodes are constantly unlinked, retired and reallocated.
+		std::atomic<long long> pushed = 0;
+		std::atomic<long long> popped = 0;
+		std::vector<std::thread> threads;
+		for (int t = 0; t < THREADS; t++)
+		{
+			threads.emplace_back([&, t]
+			{
+				for (int i = 1; i <= OPERATIONS; i++)
+				{
+					stack.Push(Counted(i));
+					pushed += i;
+
+					auto value = stack.Pop();
+					Assert(value.HasValue());
+					Assert(value->value > 0);
+					popped += value->value;
+				}
+			});
+		}
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		Assert(stack.IsEmpty());
+		AssertEQ(pushed.load(), popped.load());
+
+		// Values left on the stack are destroyed with it.
+		stack.Push(Counted(1));
+	}
+
+	R::Flush();
+	AssertEQ(Counted::sLive.load(), 0);
+}
+
+
+int main()
+{
+	Test_Retire<EpochReclaimer>();
+	Test_Retire<HazardPointerReclaimer>();
+	Test_Stack<EpochReclaimer>();
+	Test_Stack<HazardPointerReclaimer>();
+}
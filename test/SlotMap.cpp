@@ -0,0 +1,85 @@
+#include "Strawberry/Core/Util/SlotMap.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+
+
+void Test_Basic()
+{
+	SlotMap<std::string> map;
+	auto a = map.Insert("a");
+	auto b = map.Insert("b");
+	auto c = map.Emplace(3, 'c');
+	AssertEQ(map.Size(), 3);
+	AssertEQ(map[a], "a");
+	AssertEQ(map[b], "b");
+	AssertEQ(map[c], "ccc");
+
+	// Erasing moves the last value into the hole, but handles stay valid.
+	Assert(map.Erase(a));
+	Assert(!map.Erase(a));
+	Assert(!map.Contains(a));
+	Assert(map.Find(a) == nullptr);
+	AssertEQ(map.Size(), 2);
+	AssertEQ(map[b], "b");
+	AssertEQ(map[c], "ccc");
+
+	// The slot is reused, but the old handle does not match its generation.
+	auto d = map.Insert("d");
+	AssertEQ(d.index, a.index);
+	Assert(d.generation != a.generation);
+	Assert(!map.Contains(a));
+	AssertEQ(map[d], "d");
+	AssertEQ(map.HandleOf(d.index).Value(), d);
+
+	map.Clear();
+	Assert(map.IsEmpty());
+	Assert(!map.Contains(b));
+	Assert(!map.HandleOf(b.index).HasValue());
+}
+
+
+void Test_Random()
+{
+	// Compare against a map from handles to values.
+	SlotMap<int>                        map;
+	std::map<SlotMap<int>::Handle, int> reference;
+	std::vector<SlotMap<int>::Handle>   erased;
+	std::minstd_rand                    random(1);
+	for (int i = 0; i < 20'000; i++)
+	{
+		if (random() % 3 == 0 && !reference.empty())
+		{
+			auto it = std::next(reference.begin(), random() % reference.size());
+			Assert(map.Erase(it->first));
+			erased.emplace_back(it->first);
+			reference.erase(it);
+		}
+		else
+		{
+			reference.emplace(map.Insert(i), i);
+		}
+	}
+
+	AssertEQ(map.Size(), reference.size());
+	for (auto [handle, value] : reference) AssertEQ(map[handle], value);
+	for (auto handle : erased) Assert(!map.Contains(handle));
+
+	for (size_t i = 0; i < map.Size(); i++)
+	{
+		AssertEQ(map[map.HandleAt(i)], map.Values()[i]);
+	}
+}
+
+
+int main()
+{
+	Test_Basic();
+	Test_Random();
+	return 0;
+}
@@ -0,0 +1,155 @@
+#include "Strawberry/Core/Sync/Rcu.hpp"
+#include "Strawberry/Core/Sync/Snapshot.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+
+
+static constexpr int READERS = 4;
+static constexpr int WRITES  = 10'000;
+
+
+/// Wider than a word, so that a torn read would break the invariant.
+struct Triple
+{
+	uint64_t a = 0;
+	uint64_t b = 0;
+	uint64_t c = 0;
+};
+
+
+void Test_Snapshot()
+{
+	Snapshot<Triple> snapshot;
+	AssertEQ(snapshot.Load().a, 0);
+
+	std::atomic_bool done = false;
+	std::vector<std::thread> readers;
+	for (int i = 0; i < READERS; i++)
+	{
+		readers.emplace_back([&]
+		{
+			uint64_t last = 0;
+			while (!done.load())
+			{
+				Triple value = snapshot.Load();
+				AssertEQ(value.b, 2 * value.a);
+				AssertEQ(value.c, 3 * value.a);
+				Assert(value.a >= last);
+				last = value.a;
+			}
+		});
+	}
+
+	for (uint64_t i = 1; i <= WRITES; i++)
+	{
+		if (i % 2 == 0)
+		{
+			snapshot.Store({i, 2 * i, 3 * i});
+		}
+		else
+		{
+			snapshot.Update([] (const Triple& value) { return Triple{value.a + 1, 2 * (value.a + 1), 3 * (value.a + 1)}; });
+		}
+	}
+
+	done = true;
+	for (auto& reader : readers)
+	{
+		reader.join();
+	}
+
+	AssertEQ(snapshot.Load().a, WRITES);
+}
+
+
+/// Counts live instances, so that we can check that old versions are reclaimed.
+struct Version
+{
+	static inline std::atomic<int> sLive = 0;
+
+	explicit Version(std::vector<int> values)
+		: values(std::move(values))
+	{
+		sLive++;
+	}
+
+	Version(const Version& other)
+		: values(other.values)
+	{
+		sLive++;
+	}
+
+	~Version()
+	{
+		// Poison the contents, so that a reader still using a reclaimed version would notice.
+		values.assign(values.size(), -1);
+		sLive--;
+	}
+
+	std::vector<int> values;
+};
+
+
+void Test_Rcu()
+{
+	{
+		Rcu<Version> rcu(std::vector<int>(16, 0));
+
+		std::atomic_bool done = false;
+		std::vector<std::thread> readers;
+		for (int i = 0; i < READERS; i++)
+		{
+			readers.emplace_back([&]
+			{
+				while (!done.load())
+				{
+					auto version = rcu.Read();
+					const int first = version->values.front();
+					Assert(first >= 0);
+					for (int value : version->values)
+					{
+						AssertEQ(value, first);
+					}
+				}
+			});
+		}
+
+		for (int i = 1; i <= WRITES / 10; i++)
+		{
+			if (i % 2 == 0)
+			{
+				rcu.Store(Version(std::vector<int>(16, i)));
+			}
+			else
+			{
+				rcu.Update([] (Version& version) { for (int& value : version.values) value++; });
+			}
+
+			// Only the current version is alive once a write returns.
+			AssertEQ(Version::sLive.load(), 1);
+		}
+
+		done = true;
+		for (auto& reader : readers)
+		{
+			reader.join();
+		}
+
+		AssertEQ(rcu.Read()->values.front(), WRITES / 10);
+	}
+
+	AssertEQ(Version::sLive.load(), 0);
+}
+
+
+int main()
+{
+	Test_Snapshot();
+	Test_Rcu();
+}
@@ -0,0 +1,58 @@
+#include "Strawberry/Core/Sync/Spinlock.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+
+
+void Test_TryLock()
+{
+	Spinlock lock;
+
+	Assert(lock.TryLock());
+	Assert(!lock.TryLock());
+	lock.Unlock();
+	Assert(lock.TryLock());
+	lock.Unlock();
+}
+
+
+void Test_Contention()
+{
+	static constexpr int THREADS    = 8;
+	static constexpr int INCREMENTS = 100'000;
+
+	// More threads than cores, so that lock holders are regularly descheduled and waiters have to sleep.
+	Spinlock lock;
+	long long counter = 0;
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < THREADS; i++)
+	{
+		threads.emplace_back([&]
+		{
+			for (int j = 0; j < INCREMENTS; j++)
+			{
+				std::scoped_lock guard(lock);
+				counter++;
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	AssertEQ(counter, static_cast<long long>(THREADS) * INCREMENTS);
+}
+
+
+int main()
+{
+	Test_TryLock();
+	Test_Contention();
+}
@@ -0,0 +1,146 @@
+#include "Strawberry/Core/Thread/TaskGraph.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include <memory>
+#include <stdexcept>
+
+
+using namespace Strawberry::Core;
+
+
+void Test_Diamond(int threadCount)
+{
+	ThreadPool pool(threadCount, ThreadPool::Scheduling::WorkStealing);
+	TaskGraph graph;
+
+	std::atomic<int> sequence = 0;
+	int a = -1, b = -1, c = -1, d = -1;
+
+	auto nodeA = graph.AddNode("A", [&] { a = sequence++; });
+	auto nodeB = graph.AddNode("B", [&] { b = sequence++; });
+	auto nodeC = graph.AddNode("C", [&] { c = sequence++; });
+	auto nodeD = graph.AddNode("D", [&] { d = sequence++; });
+	graph.AddEdge(nodeA, nodeB);
+	graph.AddEdge(nodeA, nodeC);
+	graph.AddEdge(nodeB, nodeD);
+	graph.AddEdge(nodeC, nodeD);
+
+	// The same graph can be run repeatedly.
+	for (int run = 0; run < 100; run++)
+	{
+		sequence = 0;
+		graph.Run(pool);
+
+		AssertEQ(sequence.load(), 4);
+		AssertEQ(a, 0);
+		Assert(b > a && c > a);
+		AssertEQ(d, 3);
+	}
+}
+
+
+void Test_WideGraph(ThreadPool::Scheduling scheduling)
+{
+	static constexpr int WIDTH = 1'000;
+
+	ThreadPool pool(4, scheduling);
+	TaskGraph graph;
+
+	std::atomic<int> counter = 0;
+	bool sawAll = false;
+
+	auto source = graph.AddNode("Source", [] {});
+	auto sink   = graph.AddNode("Sink", [&] { sawAll = counter.load() == WIDTH; });
+	for (int i = 0; i < WIDTH; i++)
+	{
+		auto node = graph.AddNode("Middle", [&] { counter.fetch_add(1); });
+		graph.AddEdge(source, node);
+		graph.AddEdge(node, sink);
+	}
+
+	graph.Run(pool);
+	AssertEQ(counter.load(), WIDTH);
+	Assert(sawAll);
+}
+
+
+void Test_CriticalPath()
+{
+	using namespace std::chrono_literals;
+
+	ThreadPool pool(4, ThreadPool::Scheduling::WorkStealing);
+	TaskGraph graph;
+
+	auto start = graph.AddNode("Start", [] {});
+	auto fast  = graph.AddNode("Fast", [] {});
+	auto slow  = graph.AddNode("Slow", [] { std::this_thread::sleep_for(20ms); });
+	auto end   = graph.AddNode("End", [] {});
+	graph.AddEdge(start, fast);
+	graph.AddEdge(start, slow);
+	graph.AddEdge(fast, end);
+	graph.AddEdge(slow, end);
+
+	graph.Run(pool);
+
+	Assert(graph.GetTiming(slow).Elapsed() >= 20ms);
+	Assert(graph.GetTiming(end).start >= graph.GetTiming(slow).end);
+	Assert(graph.GetElapsed() >= 20ms);
+	Assert(graph.CriticalPath() == std::vector{start, slow, end});
+}
+
+
+void Test_Exceptions()
+{
+	ThreadPool pool(4, ThreadPool::Scheduling::WorkStealing);
+	TaskGraph graph;
+
+	bool ranSuccessor = false;
+	auto failing   = graph.AddNode("Failing", [] { throw std::runtime_error("node failed"); });
+	auto successor = graph.AddNode("Successor", [&] { ranSuccessor = true; });
+	graph.AddEdge(failing, successor);
+
+	bool caught = false;
+	try
+	{
+		graph.Run(pool);
+	}
+	catch (const std::runtime_error&)
+	{
+		caught = true;
+	}
+
+	Assert(caught);
+	Assert(!ranSuccessor);
+}
+
+
+void Test_DestroyAfterRun()
+{
+	ThreadPool pool(4, ThreadPool::Scheduling::WorkStealing);
+
+	// A graph may be destroyed as soon as Run returns, while the thread which ran its last node is still finishing.
+	for (int run = 0; run < 1000; run++)
+	{
+		auto graph = std::make_unique<TaskGraph>();
+		auto first = graph->AddNode("First", [] {});
+		for (int i = 0; i < 4; i++)
+		{
+			graph->AddEdge(first, graph->AddNode("Leaf", [] {}));
+		}
+		graph->Run(pool);
+	}
+
+	TaskGraph empty;
+	empty.Run(pool);
+}
+
+
+int main()
+{
+	Test_Diamond(4);
+	Test_Diamond(0);
+	Test_WideGraph(ThreadPool::Scheduling::RoundRobin);
+	Test_WideGraph(ThreadPool::Scheduling::WorkStealing);
+	Test_CriticalPath();
+	Test_Exceptions();
+	Test_DestroyAfterRun();
+}
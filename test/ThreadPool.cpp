@@ -0,0 +1,283 @@
+#include "Strawberry/Core/Thread/ThreadPool.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include <array>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+
+using namespace Strawberry::Core;
+
+
+void Test_QueueTasks(ThreadPool::Scheduling scheduling)
+{
+	static constexpr int COUNT = 10'000;
+
+	ThreadPool pool(4, scheduling);
+
+	auto tasks = std::views::iota(0, COUNT)
+		| std::views::transform([] (int i) { return [i] { return i; }; });
+
+	auto futures = pool.QueueTasks(tasks).Unwrap();
+	AssertEQ(futures.size(), COUNT);
+
+	long long sum = 0;
+	for (auto& future : futures)
+	{
+		sum += future.Get();
+	}
+	AssertEQ(sum, static_cast<long long>(COUNT) * (COUNT - 1) / 2);
+}
+
+
+void Test_PostAndExceptions(ThreadPool::Scheduling scheduling)
+{
+	static constexpr int COUNT = 10'000;
+
+	ThreadPool pool(4, scheduling);
+
+	std::atomic<int> counter = 0;
+	for (int i = 0; i < COUNT; i++)
+	{
+		pool.Post([&] { counter.fetch_add(1); });
+	}
+
+	// Tasks larger than the inline buffer are still run.
+	std::array<int, 64> large{};
+	large.back() = 1;
+	pool.Post([&counter, large] { counter.fetch_add(large.back()); });
+
+	while (counter.load() < COUNT + 1)
+	{
+		std::this_thread::yield();
+	}
+	AssertEQ(counter.load(), COUNT + 1);
+
+
+	auto throwing = pool.QueueTask([] () -> int { throw std::runtime_error("task failed"); }).Unwrap();
+	bool caught = false;
+	try
+	{
+		[[maybe_unused]] int result = throwing.Get();
+	}
+	catch (const std::runtime_error&)
+	{
+		caught = true;
+	}
+	Assert(caught);
+
+
+	// A posted task which throws does not stop the tasks after it.
+	pool.Post([] { throw std::runtime_error("posted task failed"); });
+	std::atomic_bool ranAfter = false;
+	pool.Post([&] { ranAfter = true; });
+	while (!ranAfter.load())
+	{
+		std::this_thread::yield();
+	}
+
+
+	auto empty = pool.QueueTask([] {}).Unwrap();
+	empty.Wait();
+	Assert(empty.IsReady());
+}
+
+
+void Test_NestedTasks()
+{
+	static constexpr int OUTER = 64;
+	static constexpr int INNER = 64;
+
+	ThreadPool pool(4, ThreadPool::Scheduling::WorkStealing);
+	std::atomic<int> counter = 0;
+
+	for (int i = 0; i < OUTER; i++)
+	{
+		// Tasks queued from inside the pool go to the local deque, and may be stolen by idle threads.
+		auto outer = pool.QueueTask([&]
+		{
+			for (int j = 0; j < INNER; j++)
+			{
+				auto inner = pool.QueueTask([&] { counter.fetch_add(1); });
+				Assert(inner.IsOk());
+			}
+		});
+		Assert(outer.IsOk());
+	}
+
+	while (counter.load() < OUTER * INNER)
+	{
+		std::this_thread::yield();
+	}
+
+	AssertEQ(counter.load(), OUTER * INNER);
+}
+
+
+void Test_ParallelFor(ThreadPool::Scheduling scheduling)
+{
+	static constexpr int COUNT = 100'000;
+
+	ThreadPool pool(4, scheduling);
+
+	std::vector<int> values(COUNT, 0);
+	pool.ParallelFor(std::views::iota(0, COUNT), [&] (int i) { values[i] = 2 * i; });
+	for (int i = 0; i < COUNT; i++)
+	{
+		AssertEQ(values[i], 2 * i);
+	}
+
+	// Uneven work with a small grain.
+	std::atomic<long long> sum = 0;
+	pool.ParallelFor(values, [&] (int x) { sum.fetch_add(x); }, 7);
+	AssertEQ(sum.load(), static_cast<long long>(COUNT) * (COUNT - 1));
+
+
+	Math::Vector<unsigned int, 2> extent(37u, 23u);
+	std::vector<std::atomic<int>> visits(extent[0] * extent[1]);
+	pool.ParallelFor2D(extent, [&] (const Math::Vector<unsigned int, 2>& p)
+	{
+		Assert(p[0] < extent[0] && p[1] < extent[1]);
+		visits[extent.FlattenR(p)].fetch_add(1);
+	});
+	for (auto& visit : visits)
+	{
+		AssertEQ(visit.load(), 1);
+	}
+
+
+	Math::Vector<unsigned int, 3> volume(5u, 6u, 7u);
+	std::atomic<int> volumeVisits = 0;
+	pool.ParallelFor3D(volume, [&] (const Math::Vector<unsigned int, 3>&) { volumeVisits.fetch_add(1); }, 3);
+	AssertEQ(volumeVisits.load(), 5 * 6 * 7);
+
+
+	long long reduced = pool.ParallelReduce(std::views::iota(0, COUNT), 0ll, std::plus());
+	AssertEQ(reduced, static_cast<long long>(COUNT) * (COUNT - 1) / 2);
+
+	// Non-commutative operations are combined in order.
+	auto digits = std::views::iota(0, 9) | std::views::transform([] (int i) { return std::to_string(i); });
+	std::string joined = pool.ParallelReduce(digits, std::string(), std::plus(), 2);
+	AssertEQ(joined, "012345678");
+}
+
+
+void Test_ParallelForExceptions(ThreadPool::Scheduling scheduling)
+{
+	static constexpr int COUNT = 10'000;
+
+	ThreadPool pool(4, scheduling);
+
+	// The exception reaches the caller once every chunk has finished, whichever thread threw it.
+	for (int thrower : {0, COUNT / 2, COUNT - 1})
+	{
+		std::atomic<int> running = 0;
+		bool caught = false;
+		try
+		{
+			pool.ParallelFor(std::views::iota(0, COUNT), [&] (int i)
+			{
+				running.fetch_add(1);
+				if (i == thrower) throw std::runtime_error("body failed");
+				running.fetch_sub(1);
+			}, 16);
+		}
+		catch (const std::runtime_error&)
+		{
+			caught = true;
+		}
+		Assert(caught);
+		AssertEQ(running.load(), 1);
+	}
+
+	bool caught = false;
+	try
+	{
+		[[maybe_unused]] int sum = pool.ParallelReduce(std::views::iota(0, COUNT), 0, [] (int a, int b)
+		{
+			if (b == 1234) throw std::runtime_error("reduce failed");
+			return a + b;
+		});
+	}
+	catch (const std::runtime_error&)
+	{
+		caught = true;
+	}
+	Assert(caught);
+
+	// The pool is still usable afterwards.
+	long long reduced = pool.ParallelReduce(std::views::iota(0, COUNT), 0ll, std::plus());
+	AssertEQ(reduced, static_cast<long long>(COUNT) * (COUNT - 1) / 2);
+}
+
+
+void Test_QueueOrder()
+{
+	static constexpr int COUNT = 5'000;
+
+	// With one thread, tasks run in the order they were queued, even once more are queued than fit in its queue.
+	ThreadPool pool(1, ThreadPool::Scheduling::RoundRobin);
+
+	std::atomic_bool release = false;
+	pool.Post([&] { release.wait(false); });
+
+	std::vector<int> order;
+	for (int i = 0; i < COUNT; i++)
+	{
+		pool.Post([&order, i] { order.emplace_back(i); });
+	}
+
+	// The rest are queued while the thread is making room in its queue.
+	release = true;
+	release.notify_one();
+	for (int i = COUNT; i < 2 * COUNT; i++)
+	{
+		pool.Post([&order, i] { order.emplace_back(i); });
+	}
+	pool.QueueTask([] {}).Unwrap().Wait();
+
+	AssertEQ(order.size(), 2 * COUNT);
+	for (int i = 0; i < 2 * COUNT; i++)
+	{
+		AssertEQ(order[i], i);
+	}
+}
+
+
+void Test_NoThreads(ThreadPool::Scheduling scheduling)
+{
+	ThreadPool pool(0, scheduling);
+	AssertEQ(pool.ThreadCount(), 0);
+
+	// Tasks are run as they are queued, so waiting on them cannot hang.
+	auto task = pool.QueueTask([] { return 7; }).Unwrap();
+	AssertEQ(task.Get(), 7);
+
+	int posted = 0;
+	pool.Post([&] { posted++; });
+	AssertEQ(posted, 1);
+
+	auto tasks = pool.QueueTasks(std::views::iota(0, 10) | std::views::transform([] (int i) { return [i] { return i; }; })).Unwrap();
+	AssertEQ(tasks.size(), 10);
+	for (int i = 0; i < 10; i++)
+	{
+		AssertEQ(tasks[i].Get(), i);
+	}
+}
+
+
+int main()
+{
+	Test_QueueTasks(ThreadPool::Scheduling::RoundRobin);
+	Test_QueueTasks(ThreadPool::Scheduling::WorkStealing);
+	Test_PostAndExceptions(ThreadPool::Scheduling::RoundRobin);
+	Test_PostAndExceptions(ThreadPool::Scheduling::WorkStealing);
+	Test_NestedTasks();
+	Test_QueueOrder();
+	Test_NoThreads(ThreadPool::Scheduling::RoundRobin);
+	Test_NoThreads(ThreadPool::Scheduling::WorkStealing);
+	Test_ParallelFor(ThreadPool::Scheduling::RoundRobin);
+	Test_ParallelFor(ThreadPool::Scheduling::WorkStealing);
+	Test_ParallelForExceptions(ThreadPool::Scheduling::RoundRobin);
+	Test_ParallelForExceptions(ThreadPool::Scheduling::WorkStealing);
+}
@@ -4,6 +4,7 @@
 #include "Strawberry/Core/Math/Graph/Delauney.hpp"
 #include "Strawberry/Core/Util/Image.hpp"
 #include "canvas_ity.hpp"
+#include <cmath>
 #include <numbers>
 
 
@@ -134,6 +135,22 @@ int main()
 
 	auto delaunay = builder.Build();
 	auto voronoi = Voronoi<Vector<double, 2>>::Builder(delaunay).Build();
+
+	// Every point has a cell containing it, and together the cells cover the bounds exactly once.
+	double totalArea = 0.0;
+	for (auto node : delaunay.GetGraph().NodeIndices())
+	{
+		auto cell = voronoi.GetCell(node);
+		Assert(cell.HasValue());
+		Assert(voronoi.GetCellAsPolygon(*cell).Contains(delaunay.GetGraph().GetValue(node)));
+
+		for (auto edge : cell->Edges())
+		{
+			totalArea += 0.5 * voronoi.GetGraph().GetValue(edge.A()).DotPerp(voronoi.GetGraph().GetValue(edge.B()));
+		}
+	}
+	Assert(std::abs(totalArea - 1000.0 * 1000.0) < 1e-6);
+	AssertEQ(voronoi.GetMesh().FaceCount(), pointSet.Size());
 	auto span = MAX - MIN;
 
 	canvas_ity::canvas context(span[0], span[1]);